@@ -759,18 +759,6 @@ boolector_set_opt (Btor *btor, BtorOption opt, uint32_t val)
       BTOR_ABORT (btor->btor_sat_btor_called > 0,
                   "enabling/disabling incremental usage must be done "
                   "before calling 'boolector_sat'");
-      BTOR_ABORT (btor_opt_get (btor, BTOR_OPT_UCOPT),
-                  "incremental solving cannot be enabled "
-                  "if unconstrained optimization is enabled");
-    }
-    else if (opt == BTOR_OPT_UCOPT)
-    {
-      BTOR_ABORT (btor_opt_get (btor, BTOR_OPT_MODEL_GEN),
-                  "Unconstrained optimization cannot be enabled "
-                  "if model generation is enabled");
-      BTOR_ABORT (btor_opt_get (btor, BTOR_OPT_INCREMENTAL),
-                  "Unconstrained optimization cannot be enabled "
-                  "in incremental mode");
     }
     else if (opt == BTOR_OPT_FUN_DUAL_PROP)
     {
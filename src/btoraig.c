@@ -426,6 +426,15 @@ simp_aig_by_sat (BtorAIGMgr *amgr, BtorAIG *aig)
   return res;
 }
 
+BtorAIG *
+btor_aig_simp_by_sat (BtorAIGMgr *amgr, BtorAIG *aig)
+{
+  assert (amgr);
+  assert (aig);
+  assert (amgr->smgr->initialized);
+  return simp_aig_by_sat (amgr, aig);
+}
+
 BtorAIG *
 btor_aig_and (BtorAIGMgr *amgr, BtorAIG *left, BtorAIG *right)
 {
@@ -889,13 +898,16 @@ btor_aig_mgr_clone (Btor *btor, BtorAIGMgr *amgr)
   res->smgr = btor_sat_mgr_clone (btor, amgr->smgr);
   /* Note: we do not yet clone aigs here (we need the clone of the aig
    *       manager for that). */
-  res->max_num_aigs     = amgr->max_num_aigs;
-  res->max_num_aig_vars = amgr->max_num_aig_vars;
-  res->cur_num_aigs     = amgr->cur_num_aigs;
-  res->cur_num_aig_vars = amgr->cur_num_aig_vars;
-  res->num_cnf_vars     = amgr->num_cnf_vars;
-  res->num_cnf_clauses  = amgr->num_cnf_clauses;
-  res->num_cnf_literals = amgr->num_cnf_literals;
+  res->max_num_aigs          = amgr->max_num_aigs;
+  res->max_num_aig_vars      = amgr->max_num_aig_vars;
+  res->cur_num_aigs          = amgr->cur_num_aigs;
+  res->cur_num_aig_vars      = amgr->cur_num_aig_vars;
+  res->num_cnf_vars          = amgr->num_cnf_vars;
+  res->num_cnf_clauses       = amgr->num_cnf_clauses;
+  res->num_cnf_literals      = amgr->num_cnf_literals;
+  res->num_aigopt_rewritten  = amgr->num_aigopt_rewritten;
+  res->num_aigopt_refactored = amgr->num_aigopt_refactored;
+  res->num_aigopt_balanced   = amgr->num_aigopt_balanced;
   clone_aigs (amgr, res);
   return res;
 }
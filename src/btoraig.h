@@ -68,6 +68,9 @@ struct BtorAIGMgr
   uint_least64_t num_cnf_vars;
   uint_least64_t num_cnf_clauses;
   uint_least64_t num_cnf_literals;
+  uint_least64_t num_aigopt_rewritten;  /* AIG optimization (cut rewriting) */
+  uint_least64_t num_aigopt_refactored; /* AIG optimization (refactoring) */
+  uint_least64_t num_aigopt_balanced;   /* AIG optimization (balancing) */
 };
 
 typedef struct BtorAIGMgr BtorAIGMgr;
@@ -203,6 +206,10 @@ BtorAIG *btor_aig_copy (BtorAIGMgr *amgr, BtorAIG *aig);
  */
 void btor_aig_release (BtorAIGMgr *amgr, BtorAIG *aig);
 
+/* Simplifies AIG w.r.t. the literals fixed and the equivalent literals
+ * detected by the SAT solver (reference counter is not incremented). */
+BtorAIG *btor_aig_simp_by_sat (BtorAIGMgr *amgr, BtorAIG *aig);
+
 /* Translates AIG into SAT instance. */
 void btor_aig_to_sat (BtorAIGMgr *amgr, BtorAIG *aig);
 
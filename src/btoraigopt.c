@@ -0,0 +1,975 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "btoraigopt.h"
+
+#include "btorcore.h"
+#include "utils/btorhashint.h"
+#include "utils/btorutil.h"
+
+/*------------------------------------------------------------------------*/
+
+#define BTOR_AIGOPT_CUT_SIZE 4      /* max. number of leaves (rewriting) */
+#define BTOR_AIGOPT_MAX_CUTS 8      /* max. number of cuts per node */
+#define BTOR_AIGOPT_REFACTOR_SIZE 6 /* max. number of leaves (refactoring) */
+#define BTOR_AIGOPT_MAX_CONE 64     /* max. number of ANDs in a cut cone */
+#define BTOR_AIGOPT_MAX_CUBES 64    /* max. number of cubes in an ISOP */
+#define BTOR_AIGOPT_MAX_BALANCE 256 /* max. number of AND tree leaves */
+
+struct BtorAIGOptCut
+{
+  uint32_t size;
+  int32_t leaves[BTOR_AIGOPT_CUT_SIZE]; /* sorted, ascending */
+};
+
+typedef struct BtorAIGOptCut BtorAIGOptCut;
+
+struct BtorAIGOptCuts
+{
+  uint32_t num;
+  BtorAIGOptCut cuts[BTOR_AIGOPT_MAX_CUTS];
+};
+
+typedef struct BtorAIGOptCuts BtorAIGOptCuts;
+
+struct BtorAIGOptCube
+{
+  uint8_t pos; /* positive literals, bit i represents leaf i */
+  uint8_t neg; /* negative literals, bit i represents leaf i */
+};
+
+typedef struct BtorAIGOptCube BtorAIGOptCube;
+
+struct BtorAIGOptSop
+{
+  uint32_t num;
+  BtorAIGOptCube cubes[BTOR_AIGOPT_MAX_CUBES];
+};
+
+typedef struct BtorAIGOptSop BtorAIGOptSop;
+
+struct BtorAIGOptTTCache
+{
+  uint32_t num;
+  uint32_t depth;
+  int32_t ids[BTOR_AIGOPT_MAX_CONE];
+  uint64_t tts[BTOR_AIGOPT_MAX_CONE];
+};
+
+typedef struct BtorAIGOptTTCache BtorAIGOptTTCache;
+
+struct BtorAIGOpt
+{
+  BtorAIGMgr *amgr;
+  BtorMemMgr *mm;
+  BtorIntHashTable *refs;   /* AND id -> ref. counter prior to optimization */
+  BtorIntHashTable *cache;  /* AND id -> optimized AIG */
+  BtorIntHashTable *cuts;   /* AND id -> enumerated cuts */
+  BtorIntHashTable *levels; /* AND id -> level */
+  double deadline;
+  bool timeout;
+};
+
+typedef struct BtorAIGOpt BtorAIGOpt;
+
+/* truth tables of the (at most 6) cut leaves */
+static const uint64_t s_var_tt[BTOR_AIGOPT_REFACTOR_SIZE] = {
+    0xAAAAAAAAAAAAAAAAull,
+    0xCCCCCCCCCCCCCCCCull,
+    0xF0F0F0F0F0F0F0F0ull,
+    0xFF00FF00FF00FF00ull,
+    0xFFFF0000FFFF0000ull,
+    0xFFFFFFFF00000000ull};
+
+/*------------------------------------------------------------------------*/
+
+/* AND nodes that are not yet encoded to SAT are subject to optimization,
+ * all other AIGs are considered as inputs. */
+static bool
+is_opt_aig (BtorAIGOpt *opt, BtorAIG *aig)
+{
+  assert (BTOR_IS_REGULAR_AIG (aig));
+  if (btor_aig_is_const (aig)) return false;
+  return btor_hashint_map_contains (opt->refs, aig->id);
+}
+
+static uint32_t
+get_refs (BtorAIGOpt *opt, BtorAIG *aig)
+{
+  assert (is_opt_aig (opt, aig));
+  return (uint32_t) btor_hashint_map_get (opt->refs, aig->id)->as_int;
+}
+
+/* Get optimized AIG of 'aig' (does not increment the reference counter). */
+static BtorAIG *
+get_mapped (BtorAIGOpt *opt, BtorAIG *aig)
+{
+  BtorAIG *real, *res;
+  BtorHashTableData *d;
+
+  if (btor_aig_is_const (aig)) return aig;
+  real = BTOR_REAL_ADDR_AIG (aig);
+  if (!is_opt_aig (opt, real)) return aig;
+  d = btor_hashint_map_get (opt->cache, real->id);
+  assert (d);
+  res = d->as_ptr;
+  return BTOR_IS_INVERTED_AIG (aig) ? BTOR_INVERT_AIG (res) : res;
+}
+
+static uint32_t
+get_level (BtorAIGOpt *opt, BtorAIG *aig)
+{
+  BtorAIGPtrStack stack;
+  BtorAIG *cur, *left, *right;
+  BtorHashTableData *d;
+  uint32_t l0, l1;
+
+  aig = BTOR_REAL_ADDR_AIG (aig);
+  if (btor_aig_is_const (aig) || btor_aig_is_var (aig) || aig->cnf_id)
+    return 0;
+  if ((d = btor_hashint_map_get (opt->levels, aig->id))) return d->as_int;
+
+  BTOR_INIT_STACK (opt->mm, stack);
+  BTOR_PUSH_STACK (stack, aig);
+  while (!BTOR_EMPTY_STACK (stack))
+  {
+    cur = BTOR_TOP_STACK (stack);
+    if (btor_hashint_map_contains (opt->levels, cur->id))
+    {
+      (void) BTOR_POP_STACK (stack);
+      continue;
+    }
+    left  = BTOR_REAL_ADDR_AIG (btor_aig_get_left_child (opt->amgr, cur));
+    right = BTOR_REAL_ADDR_AIG (btor_aig_get_right_child (opt->amgr, cur));
+    l0    = 0;
+    l1    = 0;
+    if (btor_aig_is_and (left) && !left->cnf_id)
+    {
+      if (!(d = btor_hashint_map_get (opt->levels, left->id)))
+      {
+        BTOR_PUSH_STACK (stack, left);
+        continue;
+      }
+      l0 = d->as_int;
+    }
+    if (btor_aig_is_and (right) && !right->cnf_id)
+    {
+      if (!(d = btor_hashint_map_get (opt->levels, right->id)))
+      {
+        BTOR_PUSH_STACK (stack, right);
+        continue;
+      }
+      l1 = d->as_int;
+    }
+    btor_hashint_map_add (opt->levels, cur->id)->as_int =
+        (l0 > l1 ? l0 : l1) + 1;
+    (void) BTOR_POP_STACK (stack);
+  }
+  BTOR_RELEASE_STACK (stack);
+  return btor_hashint_map_get (opt->levels, aig->id)->as_int;
+}
+
+/*------------------------------------------------------------------------*/
+/* truth tables and cones                                                 */
+/*------------------------------------------------------------------------*/
+
+static bool
+compute_tt (BtorAIGOpt *opt,
+            BtorAIG *aig,
+            const int32_t *leaves,
+            uint32_t nleaves,
+            BtorAIGOptTTCache *tc,
+            uint64_t *res)
+{
+  uint32_t i;
+  uint64_t tt, tt0, tt1;
+  bool ok;
+  BtorAIG *real;
+
+  if (btor_aig_is_true (aig))
+  {
+    *res = ~0ull;
+    return true;
+  }
+  if (btor_aig_is_false (aig))
+  {
+    *res = 0;
+    return true;
+  }
+
+  real = BTOR_REAL_ADDR_AIG (aig);
+  for (i = 0; i < nleaves; i++)
+  {
+    if (leaves[i] == real->id)
+    {
+      tt = s_var_tt[i];
+      goto DONE;
+    }
+  }
+  for (i = 0; i < tc->num; i++)
+  {
+    if (tc->ids[i] == real->id)
+    {
+      tt = tc->tts[i];
+      goto DONE;
+    }
+  }
+  /* not a valid cut or cone too large */
+  if (!is_opt_aig (opt, real) || tc->num == BTOR_AIGOPT_MAX_CONE
+      || tc->depth == BTOR_AIGOPT_MAX_CONE)
+    return false;
+  tc->depth++;
+  ok = compute_tt (opt,
+                   btor_aig_get_left_child (opt->amgr, real),
+                   leaves,
+                   nleaves,
+                   tc,
+                   &tt0)
+       && compute_tt (opt,
+                      btor_aig_get_right_child (opt->amgr, real),
+                      leaves,
+                      nleaves,
+                      tc,
+                      &tt1);
+  tc->depth--;
+  if (!ok || tc->num == BTOR_AIGOPT_MAX_CONE) return false;
+  tt                = tt0 & tt1;
+  tc->ids[tc->num]  = real->id;
+  tc->tts[tc->num] = tt;
+  tc->num++;
+DONE:
+  *res = BTOR_IS_INVERTED_AIG (aig) ? ~tt : tt;
+  return true;
+}
+
+static bool
+is_leaf (const int32_t *leaves, uint32_t nleaves, int32_t id)
+{
+  uint32_t i;
+  for (i = 0; i < nleaves; i++)
+    if (leaves[i] == id) return true;
+  return false;
+}
+
+/* Number of ANDs in the maximum fanout free cone of 'aig' w.r.t. given cut,
+ * i.e., the number of ANDs that become obsolete if 'aig' is replaced. */
+static uint32_t
+mffc_size (BtorAIGOpt *opt,
+           BtorAIG *aig,
+           const int32_t *leaves,
+           uint32_t nleaves,
+           uint32_t depth)
+{
+  uint32_t i, res;
+  BtorAIG *child;
+
+  assert (BTOR_IS_REGULAR_AIG (aig));
+  assert (is_opt_aig (opt, aig));
+
+  res = 1;
+  if (depth == BTOR_AIGOPT_MAX_CONE) return res;
+  for (i = 0; i < 2; i++)
+  {
+    child = BTOR_REAL_ADDR_AIG (
+        btor_aig_get_by_id (opt->amgr, aig->children[i]));
+    if (!is_opt_aig (opt, child) || is_leaf (leaves, nleaves, child->id)
+        || get_refs (opt, child) > 1)
+      continue;
+    res += mffc_size (opt, child, leaves, nleaves, depth + 1);
+  }
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+/* cut enumeration                                                        */
+/*------------------------------------------------------------------------*/
+
+static bool
+merge_cuts (const BtorAIGOptCut *c0,
+            const BtorAIGOptCut *c1,
+            BtorAIGOptCut *res)
+{
+  uint32_t i, j;
+
+  i = j     = 0;
+  res->size = 0;
+  while (i < c0->size || j < c1->size)
+  {
+    if (res->size == BTOR_AIGOPT_CUT_SIZE) return false;
+    if (j == c1->size || (i < c0->size && c0->leaves[i] < c1->leaves[j]))
+      res->leaves[res->size++] = c0->leaves[i++];
+    else if (i == c0->size || c1->leaves[j] < c0->leaves[i])
+      res->leaves[res->size++] = c1->leaves[j++];
+    else
+    {
+      res->leaves[res->size++] = c0->leaves[i++];
+      j++;
+    }
+  }
+  return true;
+}
+
+/* Check if 'c0' is a subset of 'c1'. */
+static bool
+is_subset_cut (const BtorAIGOptCut *c0, const BtorAIGOptCut *c1)
+{
+  uint32_t i;
+
+  if (c0->size > c1->size) return false;
+  for (i = 0; i < c0->size; i++)
+    if (!is_leaf (c1->leaves, c1->size, c0->leaves[i])) return false;
+  return true;
+}
+
+/* Get cuts of 'aig', the trivial cut {aig} is always included. */
+static uint32_t
+get_cuts (BtorAIGOpt *opt, BtorAIG *aig, BtorAIGOptCut *cuts)
+{
+  uint32_t i, num;
+  BtorHashTableData *d;
+  BtorAIGOptCuts *c;
+
+  assert (BTOR_IS_REGULAR_AIG (aig));
+
+  num = 0;
+  if (is_opt_aig (opt, aig) && (d = btor_hashint_map_get (opt->cuts, aig->id)))
+  {
+    c = d->as_ptr;
+    for (i = 0; i < c->num; i++) cuts[num++] = c->cuts[i];
+  }
+  cuts[num].size      = 1;
+  cuts[num].leaves[0] = aig->id;
+  return num + 1;
+}
+
+static BtorAIGOptCuts *
+enumerate_cuts (BtorAIGOpt *opt, BtorAIG *aig)
+{
+  uint32_t i, j, k, n0, n1;
+  BtorAIGOptCut cuts0[BTOR_AIGOPT_MAX_CUTS + 1];
+  BtorAIGOptCut cuts1[BTOR_AIGOPT_MAX_CUTS + 1];
+  BtorAIGOptCut cut;
+  BtorAIGOptCuts *res;
+
+  assert (BTOR_IS_REGULAR_AIG (aig));
+
+  n0 = get_cuts (opt,
+                 BTOR_REAL_ADDR_AIG (btor_aig_get_left_child (opt->amgr, aig)),
+                 cuts0);
+  n1 = get_cuts (opt,
+                 BTOR_REAL_ADDR_AIG (btor_aig_get_right_child (opt->amgr, aig)),
+                 cuts1);
+
+  BTOR_CNEW (opt->mm, res);
+  for (i = 0; i < n0 && res->num < BTOR_AIGOPT_MAX_CUTS; i++)
+  {
+    for (j = 0; j < n1 && res->num < BTOR_AIGOPT_MAX_CUTS; j++)
+    {
+      if (!merge_cuts (&cuts0[i], &cuts1[j], &cut)) continue;
+      for (k = 0; k < res->num; k++)
+        if (is_subset_cut (&res->cuts[k], &cut)) break;
+      if (k < res->num) continue;
+      res->cuts[res->num++] = cut;
+    }
+  }
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+/* irredundant sum of products and factoring                              */
+/*------------------------------------------------------------------------*/
+
+static uint64_t
+cofactor0 (uint64_t tt, uint32_t var)
+{
+  uint64_t t = tt & ~s_var_tt[var];
+  return t | (t << (1u << var));
+}
+
+static uint64_t
+cofactor1 (uint64_t tt, uint32_t var)
+{
+  uint64_t t = tt & s_var_tt[var];
+  return t | (t >> (1u << var));
+}
+
+/* Minato-Morreale ISOP computation for function 'on' <= f <= 'ondc'
+ * over variables [0, nvars). */
+static bool
+isop (uint64_t on,
+      uint64_t ondc,
+      uint32_t nvars,
+      BtorAIGOptSop *sop,
+      uint64_t *res)
+{
+  uint32_t i, var, first;
+  uint64_t on0, on1, ondc0, ondc1, f0, f1, fs;
+
+  assert ((on & ~ondc) == 0);
+
+  if (on == 0)
+  {
+    *res = 0;
+    return true;
+  }
+  if (ondc == ~0ull)
+  {
+    if (sop->num == BTOR_AIGOPT_MAX_CUBES) return false;
+    sop->cubes[sop->num].pos   = 0;
+    sop->cubes[sop->num++].neg = 0;
+    *res                       = ~0ull;
+    return true;
+  }
+
+  assert (nvars > 0);
+  for (var = nvars - 1; var > 0; var--)
+  {
+    if (cofactor0 (on, var) != cofactor1 (on, var)
+        || cofactor0 (ondc, var) != cofactor1 (ondc, var))
+      break;
+  }
+
+  on0   = cofactor0 (on, var);
+  on1   = cofactor1 (on, var);
+  ondc0 = cofactor0 (ondc, var);
+  ondc1 = cofactor1 (ondc, var);
+
+  first = sop->num;
+  if (!isop (on0 & ~ondc1, ondc0, var, sop, &f0)) return false;
+  for (i = first; i < sop->num; i++) sop->cubes[i].neg |= 1u << var;
+
+  first = sop->num;
+  if (!isop (on1 & ~ondc0, ondc1, var, sop, &f1)) return false;
+  for (i = first; i < sop->num; i++) sop->cubes[i].pos |= 1u << var;
+
+  if (!isop ((on0 & ~f0) | (on1 & ~f1), ondc0 & ondc1, var, sop, &fs))
+    return false;
+
+  *res = (f0 & ~s_var_tt[var]) | (f1 & s_var_tt[var]) | fs;
+  return true;
+}
+
+static BtorAIG *
+lit_aig (BtorAIGMgr *amgr, BtorAIG **leaves, uint32_t var, bool neg)
+{
+  return neg ? btor_aig_not (amgr, leaves[var])
+             : btor_aig_copy (amgr, leaves[var]);
+}
+
+static BtorAIG *
+and_aig (BtorAIGMgr *amgr, BtorAIG *a, BtorAIG *b)
+{
+  BtorAIG *res;
+  res = btor_aig_and (amgr, a, b);
+  btor_aig_release (amgr, a);
+  btor_aig_release (amgr, b);
+  return res;
+}
+
+static BtorAIG *
+or_aig (BtorAIGMgr *amgr, BtorAIG *a, BtorAIG *b)
+{
+  BtorAIG *res;
+  res = btor_aig_or (amgr, a, b);
+  btor_aig_release (amgr, a);
+  btor_aig_release (amgr, b);
+  return res;
+}
+
+static uint32_t
+cube_cost (BtorAIGMgr *amgr,
+           BtorAIGOptCube *cube,
+           BtorAIG **leaves,
+           BtorAIG **res)
+{
+  uint32_t var, cost;
+  BtorAIG *aig;
+
+  aig  = BTOR_AIG_TRUE;
+  cost = 0;
+  for (var = 0; var < BTOR_AIGOPT_REFACTOR_SIZE; var++)
+  {
+    if (!((cube->pos | cube->neg) & (1u << var))) continue;
+    if (aig != BTOR_AIG_TRUE) cost++;
+    if (res)
+      aig = and_aig (
+          amgr, aig, lit_aig (amgr, leaves, var, cube->neg & (1u << var)));
+    else
+      aig = 0;
+  }
+  if (res) *res = aig;
+  return cost;
+}
+
+/* Algebraic factoring of the given cover w.r.t. the most frequent literal.
+ * Returns the number of ANDs required for the factored form, and builds
+ * the AIG if 'res' is not 0. */
+static uint32_t
+factor (BtorAIGMgr *amgr,
+        BtorAIGOptCube *cubes,
+        uint32_t num,
+        BtorAIG **leaves,
+        BtorAIG **res)
+{
+  uint32_t i, var, cnt, best_cnt, best_var, nq, nr, cost;
+  bool best_neg, q_true;
+  uint8_t mask;
+  BtorAIGOptCube q[BTOR_AIGOPT_MAX_CUBES], r[BTOR_AIGOPT_MAX_CUBES];
+  BtorAIG *aig, *tmp;
+
+  if (num == 0)
+  {
+    if (res) *res = BTOR_AIG_FALSE;
+    return 0;
+  }
+  for (i = 0; i < num; i++)
+  {
+    if (!cubes[i].pos && !cubes[i].neg)
+    {
+      if (res) *res = BTOR_AIG_TRUE;
+      return 0;
+    }
+  }
+  if (num == 1) return cube_cost (amgr, &cubes[0], leaves, res);
+
+  best_cnt = 0;
+  best_var = 0;
+  best_neg = false;
+  for (var = 0; var < BTOR_AIGOPT_REFACTOR_SIZE; var++)
+  {
+    mask = 1u << var;
+    for (cnt = 0, i = 0; i < num; i++)
+      if (cubes[i].pos & mask) cnt++;
+    if (cnt > best_cnt)
+    {
+      best_cnt = cnt;
+      best_var = var;
+      best_neg = false;
+    }
+    for (cnt = 0, i = 0; i < num; i++)
+      if (cubes[i].neg & mask) cnt++;
+    if (cnt > best_cnt)
+    {
+      best_cnt = cnt;
+      best_var = var;
+      best_neg = true;
+    }
+  }
+
+  /* no common literals, plain sum of products */
+  if (best_cnt <= 1)
+  {
+    cost = num - 1;
+    aig  = BTOR_AIG_FALSE;
+    for (i = 0; i < num; i++)
+    {
+      cost += cube_cost (amgr, &cubes[i], leaves, res ? &tmp : 0);
+      if (res) aig = or_aig (amgr, aig, tmp);
+    }
+    if (res) *res = aig;
+    return cost;
+  }
+
+  /* f = lit & q | r */
+  mask   = 1u << best_var;
+  nq     = 0;
+  nr     = 0;
+  q_true = false;
+  for (i = 0; i < num; i++)
+  {
+    if ((best_neg ? cubes[i].neg : cubes[i].pos) & mask)
+    {
+      q[nq] = cubes[i];
+      if (best_neg)
+        q[nq].neg &= ~mask;
+      else
+        q[nq].pos &= ~mask;
+      if (!q[nq].pos && !q[nq].neg) q_true = true;
+      nq++;
+    }
+    else
+      r[nr++] = cubes[i];
+  }
+
+  cost = factor (amgr, q, nq, leaves, res ? &tmp : 0);
+  if (!q_true) cost += 1;
+  if (res)
+    aig = and_aig (amgr, lit_aig (amgr, leaves, best_var, best_neg), tmp);
+  if (nr > 0)
+  {
+    cost += factor (amgr, r, nr, leaves, res ? &tmp : 0) + 1;
+    if (res) aig = or_aig (amgr, aig, tmp);
+  }
+  if (res) *res = aig;
+  return cost;
+}
+
+/* Compute cheapest factored form of 'tt' or its complement. */
+static uint32_t
+sop_cost (uint64_t tt, uint32_t nvars, BtorAIGOptSop *sop, bool *neg)
+{
+  uint32_t cost, ncost;
+  uint64_t res;
+  BtorAIGOptSop nsop;
+
+  cost = ncost = UINT32_MAX;
+
+  sop->num = 0;
+  if (isop (tt, tt, nvars, sop, &res))
+  {
+    assert (res == tt);
+    cost = factor (0, sop->cubes, sop->num, 0, 0);
+  }
+  nsop.num = 0;
+  if (isop (~tt, ~tt, nvars, &nsop, &res))
+  {
+    assert (res == ~tt);
+    ncost = factor (0, nsop.cubes, nsop.num, 0, 0);
+  }
+  *neg = ncost < cost;
+  if (*neg)
+  {
+    *sop = nsop;
+    return ncost;
+  }
+  return cost;
+}
+
+/* Build factored form of 'tt' over the optimized AIGs of given leaves
+ * if it requires less than 'max_cost' ANDs. */
+static BtorAIG *
+resynthesize (BtorAIGOpt *opt,
+              const int32_t *leaves,
+              uint32_t nleaves,
+              uint64_t tt,
+              uint32_t max_cost)
+{
+  uint32_t i, cost;
+  bool neg;
+  BtorAIG *res, *mapped[BTOR_AIGOPT_REFACTOR_SIZE];
+  BtorAIGOptSop sop;
+
+  assert (nleaves <= BTOR_AIGOPT_REFACTOR_SIZE);
+
+  cost = sop_cost (tt, nleaves, &sop, &neg);
+  if (cost >= max_cost) return 0;
+
+  for (i = 0; i < nleaves; i++)
+    mapped[i] = get_mapped (opt, btor_aig_get_by_id (opt->amgr, leaves[i]));
+  (void) factor (opt->amgr, sop.cubes, sop.num, mapped, &res);
+  return neg ? BTOR_INVERT_AIG (res) : res;
+}
+
+/*------------------------------------------------------------------------*/
+/* rewriting, refactoring and balancing                                   */
+/*------------------------------------------------------------------------*/
+
+static BtorAIG *
+rewrite (BtorAIGOpt *opt, BtorAIG *aig, BtorAIGOptCuts *cuts)
+{
+  uint32_t i, mffc, cost, gain, best_gain, best_mffc;
+  uint64_t tt, best_tt;
+  bool neg;
+  BtorAIGOptCut *cut, *best;
+  BtorAIGOptTTCache tc;
+  BtorAIGOptSop sop;
+
+  best      = 0;
+  best_gain = 0;
+  best_mffc = 0;
+  best_tt   = 0;
+  for (i = 0; i < cuts->num; i++)
+  {
+    cut = &cuts->cuts[i];
+    if (cut->size < 2) continue;
+    mffc = mffc_size (opt, aig, cut->leaves, cut->size, 0);
+    /* a single AND can not be replaced by anything cheaper */
+    if (mffc < 2) continue;
+    tc.num   = 0;
+    tc.depth = 0;
+    if (!compute_tt (opt, aig, cut->leaves, cut->size, &tc, &tt)) continue;
+    cost = sop_cost (tt, cut->size, &sop, &neg);
+    if (cost >= mffc) continue;
+    gain = mffc - cost;
+    if (gain > best_gain)
+    {
+      best      = cut;
+      best_gain = gain;
+      best_mffc = mffc;
+      best_tt   = tt;
+    }
+  }
+  if (!best) return 0;
+  return resynthesize (opt, best->leaves, best->size, best_tt, best_mffc);
+}
+
+static BtorAIG *
+refactor (BtorAIGOpt *opt, BtorAIG *aig)
+{
+  uint32_t i, j, k, n, nleaves, nexpanded, best_n;
+  int32_t leaves[BTOR_AIGOPT_REFACTOR_SIZE + 1], best;
+  uint64_t tt;
+  BtorAIG *leaf, *child;
+  BtorAIGOptTTCache tc;
+
+  nleaves = 0;
+  for (i = 0; i < 2; i++)
+  {
+    child = BTOR_REAL_ADDR_AIG (
+        btor_aig_get_by_id (opt->amgr, aig->children[i]));
+    if (!is_leaf (leaves, nleaves, child->id)) leaves[nleaves++] = child->id;
+  }
+
+  /* expand leaves that are part of the maximum fanout free cone */
+  nexpanded = 1;
+  for (;;)
+  {
+    best   = -1;
+    best_n = 0;
+    for (i = 0; i < nleaves; i++)
+    {
+      leaf = btor_aig_get_by_id (opt->amgr, leaves[i]);
+      if (!is_opt_aig (opt, leaf) || get_refs (opt, leaf) > 1) continue;
+      n = nleaves - 1;
+      for (j = 0; j < 2; j++)
+      {
+        child = BTOR_REAL_ADDR_AIG (
+            btor_aig_get_by_id (opt->amgr, leaf->children[j]));
+        if (!is_leaf (leaves, nleaves, child->id)) n++;
+      }
+      if (n <= BTOR_AIGOPT_REFACTOR_SIZE && (best < 0 || n < best_n))
+      {
+        best   = i;
+        best_n = n;
+      }
+    }
+    if (best < 0) break;
+
+    leaf = btor_aig_get_by_id (opt->amgr, leaves[best]);
+    for (k = best; k + 1 < nleaves; k++) leaves[k] = leaves[k + 1];
+    nleaves--;
+    for (j = 0; j < 2; j++)
+    {
+      child = BTOR_REAL_ADDR_AIG (
+          btor_aig_get_by_id (opt->amgr, leaf->children[j]));
+      if (!is_leaf (leaves, nleaves, child->id)) leaves[nleaves++] = child->id;
+    }
+    assert (nleaves <= BTOR_AIGOPT_REFACTOR_SIZE);
+    nexpanded++;
+  }
+
+  /* small cones are covered by cut rewriting */
+  if (nexpanded < 3) return 0;
+
+  tc.num   = 0;
+  tc.depth = 0;
+  if (!compute_tt (opt, aig, leaves, nleaves, &tc, &tt)) return 0;
+  return resynthesize (opt, leaves, nleaves, tt, nexpanded);
+}
+
+/* Rebuild multi-input AND tree rooted at 'aig' such that it has minimum
+ * depth (w.r.t. the levels of its leaves). */
+static BtorAIG *
+balance (BtorAIGOpt *opt, BtorAIG *aig)
+{
+  uint32_t i, nleaves, levels[BTOR_AIGOPT_MAX_BALANCE];
+  BtorAIG *cur, *leaves[BTOR_AIGOPT_MAX_BALANCE], *tmp;
+  BtorAIGPtrStack stack;
+  BtorAIGMgr *amgr;
+
+  amgr    = opt->amgr;
+  nleaves = 0;
+
+  BTOR_INIT_STACK (opt->mm, stack);
+  BTOR_PUSH_STACK (stack, btor_aig_get_right_child (amgr, aig));
+  BTOR_PUSH_STACK (stack, btor_aig_get_left_child (amgr, aig));
+  while (!BTOR_EMPTY_STACK (stack))
+  {
+    cur = BTOR_POP_STACK (stack);
+    if (BTOR_IS_REGULAR_AIG (cur) && is_opt_aig (opt, cur)
+        && get_refs (opt, cur) == 1
+        && nleaves + BTOR_COUNT_STACK (stack) + 2 < BTOR_AIGOPT_MAX_BALANCE)
+    {
+      BTOR_PUSH_STACK (stack, btor_aig_get_right_child (amgr, cur));
+      BTOR_PUSH_STACK (stack, btor_aig_get_left_child (amgr, cur));
+    }
+    else
+    {
+      /* insert sorted w.r.t. level */
+      tmp = btor_aig_copy (amgr, get_mapped (opt, cur));
+      i   = nleaves++;
+      for (; i > 0 && levels[i - 1] > get_level (opt, tmp); i--)
+      {
+        leaves[i] = leaves[i - 1];
+        levels[i] = levels[i - 1];
+      }
+      leaves[i] = tmp;
+      levels[i] = get_level (opt, tmp);
+    }
+  }
+  BTOR_RELEASE_STACK (stack);
+
+  if (nleaves < 3)
+  {
+    for (i = 0; i < nleaves; i++) btor_aig_release (amgr, leaves[i]);
+    return 0;
+  }
+
+  /* combine two leaves with lowest level */
+  while (nleaves > 1)
+  {
+    tmp = and_aig (amgr, leaves[0], leaves[1]);
+    for (i = 2; i < nleaves; i++)
+    {
+      leaves[i - 2] = leaves[i];
+      levels[i - 2] = levels[i];
+    }
+    nleaves -= 2;
+    i = nleaves++;
+    for (; i > 0 && levels[i - 1] > get_level (opt, tmp); i--)
+    {
+      leaves[i] = leaves[i - 1];
+      levels[i] = levels[i - 1];
+    }
+    leaves[i] = tmp;
+    levels[i] = get_level (opt, tmp);
+  }
+  return leaves[0];
+}
+
+static BtorAIG *
+optimize_aig (BtorAIGOpt *opt, BtorAIG *aig)
+{
+  BtorAIGMgr *amgr;
+  BtorAIGOptCuts *cuts;
+  BtorAIG *res, *bal;
+
+  amgr = opt->amgr;
+  res  = 0;
+
+  if (!opt->timeout)
+  {
+    cuts = enumerate_cuts (opt, aig);
+    btor_hashint_map_add (opt->cuts, aig->id)->as_ptr = cuts;
+
+    if ((res = rewrite (opt, aig, cuts)))
+      amgr->num_aigopt_rewritten++;
+    else if ((res = refactor (opt, aig)))
+      amgr->num_aigopt_refactored++;
+  }
+
+  if (!res)
+  {
+    res = btor_aig_and (amgr,
+                        get_mapped (opt, btor_aig_get_left_child (amgr, aig)),
+                        get_mapped (opt, btor_aig_get_right_child (amgr, aig)));
+    if (!opt->timeout && (bal = balance (opt, aig)))
+    {
+      if (get_level (opt, bal) < get_level (opt, res))
+      {
+        btor_aig_release (amgr, res);
+        res = bal;
+        amgr->num_aigopt_balanced++;
+      }
+      else
+        btor_aig_release (amgr, bal);
+    }
+  }
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+void
+btor_aigopt_optimize (BtorAIGMgr *amgr,
+                      BtorAIG **aigs,
+                      uint32_t naigs,
+                      double deadline)
+{
+  assert (amgr);
+  assert (aigs || naigs == 0);
+
+  uint32_t i;
+  BtorAIG *cur, *res;
+  BtorAIGPtrStack stack, order;
+  BtorAIGOpt opt;
+  BtorIntHashTableIterator it;
+
+  opt.amgr     = amgr;
+  opt.mm       = amgr->btor->mm;
+  opt.refs     = btor_hashint_map_new (opt.mm);
+  opt.cache    = btor_hashint_map_new (opt.mm);
+  opt.cuts     = btor_hashint_map_new (opt.mm);
+  opt.levels   = btor_hashint_map_new (opt.mm);
+  opt.deadline = deadline;
+  opt.timeout  = false;
+
+  /* collect ANDs in post order, reference counters are recorded prior to
+   * creating any new AIGs */
+  BTOR_INIT_STACK (opt.mm, stack);
+  BTOR_INIT_STACK (opt.mm, order);
+  for (i = 0; i < naigs; i++)
+  {
+    if (btor_aig_is_const (aigs[i])) continue;
+    BTOR_PUSH_STACK (stack, BTOR_REAL_ADDR_AIG (aigs[i]));
+    while (!BTOR_EMPTY_STACK (stack))
+    {
+      cur = BTOR_POP_STACK (stack);
+      if (cur)
+      {
+        if (btor_aig_is_var (cur) || cur->cnf_id
+            || btor_hashint_map_contains (opt.refs, cur->id))
+          continue;
+        btor_hashint_map_add (opt.refs, cur->id)->as_int = cur->refs;
+        BTOR_PUSH_STACK (stack, cur);
+        BTOR_PUSH_STACK (stack, 0);
+        BTOR_PUSH_STACK (
+            stack, BTOR_REAL_ADDR_AIG (btor_aig_get_right_child (amgr, cur)));
+        BTOR_PUSH_STACK (
+            stack, BTOR_REAL_ADDR_AIG (btor_aig_get_left_child (amgr, cur)));
+      }
+      else
+        BTOR_PUSH_STACK (order, BTOR_POP_STACK (stack));
+    }
+  }
+  BTOR_RELEASE_STACK (stack);
+
+  for (i = 0; i < BTOR_COUNT_STACK (order); i++)
+  {
+    if (deadline > 0 && !opt.timeout && (i & 63) == 0
+        && btor_util_time_stamp () > deadline)
+      opt.timeout = true;
+    cur = BTOR_PEEK_STACK (order, i);
+    res = optimize_aig (&opt, cur);
+    btor_hashint_map_add (opt.cache, cur->id)->as_ptr = res;
+  }
+
+  for (i = 0; i < naigs; i++)
+  {
+    if (btor_aig_is_const (aigs[i])) continue;
+    if (!is_opt_aig (&opt, BTOR_REAL_ADDR_AIG (aigs[i]))) continue;
+    res = btor_aig_copy (amgr, get_mapped (&opt, aigs[i]));
+    btor_aig_release (amgr, aigs[i]);
+    aigs[i] = res;
+  }
+
+  BTOR_RELEASE_STACK (order);
+
+  /* Note: original AIGs may get deleted here */
+  btor_iter_hashint_init (&it, opt.cache);
+  while (btor_iter_hashint_has_next (&it))
+    btor_aig_release (amgr, btor_iter_hashint_next_data (&it)->as_ptr);
+
+  btor_iter_hashint_init (&it, opt.cuts);
+  while (btor_iter_hashint_has_next (&it))
+    BTOR_DELETE (opt.mm,
+                 (BtorAIGOptCuts *) btor_iter_hashint_next_data (&it)->as_ptr);
+
+  btor_hashint_map_delete (opt.refs);
+  btor_hashint_map_delete (opt.cache);
+  btor_hashint_map_delete (opt.cuts);
+  btor_hashint_map_delete (opt.levels);
+}
@@ -0,0 +1,27 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORAIGOPT_H_INCLUDED
+#define BTORAIGOPT_H_INCLUDED
+
+#include "btoraig.h"
+
+#include <stdint.h>
+
+/* Optimize the AIGs in 'aigs' (in place) by cut based rewriting (4-input
+ * cuts), refactoring of maximum fanout free cones and balancing of AND
+ * trees.  Every entry in 'aigs' is replaced by a (new reference to an)
+ * equivalent AIG, the reference to the original AIG is released.
+ * AIGs that are already encoded to SAT are not modified.
+ * If 'deadline' is not 0, optimization stops as soon as the time stamp
+ * (see btor_util_time_stamp) exceeds 'deadline'.
+ */
+void btor_aigopt_optimize (BtorAIGMgr *amgr,
+                           BtorAIG **aigs,
+                           uint32_t naigs,
+                           double deadline);
+
+#endif
@@ -9,6 +9,7 @@
  */
 
 #include "btorbeta.h"
+#include "btorclone.h"
 #include "btorexp.h"
 #include "btorlog.h"
 #include "btorrewrite.h"
@@ -583,7 +584,8 @@ beta_reduce_partial_aux (Btor *btor,
                          BtorPtrHashTable *cond_sel_else,
                          BtorPtrHashTable *conds,
                          BtorNodePtrStack *conds_stack,
-                         BtorIntHashTable *conds_cache)
+                         BtorIntHashTable *conds_cache,
+                         BtorNodePtrStack *path)
 {
   assert (btor);
   assert (exp);
@@ -832,6 +834,8 @@ beta_reduce_partial_aux (Btor *btor,
             BTOR_PUSH_STACK (*conds_stack, btor_node_copy (btor, tmp));
           }
 
+          if (path) BTOR_PUSH_STACK (*path, btor_node_copy (btor, tmp));
+
           if (t && !btor_hashptr_table_get (t, e[0]))
             btor_hashptr_table_add (t, btor_node_copy (btor, e[0]));
 
@@ -932,7 +936,7 @@ BtorNode *
 btor_beta_reduce_partial (Btor *btor, BtorNode *exp, BtorPtrHashTable *conds)
 {
   BTORLOG (2, "%s: %s", __FUNCTION__, btor_util_node2string (exp));
-  return beta_reduce_partial_aux (btor, exp, 0, 0, conds, 0, 0);
+  return beta_reduce_partial_aux (btor, exp, 0, 0, conds, 0, 0, 0);
 }
 
 BtorNode *
@@ -943,7 +947,7 @@ btor_beta_reduce_partial_collect (Btor *btor,
 {
   BTORLOG (2, "%s: %s", __FUNCTION__, btor_util_node2string (exp));
   return beta_reduce_partial_aux (
-      btor, exp, cond_sel_if, cond_sel_else, 0, 0, 0);
+      btor, exp, cond_sel_if, cond_sel_else, 0, 0, 0, 0);
 }
 
 BtorNode *
@@ -953,5 +957,260 @@ btor_beta_reduce_partial_collect_new (Btor *btor,
                                       BtorIntHashTable *cache)
 {
   BTORLOG (2, "%s: %s", __FUNCTION__, btor_util_node2string (exp));
-  return beta_reduce_partial_aux (btor, exp, 0, 0, 0, exps, cache);
+  return beta_reduce_partial_aux (btor, exp, 0, 0, 0, exps, cache, 0);
+}
+
+/*------------------------------------------------------------------------*/
+
+/* Result of partially beta reducing a lambda w.r.t. some arguments.  The
+ * result is only valid for models under which all conditions in 'path' (the
+ * selected branch conditions in the order they were evaluated) are true. */
+struct BtorBetaCacheEntry
+{
+  BtorNode *result;
+  BtorNodePtrStack path;
+};
+
+typedef struct BtorBetaCacheEntry BtorBetaCacheEntry;
+
+static void
+delete_beta_cache_entry (Btor *btor,
+                         BtorNodePair *pair,
+                         BtorBetaCacheEntry *entry)
+{
+  while (!BTOR_EMPTY_STACK (entry->path))
+    btor_node_release (btor, BTOR_POP_STACK (entry->path));
+  BTOR_RELEASE_STACK (entry->path);
+  btor_node_release (btor, entry->result);
+  BTOR_DELETE (btor->mm, entry);
+  btor_node_pair_delete (btor, pair);
+}
+
+/* An entry is dead if its lambda or its arguments are only referenced by the
+ * cache, or if any of its nodes got simplified. */
+static bool
+is_dead_beta_cache_entry (BtorNodePair *pair, BtorBetaCacheEntry *entry)
+{
+  uint32_t i;
+
+  if (btor_node_real_addr (pair->node1)->refs == 1
+      || btor_node_real_addr (pair->node2)->refs == 1)
+    return true;
+  if (btor_node_is_simplified (pair->node1)
+      || btor_node_is_simplified (pair->node2)
+      || btor_node_is_simplified (entry->result))
+    return true;
+  for (i = 0; i < BTOR_COUNT_STACK (entry->path); i++)
+    if (btor_node_is_simplified (BTOR_PEEK_STACK (entry->path, i))) return true;
+  return false;
+}
+
+static bool
+is_valid_beta_cache_entry (Btor *btor, BtorBetaCacheEntry *entry)
+{
+  uint32_t i;
+  bool res;
+  BtorBitVector *eval_res;
+
+  for (i = 0, res = true; res && i < BTOR_COUNT_STACK (entry->path); i++)
+  {
+    eval_res = btor_eval_exp (btor, BTOR_PEEK_STACK (entry->path, i));
+    res      = btor_bv_is_true (eval_res);
+    btor_bv_free (btor->mm, eval_res);
+  }
+  return res;
+}
+
+BtorPtrHashTable *
+btor_beta_cache_new (Btor *btor)
+{
+  assert (btor);
+  return btor_hashptr_table_new (btor->mm,
+                                 (BtorHashPtr) btor_node_pair_hash,
+                                 (BtorCmpPtr) btor_node_pair_compare);
+}
+
+void
+btor_beta_cache_delete (Btor *btor, BtorPtrHashTable *cache)
+{
+  assert (btor);
+  assert (cache);
+
+  BtorPtrHashTableIterator it;
+  BtorBetaCacheEntry *entry;
+
+  btor_iter_hashptr_init (&it, cache);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    entry = it.bucket->data.as_ptr;
+    delete_beta_cache_entry (btor, btor_iter_hashptr_next (&it), entry);
+  }
+  btor_hashptr_table_delete (cache);
+}
+
+uint32_t
+btor_beta_cache_evict (Btor *btor, BtorPtrHashTable *cache)
+{
+  assert (btor);
+  assert (cache);
+
+  uint32_t res;
+  BtorNodePair *pair;
+  BtorBetaCacheEntry *entry;
+  BtorPtrHashBucket *b, *next;
+
+  for (b = cache->first, res = 0; b; b = next)
+  {
+    next  = b->next;
+    pair  = b->key;
+    entry = b->data.as_ptr;
+    if (!is_dead_beta_cache_entry (pair, entry)) continue;
+    btor_hashptr_table_remove (cache, pair, 0, 0);
+    delete_beta_cache_entry (btor, pair, entry);
+    res++;
+  }
+  return res;
+}
+
+static void *
+clone_key_as_node_pair (BtorMemMgr *mm, const void *map, const void *key)
+{
+  BtorNodePair *pair, *res;
+
+  pair = (BtorNodePair *) key;
+  BTOR_NEW (mm, res);
+  res->node1 = btor_nodemap_mapped ((BtorNodeMap *) map, pair->node1);
+  res->node2 = btor_nodemap_mapped ((BtorNodeMap *) map, pair->node2);
+  assert (res->node1);
+  assert (res->node2);
+  return res;
+}
+
+static void
+clone_data_as_beta_cache_entry (BtorMemMgr *mm,
+                                const void *map,
+                                BtorHashTableData *data,
+                                BtorHashTableData *cloned_data)
+{
+  BtorBetaCacheEntry *entry, *res;
+
+  entry = data->as_ptr;
+  BTOR_NEW (mm, res);
+  res->result = btor_nodemap_mapped ((BtorNodeMap *) map, entry->result);
+  assert (res->result);
+  btor_clone_node_ptr_stack (
+      mm, &entry->path, &res->path, (BtorNodeMap *) map, false);
+  cloned_data->as_ptr = res;
+}
+
+BtorPtrHashTable *
+btor_beta_cache_clone (BtorMemMgr *mm,
+                       BtorPtrHashTable *cache,
+                       BtorNodeMap *exp_map)
+{
+  assert (mm);
+  assert (cache);
+  assert (exp_map);
+
+  return btor_hashptr_table_clone (mm,
+                                   cache,
+                                   clone_key_as_node_pair,
+                                   clone_data_as_beta_cache_entry,
+                                   exp_map,
+                                   exp_map);
+}
+
+size_t
+btor_beta_cache_entries_bytes (BtorPtrHashTable *cache)
+{
+  assert (cache);
+
+  size_t res;
+  BtorPtrHashTableIterator it;
+  BtorBetaCacheEntry *entry;
+
+  res = cache->count * (sizeof (BtorNodePair) + sizeof (BtorBetaCacheEntry));
+  btor_iter_hashptr_init (&it, cache);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    entry = it.bucket->data.as_ptr;
+    (void) btor_iter_hashptr_next (&it);
+    res += BTOR_SIZE_STACK (entry->path) * sizeof (BtorNode *);
+  }
+  return res;
+}
+
+BtorNode *
+btor_beta_reduce_partial_cached (Btor *btor,
+                                 BtorNode *fun,
+                                 BtorNode *args,
+                                 BtorPtrHashTable *conds,
+                                 BtorPtrHashTable *cache)
+{
+  assert (btor);
+  assert (fun);
+  assert (args);
+  assert (cache);
+  assert (btor_node_is_regular (fun));
+  assert (btor_node_is_lambda (fun));
+  assert (btor_node_is_regular (args));
+  assert (btor_node_is_args (args));
+
+  uint32_t i;
+  BtorNode *cond;
+  BtorNodePair *pair;
+  BtorPtrHashBucket *b;
+  BtorBetaCacheEntry *entry;
+  BtorFunSolver *slv;
+
+  slv  = BTOR_FUN_SOLVER (btor);
+  pair = btor_node_pair_new (btor, fun, args);
+  b    = btor_hashptr_table_get (cache, pair);
+
+  if (b && is_valid_beta_cache_entry (btor, b->data.as_ptr))
+  {
+    btor_node_pair_delete (btor, pair);
+    slv->stats.beta_cache_hits++;
+    entry = b->data.as_ptr;
+    BTORLOG (2,
+             "%s: hit (%s, %s) -> %s",
+             __FUNCTION__,
+             btor_util_node2string (fun),
+             btor_util_node2string (args),
+             btor_util_node2string (entry->result));
+  }
+  else
+  {
+    slv->stats.beta_cache_misses++;
+    if (b)
+    {
+      /* reduced w.r.t. a different model, recompute */
+      btor_node_pair_delete (btor, pair);
+      entry = b->data.as_ptr;
+      while (!BTOR_EMPTY_STACK (entry->path))
+        btor_node_release (btor, BTOR_POP_STACK (entry->path));
+      btor_node_release (btor, entry->result);
+    }
+    else
+    {
+      BTOR_CNEW (btor->mm, entry);
+      BTOR_INIT_STACK (btor->mm, entry->path);
+      btor_hashptr_table_add (cache, pair)->data.as_ptr = entry;
+    }
+    btor_beta_assign_args (btor, fun, args);
+    entry->result =
+        beta_reduce_partial_aux (btor, fun, 0, 0, 0, 0, 0, &entry->path);
+    btor_beta_unassign_params (btor, fun);
+  }
+
+  if (conds)
+  {
+    for (i = 0; i < BTOR_COUNT_STACK (entry->path); i++)
+    {
+      cond = btor_node_real_addr (BTOR_PEEK_STACK (entry->path, i));
+      if (!btor_hashptr_table_get (conds, cond))
+        btor_hashptr_table_add (conds, btor_node_copy (btor, cond));
+    }
+  }
+  return btor_node_copy (btor, entry->result);
 }
@@ -13,6 +13,7 @@
 #include "btortypes.h"
 #include "utils/btorhashint.h"
 #include "utils/btorhashptr.h"
+#include "utils/btornodemap.h"
 
 BtorNode* btor_beta_reduce_full (Btor* btor,
                                  BtorNode* exp,
@@ -38,6 +39,33 @@ BtorNode* btor_beta_reduce_partial_collect_new (Btor* btor,
 
 BtorNode* btor_beta_reduce_bounded (Btor* btor, BtorNode* exp, int32_t bound);
 
+/* Persistent cache for partial beta reduction (fun solver only), maps pairs
+ * of lambdas and arguments to their partially reduced term.  Entries are kept
+ * across refinement rounds and incremental calls and are validated against
+ * the current model on lookup. */
+BtorPtrHashTable* btor_beta_cache_new (Btor* btor);
+
+void btor_beta_cache_delete (Btor* btor, BtorPtrHashTable* cache);
+
+/* Remove entries whose lambda or arguments are only referenced by the cache
+ * or got simplified.  Returns the number of removed entries. */
+uint32_t btor_beta_cache_evict (Btor* btor, BtorPtrHashTable* cache);
+
+BtorPtrHashTable* btor_beta_cache_clone (BtorMemMgr* mm,
+                                         BtorPtrHashTable* cache,
+                                         BtorNodeMap* exp_map);
+
+size_t btor_beta_cache_entries_bytes (BtorPtrHashTable* cache);
+
+/* Partially beta reduce lambda 'fun' w.r.t. arguments 'args' (parameters of
+ * 'fun' must not be assigned) and add the evaluated conditions to 'conds'
+ * (if given), see btor_beta_reduce_partial. */
+BtorNode* btor_beta_reduce_partial_cached (Btor* btor,
+                                           BtorNode* fun,
+                                           BtorNode* args,
+                                           BtorPtrHashTable* conds,
+                                           BtorPtrHashTable* cache);
+
 void btor_beta_assign_param (Btor* btor, BtorNode* lambda, BtorNode* arg);
 
 void btor_beta_assign_args (Btor* btor, BtorNode* fun, BtorNode* args);
@@ -0,0 +1,1398 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "btorbvdomain.h"
+
+#include "btorcore.h"
+#include "btorlog.h"
+#include "btornode.h"
+#include "utils/btornodeiter.h"
+#include "utils/btorstack.h"
+#include "utils/btorutil.h"
+
+/* maximum number of backward/forward sweeps in btor_bvdomain_propagate */
+#define BTOR_BVDOMAIN_MAX_ROUNDS 4
+
+/*------------------------------------------------------------------------*/
+
+BtorBvDomain *
+btor_bvdomain_new_init (BtorMemMgr *mm, uint32_t width)
+{
+  assert (mm);
+  assert (width > 0);
+
+  BtorBvDomain *res;
+
+  BTOR_CNEW (mm, res);
+  res->lo  = btor_bv_new (mm, width);
+  res->hi  = btor_bv_ones (mm, width);
+  res->min = btor_bv_new (mm, width);
+  res->max = btor_bv_ones (mm, width);
+  return res;
+}
+
+BtorBvDomain *
+btor_bvdomain_new_fixed (BtorMemMgr *mm, const BtorBitVector *bv)
+{
+  assert (mm);
+  assert (bv);
+
+  BtorBvDomain *res;
+
+  BTOR_CNEW (mm, res);
+  res->lo  = btor_bv_copy (mm, bv);
+  res->hi  = btor_bv_copy (mm, bv);
+  res->min = btor_bv_copy (mm, bv);
+  res->max = btor_bv_copy (mm, bv);
+  return res;
+}
+
+BtorBvDomain *
+btor_bvdomain_copy (BtorMemMgr *mm, const BtorBvDomain *d)
+{
+  assert (mm);
+  assert (d);
+
+  BtorBvDomain *res;
+
+  BTOR_CNEW (mm, res);
+  res->lo  = btor_bv_copy (mm, d->lo);
+  res->hi  = btor_bv_copy (mm, d->hi);
+  res->min = btor_bv_copy (mm, d->min);
+  res->max = btor_bv_copy (mm, d->max);
+  return res;
+}
+
+void
+btor_bvdomain_free (BtorMemMgr *mm, BtorBvDomain *d)
+{
+  assert (mm);
+  assert (d);
+
+  btor_bv_free (mm, d->lo);
+  btor_bv_free (mm, d->hi);
+  btor_bv_free (mm, d->min);
+  btor_bv_free (mm, d->max);
+  BTOR_DELETE (mm, d);
+}
+
+size_t
+btor_bvdomain_size (const BtorBvDomain *d)
+{
+  assert (d);
+  return sizeof (*d) + btor_bv_size (d->lo) + btor_bv_size (d->hi)
+         + btor_bv_size (d->min) + btor_bv_size (d->max);
+}
+
+uint32_t
+btor_bvdomain_get_width (const BtorBvDomain *d)
+{
+  assert (d);
+  return btor_bv_get_width (d->lo);
+}
+
+BtorBvDomain *
+btor_bvdomain_not (BtorMemMgr *mm, const BtorBvDomain *d)
+{
+  assert (mm);
+  assert (d);
+
+  BtorBvDomain *res;
+
+  /* ~x = ones - x, i.e., negation reverses the unsigned order */
+  BTOR_CNEW (mm, res);
+  res->lo  = btor_bv_not (mm, d->hi);
+  res->hi  = btor_bv_not (mm, d->lo);
+  res->min = btor_bv_not (mm, d->max);
+  res->max = btor_bv_not (mm, d->min);
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+static void
+set_bv (BtorMemMgr *mm, BtorBitVector **dst, BtorBitVector *src)
+{
+  btor_bv_free (mm, *dst);
+  *dst = src;
+}
+
+static bool
+bv_ult (const BtorBitVector *a, const BtorBitVector *b)
+{
+  return btor_bv_compare (a, b) < 0;
+}
+
+static BtorBitVector *
+bv_umin (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
+{
+  return btor_bv_copy (mm, bv_ult (a, b) ? a : b);
+}
+
+static BtorBitVector *
+bv_umax (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
+{
+  return btor_bv_copy (mm, bv_ult (a, b) ? b : a);
+}
+
+/* Returns min (bv, width) as uint32_t. */
+static uint32_t
+bv_to_shift (const BtorBitVector *bv, uint32_t width)
+{
+  uint32_t i, bw, res;
+
+  bw = btor_bv_get_width (bv);
+  if (bw - btor_bv_get_num_leading_zeros (bv) > 31) return width;
+  for (i = 0, res = 0; i < bw && i < 31; i++)
+    res |= btor_bv_get_bit (bv, i) << i;
+  return res < width ? res : width;
+}
+
+bool
+btor_bvdomain_meet (BtorMemMgr *mm, BtorBvDomain *d, const BtorBvDomain *e)
+{
+  assert (mm);
+  assert (d);
+  assert (e);
+  assert (btor_bvdomain_get_width (d) == btor_bvdomain_get_width (e));
+
+  set_bv (mm, &d->lo, btor_bv_or (mm, d->lo, e->lo));
+  set_bv (mm, &d->hi, btor_bv_and (mm, d->hi, e->hi));
+  if (bv_ult (d->min, e->min))
+    set_bv (mm, &d->min, btor_bv_copy (mm, e->min));
+  if (bv_ult (e->max, d->max))
+    set_bv (mm, &d->max, btor_bv_copy (mm, e->max));
+  return btor_bvdomain_normalize (mm, d);
+}
+
+bool
+btor_bvdomain_normalize (BtorMemMgr *mm, BtorBvDomain *d)
+{
+  assert (mm);
+  assert (d);
+
+  uint32_t i, bw, bit;
+  bool fixed;
+
+  bw = btor_bvdomain_get_width (d);
+
+  /* every value consistent with the known bits is in [lo, hi] */
+  if (bv_ult (d->min, d->lo)) set_bv (mm, &d->min, btor_bv_copy (mm, d->lo));
+  if (bv_ult (d->hi, d->max)) set_bv (mm, &d->max, btor_bv_copy (mm, d->hi));
+  if (bv_ult (d->max, d->min)) return false;
+
+  /* all values in [min, max] share the common prefix of min and max */
+  for (i = bw, fixed = false; i > 0; i--)
+  {
+    bit = btor_bv_get_bit (d->min, i - 1);
+    if (bit != btor_bv_get_bit (d->max, i - 1)) break;
+    if (bit)
+    {
+      if (!btor_bv_get_bit (d->hi, i - 1)) return false;
+      if (!btor_bv_get_bit (d->lo, i - 1))
+      {
+        btor_bv_set_bit (d->lo, i - 1, 1);
+        fixed = true;
+      }
+    }
+    else
+    {
+      if (btor_bv_get_bit (d->lo, i - 1)) return false;
+      if (btor_bv_get_bit (d->hi, i - 1))
+      {
+        btor_bv_set_bit (d->hi, i - 1, 0);
+        fixed = true;
+      }
+    }
+  }
+
+  /* remaining conflicts between known bits */
+  for (i = 0; i < bw; i++)
+    if (btor_bv_get_bit (d->lo, i) && !btor_bv_get_bit (d->hi, i))
+      return false;
+
+  if (fixed)
+  {
+    if (bv_ult (d->min, d->lo)) set_bv (mm, &d->min, btor_bv_copy (mm, d->lo));
+    if (bv_ult (d->hi, d->max)) set_bv (mm, &d->max, btor_bv_copy (mm, d->hi));
+    if (bv_ult (d->max, d->min)) return false;
+  }
+  return true;
+}
+
+bool
+btor_bvdomain_is_fixed (const BtorBvDomain *d)
+{
+  assert (d);
+  return btor_bv_compare (d->lo, d->hi) == 0;
+}
+
+bool
+btor_bvdomain_is_fixed_bit (const BtorBvDomain *d, uint32_t pos)
+{
+  assert (d);
+  assert (pos < btor_bvdomain_get_width (d));
+  return btor_bv_get_bit (d->lo, pos) == btor_bv_get_bit (d->hi, pos);
+}
+
+bool
+btor_bvdomain_is_fixed_bit_true (const BtorBvDomain *d, uint32_t pos)
+{
+  assert (d);
+  assert (pos < btor_bvdomain_get_width (d));
+  return btor_bv_get_bit (d->lo, pos) == 1;
+}
+
+bool
+btor_bvdomain_is_fixed_bit_false (const BtorBvDomain *d, uint32_t pos)
+{
+  assert (d);
+  assert (pos < btor_bvdomain_get_width (d));
+  return btor_bv_get_bit (d->hi, pos) == 0;
+}
+
+bool
+btor_bvdomain_is_init (const BtorBvDomain *d)
+{
+  assert (d);
+  return btor_bv_is_zero (d->lo) && btor_bv_is_ones (d->hi)
+         && btor_bv_is_zero (d->min) && btor_bv_is_ones (d->max);
+}
+
+bool
+btor_bvdomain_contains (BtorMemMgr *mm,
+                        const BtorBvDomain *d,
+                        const BtorBitVector *bv)
+{
+  assert (mm);
+  assert (d);
+  assert (bv);
+  assert (btor_bvdomain_get_width (d) == btor_bv_get_width (bv));
+
+  bool res;
+  BtorBitVector *tmp;
+
+  if (bv_ult (bv, d->min) || bv_ult (d->max, bv)) return false;
+  tmp = btor_bv_and (mm, bv, d->hi);
+  res = btor_bv_compare (tmp, bv) == 0;
+  btor_bv_free (mm, tmp);
+  if (!res) return false;
+  tmp = btor_bv_and (mm, bv, d->lo);
+  res = btor_bv_compare (tmp, d->lo) == 0;
+  btor_bv_free (mm, tmp);
+  return res;
+}
+
+static BtorBitVector *
+fix_bits (BtorMemMgr *mm, const BtorBvDomain *d, const BtorBitVector *bv)
+{
+  BtorBitVector *tmp, *res;
+
+  tmp = btor_bv_and (mm, bv, d->hi);
+  res = btor_bv_or (mm, tmp, d->lo);
+  btor_bv_free (mm, tmp);
+  return res;
+}
+
+BtorBitVector *
+btor_bvdomain_clamp (BtorMemMgr *mm,
+                     const BtorBvDomain *d,
+                     const BtorBitVector *bv)
+{
+  assert (mm);
+  assert (d);
+  assert (bv);
+  assert (btor_bvdomain_get_width (d) == btor_bv_get_width (bv));
+
+  BtorBitVector *res;
+
+  res = fix_bits (mm, d, bv);
+  if (!bv_ult (res, d->min) && !bv_ult (d->max, res)) return res;
+  btor_bv_free (mm, res);
+
+  /* out of bounds, move to the closest bound and fix bits again */
+  res = fix_bits (mm, d, bv_ult (bv, d->min) ? d->min : d->max);
+  if (btor_bvdomain_contains (mm, d, res)) return res;
+  btor_bv_free (mm, res);
+  res = fix_bits (mm, d, bv_ult (bv, d->min) ? d->max : d->min);
+  if (btor_bvdomain_contains (mm, d, res)) return res;
+  btor_bv_free (mm, res);
+  return fix_bits (mm, d, bv);
+}
+
+/*------------------------------------------------------------------------*/
+/* forward transfer functions                                             */
+/*------------------------------------------------------------------------*/
+
+static BtorBvDomain *
+new_bool (BtorMemMgr *mm, bool value)
+{
+  BtorBitVector *bv;
+  BtorBvDomain *res;
+
+  bv  = value ? btor_bv_one (mm, 1) : btor_bv_new (mm, 1);
+  res = btor_bvdomain_new_fixed (mm, bv);
+  btor_bv_free (mm, bv);
+  return res;
+}
+
+static BtorBvDomain *
+fwd_and (BtorMemMgr *mm, BtorBvDomain *d0, BtorBvDomain *d1)
+{
+  BtorBvDomain *res;
+
+  res = btor_bvdomain_new_init (mm, btor_bvdomain_get_width (d0));
+  set_bv (mm, &res->lo, btor_bv_and (mm, d0->lo, d1->lo));
+  set_bv (mm, &res->hi, btor_bv_and (mm, d0->hi, d1->hi));
+  set_bv (mm, &res->max, bv_umin (mm, d0->max, d1->max));
+  return res;
+}
+
+static BtorBvDomain *
+fwd_eq (BtorMemMgr *mm, BtorBvDomain *d0, BtorBvDomain *d1)
+{
+  bool conflict;
+  BtorBitVector *nhi, *tmp0, *tmp1;
+
+  if (bv_ult (d0->max, d1->min) || bv_ult (d1->max, d0->min))
+    return new_bool (mm, false);
+
+  nhi      = btor_bv_not (mm, d1->hi);
+  tmp0     = btor_bv_and (mm, d0->lo, nhi);
+  conflict = !btor_bv_is_zero (tmp0);
+  btor_bv_free (mm, tmp0);
+  btor_bv_free (mm, nhi);
+  if (!conflict)
+  {
+    nhi      = btor_bv_not (mm, d0->hi);
+    tmp1     = btor_bv_and (mm, d1->lo, nhi);
+    conflict = !btor_bv_is_zero (tmp1);
+    btor_bv_free (mm, tmp1);
+    btor_bv_free (mm, nhi);
+  }
+  if (conflict) return new_bool (mm, false);
+
+  if (btor_bvdomain_is_fixed (d0) && btor_bvdomain_is_fixed (d1))
+    return new_bool (mm, btor_bv_compare (d0->lo, d1->lo) == 0);
+
+  return btor_bvdomain_new_init (mm, 1);
+}
+
+static BtorBvDomain *
+fwd_ult (BtorMemMgr *mm, BtorBvDomain *d0, BtorBvDomain *d1)
+{
+  if (bv_ult (d0->max, d1->min)) return new_bool (mm, true);
+  if (!bv_ult (d0->min, d1->max)) return new_bool (mm, false);
+  return btor_bvdomain_new_init (mm, 1);
+}
+
+static BtorBvDomain *
+fwd_add (BtorMemMgr *mm, BtorBvDomain *d0, BtorBvDomain *d1)
+{
+  uint32_t i, bw, a, b, c, fa, fb, fc;
+  BtorBvDomain *res;
+  BtorBitVector *x, *y, *smin, *smax;
+
+  bw  = btor_bvdomain_get_width (d0);
+  res = btor_bvdomain_new_init (mm, bw);
+
+  /* known bits: ripple carry over three-valued bits */
+  for (i = 0, c = 0, fc = 1; i < bw; i++)
+  {
+    fa = btor_bvdomain_is_fixed_bit (d0, i);
+    fb = btor_bvdomain_is_fixed_bit (d1, i);
+    a  = btor_bv_get_bit (d0->lo, i);
+    b  = btor_bv_get_bit (d1->lo, i);
+    if (fa && fb && fc)
+    {
+      if (a ^ b ^ c)
+        btor_bv_set_bit (res->lo, i, 1);
+      else
+        btor_bv_set_bit (res->hi, i, 0);
+      c = (a & b) | (a & c) | (b & c);
+    }
+    else if (fa && fb && a == b)
+    {
+      c  = a;
+      fc = 1;
+    }
+    else if (fc && ((fa && a == c) || (fb && b == c)))
+    {
+      /* carry is kept */
+    }
+    else
+      fc = 0;
+  }
+
+  /* interval: [min0 + min1, max0 + max1] if both or none overflow */
+  x    = btor_bv_uext (mm, d0->min, 1);
+  y    = btor_bv_uext (mm, d1->min, 1);
+  smin = btor_bv_add (mm, x, y);
+  btor_bv_free (mm, x);
+  btor_bv_free (mm, y);
+  x    = btor_bv_uext (mm, d0->max, 1);
+  y    = btor_bv_uext (mm, d1->max, 1);
+  smax = btor_bv_add (mm, x, y);
+  btor_bv_free (mm, x);
+  btor_bv_free (mm, y);
+  if (btor_bv_get_bit (smin, bw) == btor_bv_get_bit (smax, bw))
+  {
+    set_bv (mm, &res->min, btor_bv_slice (mm, smin, bw - 1, 0));
+    set_bv (mm, &res->max, btor_bv_slice (mm, smax, bw - 1, 0));
+  }
+  btor_bv_free (mm, smin);
+  btor_bv_free (mm, smax);
+  return res;
+}
+
+static BtorBvDomain *
+fwd_mul (BtorMemMgr *mm, BtorBvDomain *d0, BtorBvDomain *d1)
+{
+  uint32_t i, bw, tz;
+  BtorBvDomain *res;
+  BtorBitVector *tmp;
+
+  if (btor_bvdomain_is_fixed (d0) && btor_bvdomain_is_fixed (d1))
+  {
+    tmp = btor_bv_mul (mm, d0->lo, d1->lo);
+    res = btor_bvdomain_new_fixed (mm, tmp);
+    btor_bv_free (mm, tmp);
+    return res;
+  }
+
+  bw  = btor_bvdomain_get_width (d0);
+  res = btor_bvdomain_new_init (mm, bw);
+
+  /* trailing zeros of the operands add up */
+  tz = btor_bv_get_num_trailing_zeros (d0->hi)
+       + btor_bv_get_num_trailing_zeros (d1->hi);
+  for (i = 0; i < tz && i < bw; i++) btor_bv_set_bit (res->hi, i, 0);
+
+  if (!btor_bv_is_umulo (mm, d0->max, d1->max))
+  {
+    set_bv (mm, &res->min, btor_bv_mul (mm, d0->min, d1->min));
+    set_bv (mm, &res->max, btor_bv_mul (mm, d0->max, d1->max));
+  }
+  return res;
+}
+
+static BtorBvDomain *
+fwd_udiv (BtorMemMgr *mm, BtorBvDomain *d0, BtorBvDomain *d1)
+{
+  BtorBvDomain *res;
+
+  /* division by zero yields ones */
+  res = btor_bvdomain_new_init (mm, btor_bvdomain_get_width (d0));
+  set_bv (mm, &res->min, btor_bv_udiv (mm, d0->min, d1->max));
+  if (!btor_bv_is_zero (d1->min))
+    set_bv (mm, &res->max, btor_bv_udiv (mm, d0->max, d1->min));
+  return res;
+}
+
+static BtorBvDomain *
+fwd_urem (BtorMemMgr *mm, BtorBvDomain *d0, BtorBvDomain *d1)
+{
+  BtorBvDomain *res;
+
+  /* a < b implies a % b = a */
+  if (bv_ult (d0->max, d1->min)) return btor_bvdomain_copy (mm, d0);
+
+  /* a % b <= a, and a % b < b if b != 0 */
+  res = btor_bvdomain_new_init (mm, btor_bvdomain_get_width (d0));
+  if (btor_bv_is_zero (d1->min) || !bv_ult (d1->max, d0->max))
+    set_bv (mm, &res->max, btor_bv_copy (mm, d0->max));
+  else
+    set_bv (mm, &res->max, btor_bv_dec (mm, d1->max));
+  return res;
+}
+
+static BtorBvDomain *
+fwd_sll (BtorMemMgr *mm, BtorBvDomain *d0, BtorBvDomain *d1)
+{
+  uint32_t i, bw, tz;
+  BtorBvDomain *res;
+  BtorBitVector *tmp;
+
+  bw  = btor_bvdomain_get_width (d0);
+  res = btor_bvdomain_new_init (mm, bw);
+
+  if (btor_bvdomain_is_fixed (d1))
+  {
+    set_bv (mm, &res->lo, btor_bv_sll (mm, d0->lo, d1->lo));
+    set_bv (mm, &res->hi, btor_bv_sll (mm, d0->hi, d1->lo));
+    tmp = btor_bv_sll (mm, d0->max, d1->lo);
+    set_bv (mm, &tmp, btor_bv_srl (mm, tmp, d1->lo));
+    if (btor_bv_compare (tmp, d0->max) == 0)
+    {
+      set_bv (mm, &res->min, btor_bv_sll (mm, d0->min, d1->lo));
+      set_bv (mm, &res->max, btor_bv_sll (mm, d0->max, d1->lo));
+    }
+    btor_bv_free (mm, tmp);
+  }
+  else
+  {
+    tz = btor_bv_get_num_trailing_zeros (d0->hi) + bv_to_shift (d1->min, bw);
+    for (i = 0; i < tz && i < bw; i++) btor_bv_set_bit (res->hi, i, 0);
+  }
+  return res;
+}
+
+static BtorBvDomain *
+fwd_srl (BtorMemMgr *mm, BtorBvDomain *d0, BtorBvDomain *d1)
+{
+  BtorBvDomain *res;
+
+  res = btor_bvdomain_new_init (mm, btor_bvdomain_get_width (d0));
+  if (btor_bvdomain_is_fixed (d1))
+  {
+    set_bv (mm, &res->lo, btor_bv_srl (mm, d0->lo, d1->lo));
+    set_bv (mm, &res->hi, btor_bv_srl (mm, d0->hi, d1->lo));
+  }
+  set_bv (mm, &res->min, btor_bv_srl (mm, d0->min, d1->max));
+  set_bv (mm, &res->max, btor_bv_srl (mm, d0->max, d1->min));
+  return res;
+}
+
+static BtorBvDomain *
+fwd_concat (BtorMemMgr *mm, BtorBvDomain *d0, BtorBvDomain *d1)
+{
+  BtorBvDomain *res;
+
+  BTOR_CNEW (mm, res);
+  res->lo  = btor_bv_concat (mm, d0->lo, d1->lo);
+  res->hi  = btor_bv_concat (mm, d0->hi, d1->hi);
+  res->min = btor_bv_concat (mm, d0->min, d1->min);
+  res->max = btor_bv_concat (mm, d0->max, d1->max);
+  return res;
+}
+
+static BtorBvDomain *
+fwd_slice (BtorMemMgr *mm, BtorBvDomain *d0, uint32_t upper, uint32_t lower)
+{
+  uint32_t bw;
+  bool same_prefix;
+  BtorBvDomain *res;
+  BtorBitVector *pmin, *pmax;
+
+  bw  = btor_bvdomain_get_width (d0);
+  res = btor_bvdomain_new_init (mm, upper - lower + 1);
+  set_bv (mm, &res->lo, btor_bv_slice (mm, d0->lo, upper, lower));
+  set_bv (mm, &res->hi, btor_bv_slice (mm, d0->hi, upper, lower));
+
+  /* slicing is monotone on values with a common prefix above 'upper' */
+  same_prefix = upper == bw - 1;
+  if (!same_prefix)
+  {
+    pmin        = btor_bv_slice (mm, d0->min, bw - 1, upper + 1);
+    pmax        = btor_bv_slice (mm, d0->max, bw - 1, upper + 1);
+    same_prefix = btor_bv_compare (pmin, pmax) == 0;
+    btor_bv_free (mm, pmin);
+    btor_bv_free (mm, pmax);
+  }
+  if (same_prefix)
+  {
+    set_bv (mm, &res->min, btor_bv_slice (mm, d0->min, upper, lower));
+    set_bv (mm, &res->max, btor_bv_slice (mm, d0->max, upper, lower));
+  }
+  return res;
+}
+
+static BtorBvDomain *
+fwd_cond (BtorMemMgr *mm, BtorBvDomain *d0, BtorBvDomain *d1, BtorBvDomain *d2)
+{
+  BtorBvDomain *res;
+
+  if (btor_bvdomain_is_fixed (d0))
+    return btor_bvdomain_copy (mm, btor_bv_is_true (d0->lo) ? d1 : d2);
+
+  BTOR_CNEW (mm, res);
+  res->lo  = btor_bv_and (mm, d1->lo, d2->lo);
+  res->hi  = btor_bv_or (mm, d1->hi, d2->hi);
+  res->min = bv_umin (mm, d1->min, d2->min);
+  res->max = bv_umax (mm, d1->max, d2->max);
+  return res;
+}
+
+/* Compute the domain of 'exp' from the domains 'd' of its children. */
+static BtorBvDomain *
+forward (Btor *btor, BtorNode *exp, BtorBvDomain *d[3])
+{
+  assert (btor_node_is_regular (exp));
+
+  BtorMemMgr *mm;
+  BtorBvDomain *res;
+
+  mm = btor->mm;
+  switch (exp->kind)
+  {
+    case BTOR_BV_AND_NODE: res = fwd_and (mm, d[0], d[1]); break;
+    case BTOR_BV_EQ_NODE: res = fwd_eq (mm, d[0], d[1]); break;
+    case BTOR_BV_ULT_NODE: res = fwd_ult (mm, d[0], d[1]); break;
+    case BTOR_BV_ADD_NODE: res = fwd_add (mm, d[0], d[1]); break;
+    case BTOR_BV_MUL_NODE: res = fwd_mul (mm, d[0], d[1]); break;
+    case BTOR_BV_UDIV_NODE: res = fwd_udiv (mm, d[0], d[1]); break;
+    case BTOR_BV_UREM_NODE: res = fwd_urem (mm, d[0], d[1]); break;
+    case BTOR_BV_SLL_NODE: res = fwd_sll (mm, d[0], d[1]); break;
+    case BTOR_BV_SRL_NODE: res = fwd_srl (mm, d[0], d[1]); break;
+    case BTOR_BV_CONCAT_NODE: res = fwd_concat (mm, d[0], d[1]); break;
+    case BTOR_BV_SLICE_NODE:
+      res = fwd_slice (mm,
+                       d[0],
+                       btor_node_bv_slice_get_upper (exp),
+                       btor_node_bv_slice_get_lower (exp));
+      break;
+    default:
+      assert (btor_node_is_bv_cond (exp));
+      res = fwd_cond (mm, d[0], d[1], d[2]);
+  }
+
+  /* the transfer functions are sound, an empty result is thus only possible
+   * if the children domains are empty */
+  if (!btor_bvdomain_normalize (mm, res))
+  {
+    btor_bvdomain_free (mm, res);
+    res = btor_bvdomain_new_init (mm, btor_node_bv_get_width (btor, exp));
+  }
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+static bool
+has_domain (BtorNode *exp)
+{
+  assert (btor_node_is_regular (exp));
+
+  switch (exp->kind)
+  {
+    case BTOR_BV_AND_NODE:
+    case BTOR_BV_EQ_NODE:
+    case BTOR_BV_ULT_NODE:
+    case BTOR_BV_ADD_NODE:
+    case BTOR_BV_MUL_NODE:
+    case BTOR_BV_UDIV_NODE:
+    case BTOR_BV_UREM_NODE:
+    case BTOR_BV_SLL_NODE:
+    case BTOR_BV_SRL_NODE:
+    case BTOR_BV_CONCAT_NODE:
+    case BTOR_BV_SLICE_NODE: return true;
+    default: return btor_node_is_bv_cond (exp);
+  }
+}
+
+static BtorBvDomain *
+get_stored (BtorIntHashTable *map, BtorNode *exp)
+{
+  BtorHashTableData *d;
+
+  if (!map) return 0;
+  d = btor_hashint_map_get (map, btor_node_real_addr (exp)->id);
+  return d ? d->as_ptr : 0;
+}
+
+/* Compute domains of 'exp' and all of its children (bottom-up) that are
+ * not yet stored in 'btor->bv_domains'. */
+static void
+compute_domains (Btor *btor, BtorNode *exp)
+{
+  uint32_t i;
+  BtorNode *cur;
+  BtorNodePtrStack visit;
+  BtorIntHashTable *mark;
+  BtorHashTableData *d;
+  BtorBvDomain *de[3];
+  BtorMemMgr *mm;
+
+  mm = btor->mm;
+  if (!btor->bv_domains) btor->bv_domains = btor_hashint_map_new (mm);
+
+  mark = btor_hashint_map_new (mm);
+  BTOR_INIT_STACK (mm, visit);
+  BTOR_PUSH_STACK (visit, exp);
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = btor_node_real_addr (BTOR_POP_STACK (visit));
+
+    if (!has_domain (cur) || btor_hashint_map_contains (btor->bv_domains, cur->id))
+      continue;
+
+    d = btor_hashint_map_get (mark, cur->id);
+    if (!d)
+    {
+      btor_hashint_map_add (mark, cur->id);
+      BTOR_PUSH_STACK (visit, cur);
+      for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (visit, cur->e[i]);
+    }
+    else if (!d->as_int)
+    {
+      d->as_int = 1;
+      for (i = 0; i < cur->arity; i++)
+        de[i] = btor_bvdomain_get (btor, cur->e[i]);
+      btor_hashint_map_add (btor->bv_domains, cur->id)->as_ptr =
+          forward (btor, cur, de);
+      for (i = 0; i < cur->arity; i++) btor_bvdomain_free (mm, de[i]);
+    }
+  }
+  BTOR_RELEASE_STACK (visit);
+  btor_hashint_map_delete (mark);
+}
+
+BtorBvDomain *
+btor_bvdomain_get (Btor *btor, BtorNode *exp)
+{
+  assert (btor);
+  assert (exp);
+  assert (!btor_node_is_fun (exp));
+
+  BtorNode *real_exp;
+  BtorBvDomain *res, *d;
+
+  real_exp = btor_node_real_addr (exp);
+  if (btor_node_is_bv_const (real_exp))
+    return btor_bvdomain_new_fixed (
+        btor->mm,
+        btor_node_is_inverted (exp) ? btor_node_bv_const_get_invbits (real_exp)
+                                    : btor_node_bv_const_get_bits (real_exp));
+
+  if (has_domain (real_exp))
+  {
+    if (!(d = get_stored (btor->bv_domains, real_exp)))
+    {
+      compute_domains (btor, real_exp);
+      d = get_stored (btor->bv_domains, real_exp);
+    }
+    assert (d);
+    res = btor_bvdomain_copy (btor->mm, d);
+  }
+  else
+    res = btor_bvdomain_new_init (btor->mm,
+                                  btor_node_bv_get_width (btor, real_exp));
+
+  if (btor_node_is_inverted (exp))
+  {
+    d   = res;
+    res = btor_bvdomain_not (btor->mm, d);
+    btor_bvdomain_free (btor->mm, d);
+  }
+  return res;
+}
+
+BtorBvDomain *
+btor_bvdomain_get_constrained (Btor *btor, BtorNode *exp)
+{
+  assert (btor);
+  assert (exp);
+
+  BtorBvDomain *res, *d, *dinv;
+
+  res = btor_bvdomain_get (btor, exp);
+  if (btor_node_is_bv_var (exp) && (d = get_stored (btor->bv_var_domains, exp)))
+  {
+    if (btor_node_is_inverted (exp))
+    {
+      dinv = btor_bvdomain_not (btor->mm, d);
+      btor_bvdomain_free (btor->mm, res);
+      res = dinv;
+    }
+    else
+    {
+      btor_bvdomain_free (btor->mm, res);
+      res = btor_bvdomain_copy (btor->mm, d);
+    }
+  }
+  return res;
+}
+
+void
+btor_bvdomain_compute (Btor *btor, BtorNode *exp)
+{
+  assert (btor);
+  assert (exp);
+  assert (btor_node_is_regular (exp));
+
+  if (!has_domain (exp)) return;
+  compute_domains (btor, exp);
+}
+
+void
+btor_bvdomain_remove (Btor *btor, BtorNode *exp)
+{
+  assert (btor);
+  assert (exp);
+
+  BtorHashTableData d;
+  int32_t id;
+
+  id = btor_node_real_addr (exp)->id;
+  if (btor->bv_domains && btor_hashint_map_contains (btor->bv_domains, id))
+  {
+    btor_hashint_map_remove (btor->bv_domains, id, &d);
+    btor_bvdomain_free (btor->mm, d.as_ptr);
+  }
+  if (btor->bv_var_domains
+      && btor_hashint_map_contains (btor->bv_var_domains, id))
+  {
+    btor_hashint_map_remove (btor->bv_var_domains, id, &d);
+    btor_bvdomain_free (btor->mm, d.as_ptr);
+  }
+}
+
+/*------------------------------------------------------------------------*/
+/* backward propagation                                                   */
+/*------------------------------------------------------------------------*/
+
+struct BtorBvDomainPropState
+{
+  Btor *btor;
+  BtorIntHashTable *domains; /* node id -> working domain */
+  bool changed;
+  bool empty;
+};
+
+typedef struct BtorBvDomainPropState BtorBvDomainPropState;
+
+/* Get working domain of regular node 'exp'. */
+static BtorBvDomain *
+get_working (BtorBvDomainPropState *ps, BtorNode *exp)
+{
+  assert (btor_node_is_regular (exp));
+
+  BtorBvDomain *res;
+
+  if ((res = get_stored (ps->domains, exp))) return res;
+  res = btor_bvdomain_get (ps->btor, exp);
+  btor_hashint_map_add (ps->domains, exp->id)->as_ptr = res;
+  return res;
+}
+
+/* Get (a copy of) the working domain of (possibly inverted) edge 'exp'. */
+static BtorBvDomain *
+get_edge (BtorBvDomainPropState *ps, BtorNode *exp)
+{
+  BtorBvDomain *d;
+
+  d = get_working (ps, btor_node_real_addr (exp));
+  if (btor_node_is_inverted (exp)) return btor_bvdomain_not (ps->btor->mm, d);
+  return btor_bvdomain_copy (ps->btor->mm, d);
+}
+
+/* Restrict the working domain of (possibly inverted) edge 'exp' to 'e'. */
+static void
+meet_edge (BtorBvDomainPropState *ps, BtorNode *exp, const BtorBvDomain *e)
+{
+  BtorMemMgr *mm;
+  BtorBvDomain *d, *old, *einv;
+
+  if (ps->empty) return;
+
+  mm  = ps->btor->mm;
+  d   = get_working (ps, btor_node_real_addr (exp));
+  old = btor_bvdomain_copy (mm, d);
+  if (btor_node_is_inverted (exp))
+  {
+    einv = btor_bvdomain_not (mm, e);
+    ps->empty |= !btor_bvdomain_meet (mm, d, einv);
+    btor_bvdomain_free (mm, einv);
+  }
+  else
+    ps->empty |= !btor_bvdomain_meet (mm, d, e);
+
+  if (btor_bv_compare (old->lo, d->lo) || btor_bv_compare (old->hi, d->hi)
+      || btor_bv_compare (old->min, d->min)
+      || btor_bv_compare (old->max, d->max))
+    ps->changed = true;
+  btor_bvdomain_free (mm, old);
+}
+
+static void
+bwd_and (BtorBvDomainPropState *ps, BtorNode *exp, BtorBvDomain *d)
+{
+  uint32_t i;
+  BtorMemMgr *mm;
+  BtorBvDomain *de[2], *e;
+  BtorBitVector *tmp;
+
+  mm    = ps->btor->mm;
+  de[0] = get_edge (ps, exp->e[0]);
+  de[1] = get_edge (ps, exp->e[1]);
+  for (i = 0; i < 2; i++)
+  {
+    /* bits set in the result are set in both operands, a bit not set in the
+     * result is not set in one operand if it is set in the other */
+    e = btor_bvdomain_new_init (mm, btor_bvdomain_get_width (d));
+    set_bv (mm, &e->lo, btor_bv_copy (mm, d->lo));
+    tmp = btor_bv_not (mm, d->hi);
+    set_bv (mm, &tmp, btor_bv_and (mm, tmp, de[1 - i]->lo));
+    set_bv (mm, &e->hi, btor_bv_not (mm, tmp));
+    btor_bv_free (mm, tmp);
+    /* x & y <= x */
+    set_bv (mm, &e->min, btor_bv_copy (mm, d->min));
+    meet_edge (ps, exp->e[i], e);
+    btor_bvdomain_free (mm, e);
+  }
+  btor_bvdomain_free (mm, de[0]);
+  btor_bvdomain_free (mm, de[1]);
+}
+
+static void
+bwd_eq (BtorBvDomainPropState *ps, BtorNode *exp, BtorBvDomain *d)
+{
+  BtorMemMgr *mm;
+  BtorBvDomain *de[2], *e;
+
+  mm    = ps->btor->mm;
+  de[0] = get_edge (ps, exp->e[0]);
+  de[1] = get_edge (ps, exp->e[1]);
+  if (btor_bvdomain_is_fixed_bit_true (d, 0))
+  {
+    meet_edge (ps, exp->e[0], de[1]);
+    meet_edge (ps, exp->e[1], de[0]);
+  }
+  else if (btor_bvdomain_is_fixed_bit_false (d, 0)
+           && btor_bvdomain_get_width (de[0]) == 1)
+  {
+    if (btor_bvdomain_is_fixed (de[0]))
+    {
+      e = btor_bvdomain_not (mm, de[0]);
+      meet_edge (ps, exp->e[1], e);
+      btor_bvdomain_free (mm, e);
+    }
+    else if (btor_bvdomain_is_fixed (de[1]))
+    {
+      e = btor_bvdomain_not (mm, de[1]);
+      meet_edge (ps, exp->e[0], e);
+      btor_bvdomain_free (mm, e);
+    }
+  }
+  btor_bvdomain_free (mm, de[0]);
+  btor_bvdomain_free (mm, de[1]);
+}
+
+static void
+bwd_ult (BtorBvDomainPropState *ps, BtorNode *exp, BtorBvDomain *d)
+{
+  uint32_t bw;
+  BtorMemMgr *mm;
+  BtorBvDomain *de[2], *e;
+
+  if (!btor_bvdomain_is_fixed (d)) return;
+
+  mm    = ps->btor->mm;
+  de[0] = get_edge (ps, exp->e[0]);
+  de[1] = get_edge (ps, exp->e[1]);
+  bw    = btor_bvdomain_get_width (de[0]);
+
+  if (btor_bv_is_true (d->lo))
+  {
+    /* a < b: a <= max (b) - 1 and b >= min (a) + 1 */
+    if (btor_bv_is_zero (de[1]->max) || btor_bv_is_ones (de[0]->min))
+      ps->empty = true;
+    else
+    {
+      e = btor_bvdomain_new_init (mm, bw);
+      set_bv (mm, &e->max, btor_bv_dec (mm, de[1]->max));
+      meet_edge (ps, exp->e[0], e);
+      btor_bvdomain_free (mm, e);
+      e = btor_bvdomain_new_init (mm, bw);
+      set_bv (mm, &e->min, btor_bv_inc (mm, de[0]->min));
+      meet_edge (ps, exp->e[1], e);
+      btor_bvdomain_free (mm, e);
+    }
+  }
+  else
+  {
+    /* a >= b: a >= min (b) and b <= max (a) */
+    e = btor_bvdomain_new_init (mm, bw);
+    set_bv (mm, &e->min, btor_bv_copy (mm, de[1]->min));
+    meet_edge (ps, exp->e[0], e);
+    btor_bvdomain_free (mm, e);
+    e = btor_bvdomain_new_init (mm, bw);
+    set_bv (mm, &e->max, btor_bv_copy (mm, de[0]->max));
+    meet_edge (ps, exp->e[1], e);
+    btor_bvdomain_free (mm, e);
+  }
+  btor_bvdomain_free (mm, de[0]);
+  btor_bvdomain_free (mm, de[1]);
+}
+
+static void
+bwd_add (BtorBvDomainPropState *ps, BtorNode *exp, BtorBvDomain *d)
+{
+  uint32_t i;
+  BtorMemMgr *mm;
+  BtorBvDomain *de[2], *e;
+  BtorBitVector *c, *tmp;
+
+  mm    = ps->btor->mm;
+  de[0] = get_edge (ps, exp->e[0]);
+  de[1] = get_edge (ps, exp->e[1]);
+  for (i = 0; i < 2; i++)
+  {
+    if (!btor_bvdomain_is_fixed (de[1 - i])) continue;
+    c = de[1 - i]->lo;
+    /* x + c = y  <=>  x = y - c */
+    if (btor_bvdomain_is_fixed (d))
+    {
+      tmp = btor_bv_sub (mm, d->lo, c);
+      e   = btor_bvdomain_new_fixed (mm, tmp);
+      btor_bv_free (mm, tmp);
+    }
+    else
+    {
+      e = btor_bvdomain_new_init (mm, btor_bvdomain_get_width (d));
+      if (!bv_ult (d->min, c))
+      {
+        set_bv (mm, &e->min, btor_bv_sub (mm, d->min, c));
+        set_bv (mm, &e->max, btor_bv_sub (mm, d->max, c));
+      }
+    }
+    meet_edge (ps, exp->e[i], e);
+    btor_bvdomain_free (mm, e);
+    break;
+  }
+  btor_bvdomain_free (mm, de[0]);
+  btor_bvdomain_free (mm, de[1]);
+}
+
+/* Restrict bits [lower + to - from : lower] of 'exp' to the known bits in
+ * [to : from] of 'd'. */
+static void
+meet_bits (BtorBvDomainPropState *ps,
+           BtorNode *exp,
+           BtorBvDomain *d,
+           uint32_t from,
+           uint32_t to,
+           uint32_t lower)
+{
+  uint32_t i;
+  BtorBvDomain *e;
+
+  e = btor_bvdomain_new_init (ps->btor->mm,
+                              btor_node_bv_get_width (ps->btor, exp));
+  for (i = from; i <= to; i++)
+  {
+    if (btor_bvdomain_is_fixed_bit_true (d, i))
+      btor_bv_set_bit (e->lo, lower + i - from, 1);
+    else if (btor_bvdomain_is_fixed_bit_false (d, i))
+      btor_bv_set_bit (e->hi, lower + i - from, 0);
+  }
+  meet_edge (ps, exp, e);
+  btor_bvdomain_free (ps->btor->mm, e);
+}
+
+static void
+bwd_concat (BtorBvDomainPropState *ps, BtorNode *exp, BtorBvDomain *d)
+{
+  uint32_t bw, bw1;
+  BtorMemMgr *mm;
+  BtorBvDomain *e;
+  BtorBitVector *pmin, *pmax;
+
+  mm  = ps->btor->mm;
+  bw  = btor_bvdomain_get_width (d);
+  bw1 = btor_node_bv_get_width (ps->btor, exp->e[1]);
+
+  meet_bits (ps, exp->e[0], d, bw1, bw - 1, 0);
+  meet_bits (ps, exp->e[1], d, 0, bw1 - 1, 0);
+
+  /* the upper part is monotone in the value of the concatenation */
+  e = btor_bvdomain_new_init (mm, bw - bw1);
+  set_bv (mm, &e->min, btor_bv_slice (mm, d->min, bw - 1, bw1));
+  set_bv (mm, &e->max, btor_bv_slice (mm, d->max, bw - 1, bw1));
+  meet_edge (ps, exp->e[0], e);
+  btor_bvdomain_free (mm, e);
+
+  pmin = btor_bv_slice (mm, d->min, bw - 1, bw1);
+  pmax = btor_bv_slice (mm, d->max, bw - 1, bw1);
+  if (btor_bv_compare (pmin, pmax) == 0)
+  {
+    e = btor_bvdomain_new_init (mm, bw1);
+    set_bv (mm, &e->min, btor_bv_slice (mm, d->min, bw1 - 1, 0));
+    set_bv (mm, &e->max, btor_bv_slice (mm, d->max, bw1 - 1, 0));
+    meet_edge (ps, exp->e[1], e);
+    btor_bvdomain_free (mm, e);
+  }
+  btor_bv_free (mm, pmin);
+  btor_bv_free (mm, pmax);
+}
+
+static void
+bwd_shift (BtorBvDomainPropState *ps, BtorNode *exp, BtorBvDomain *d)
+{
+  uint32_t bw, shift;
+  BtorBvDomain *d1;
+
+  d1 = get_edge (ps, exp->e[1]);
+  if (btor_bvdomain_is_fixed (d1))
+  {
+    bw    = btor_bvdomain_get_width (d);
+    shift = bv_to_shift (d1->lo, bw);
+    if (shift < bw)
+    {
+      if (btor_node_is_bv_sll (exp))
+        meet_bits (ps, exp->e[0], d, shift, bw - 1, 0);
+      else
+        meet_bits (ps, exp->e[0], d, 0, bw - 1 - shift, shift);
+    }
+  }
+  btor_bvdomain_free (ps->btor->mm, d1);
+}
+
+static void
+bwd_cond (BtorBvDomainPropState *ps, BtorNode *exp, BtorBvDomain *d)
+{
+  bool empty;
+  BtorMemMgr *mm;
+  BtorBvDomain *dc, *e, *bval;
+
+  mm = ps->btor->mm;
+  dc = get_edge (ps, exp->e[0]);
+  if (btor_bvdomain_is_fixed (dc))
+    meet_edge (ps, btor_bv_is_true (dc->lo) ? exp->e[1] : exp->e[2], d);
+  else
+  {
+    /* if a branch is inconsistent with the result, the condition selects
+     * the other branch */
+    e     = get_edge (ps, exp->e[1]);
+    empty = !btor_bvdomain_meet (mm, e, d);
+    btor_bvdomain_free (mm, e);
+    if (empty)
+    {
+      bval = new_bool (mm, false);
+      meet_edge (ps, exp->e[0], bval);
+      btor_bvdomain_free (mm, bval);
+      meet_edge (ps, exp->e[2], d);
+    }
+    else
+    {
+      e     = get_edge (ps, exp->e[2]);
+      empty = !btor_bvdomain_meet (mm, e, d);
+      btor_bvdomain_free (mm, e);
+      if (empty)
+      {
+        bval = new_bool (mm, true);
+        meet_edge (ps, exp->e[0], bval);
+        btor_bvdomain_free (mm, bval);
+        meet_edge (ps, exp->e[1], d);
+      }
+    }
+  }
+  btor_bvdomain_free (mm, dc);
+}
+
+static void
+backward (BtorBvDomainPropState *ps, BtorNode *exp)
+{
+  assert (btor_node_is_regular (exp));
+  assert (has_domain (exp));
+
+  uint32_t upper, lower;
+  BtorBvDomain *d;
+
+  d = btor_bvdomain_copy (ps->btor->mm, get_working (ps, exp));
+  switch (exp->kind)
+  {
+    case BTOR_BV_AND_NODE: bwd_and (ps, exp, d); break;
+    case BTOR_BV_EQ_NODE: bwd_eq (ps, exp, d); break;
+    case BTOR_BV_ULT_NODE: bwd_ult (ps, exp, d); break;
+    case BTOR_BV_ADD_NODE: bwd_add (ps, exp, d); break;
+    case BTOR_BV_CONCAT_NODE: bwd_concat (ps, exp, d); break;
+    case BTOR_BV_SLL_NODE:
+    case BTOR_BV_SRL_NODE: bwd_shift (ps, exp, d); break;
+    case BTOR_BV_SLICE_NODE:
+      upper = btor_node_bv_slice_get_upper (exp);
+      lower = btor_node_bv_slice_get_lower (exp);
+      meet_bits (ps, exp->e[0], d, 0, upper - lower, lower);
+      break;
+    case BTOR_BV_MUL_NODE:
+    case BTOR_BV_UDIV_NODE:
+    case BTOR_BV_UREM_NODE: break;
+    default:
+      assert (btor_node_is_bv_cond (exp));
+      bwd_cond (ps, exp, d);
+  }
+  btor_bvdomain_free (ps->btor->mm, d);
+}
+
+void
+btor_bvdomain_propagate (Btor *btor)
+{
+  assert (btor);
+
+  uint32_t i, j, rounds, nfixed;
+  double start;
+  BtorMemMgr *mm;
+  BtorNode *cur;
+  BtorNodePtrStack visit, nodes, roots;
+  BtorIntHashTable *mark;
+  BtorPtrHashTableIterator it;
+  BtorIntHashTableIterator iit;
+  BtorBvDomainPropState ps;
+  BtorBvDomain *d, *de[3], *bval, *dv;
+
+  if (btor->unsynthesized_constraints->count == 0
+      && btor->synthesized_constraints->count == 0)
+    return;
+
+  start = btor_util_time_stamp ();
+  mm    = btor->mm;
+
+  /* collect all bit-vector operator nodes below the top level constraints,
+   * we do not descend into functions */
+  BTOR_INIT_STACK (mm, visit);
+  BTOR_INIT_STACK (mm, nodes);
+  BTOR_INIT_STACK (mm, roots);
+  mark = btor_hashint_table_new (mm);
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->synthesized_constraints);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    cur = btor_iter_hashptr_next (&it);
+    BTOR_PUSH_STACK (roots, cur);
+    BTOR_PUSH_STACK (visit, cur);
+  }
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = btor_node_real_addr (BTOR_POP_STACK (visit));
+    if (btor_hashint_table_contains (mark, cur->id)) continue;
+    btor_hashint_table_add (mark, cur->id);
+    BTOR_PUSH_STACK (nodes, cur);
+    if (!has_domain (cur)) continue;
+    for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (visit, cur->e[i]);
+  }
+  btor_hashint_table_delete (mark);
+  BTOR_RELEASE_STACK (visit);
+
+  /* children have smaller ids than their parents */
+  qsort (nodes.start,
+         BTOR_COUNT_STACK (nodes),
+         sizeof (BtorNode *),
+         btor_node_compare_by_id_qsort_asc);
+
+  ps.btor    = btor;
+  ps.domains = btor_hashint_map_new (mm);
+  ps.empty   = false;
+
+  bval = new_bool (mm, true);
+  for (rounds = 0, ps.changed = true;
+       ps.changed && !ps.empty && rounds < BTOR_BVDOMAIN_MAX_ROUNDS;
+       rounds++)
+  {
+    ps.changed = false;
+    for (i = 0; i < BTOR_COUNT_STACK (roots) && !ps.empty; i++)
+      meet_edge (&ps, BTOR_PEEK_STACK (roots, i), bval);
+
+    /* backward */
+    for (i = BTOR_COUNT_STACK (nodes); i > 0 && !ps.empty; i--)
+    {
+      cur = BTOR_PEEK_STACK (nodes, i - 1);
+      if (has_domain (cur)) backward (&ps, cur);
+    }
+
+    /* forward */
+    for (i = 0; i < BTOR_COUNT_STACK (nodes) && !ps.empty; i++)
+    {
+      cur = BTOR_PEEK_STACK (nodes, i);
+      if (!has_domain (cur)) continue;
+      for (j = 0; j < cur->arity; j++) de[j] = get_edge (&ps, cur->e[j]);
+      d = forward (btor, cur, de);
+      meet_edge (&ps, cur, d);
+      btor_bvdomain_free (mm, d);
+      for (j = 0; j < cur->arity; j++) btor_bvdomain_free (mm, de[j]);
+    }
+  }
+  btor_bvdomain_free (mm, bval);
+
+  /* store domains of bit-vector variables */
+  nfixed = 0;
+  if (ps.empty)
+  {
+    BTOR_MSG (btor->msg,
+              1,
+              "bv domain propagation derived empty domain, results discarded");
+  }
+  else
+  {
+    for (i = 0; i < BTOR_COUNT_STACK (nodes); i++)
+    {
+      cur = BTOR_PEEK_STACK (nodes, i);
+      if (!btor_node_is_bv_var (cur)) continue;
+      d = get_stored (ps.domains, cur);
+      if (!d || btor_bvdomain_is_init (d)) continue;
+      if (!btor->bv_var_domains) btor->bv_var_domains = btor_hashint_map_new (mm);
+      if ((dv = get_stored (btor->bv_var_domains, cur)))
+      {
+        if (!btor_bvdomain_meet (mm, dv, d))
+        {
+          /* cannot happen with sound rules, keep the new domain */
+          btor_bvdomain_free (mm, dv);
+          btor_hashint_map_get (btor->bv_var_domains, cur->id)->as_ptr =
+              btor_bvdomain_copy (mm, d);
+        }
+      }
+      else
+        btor_hashint_map_add (btor->bv_var_domains, cur->id)->as_ptr =
+            btor_bvdomain_copy (mm, d);
+      dv = get_stored (btor->bv_var_domains, cur);
+      for (j = 0; j < btor_bvdomain_get_width (dv); j++)
+        nfixed += btor_bvdomain_is_fixed_bit (dv, j);
+    }
+  }
+
+  btor_iter_hashint_init (&iit, ps.domains);
+  while (btor_iter_hashint_has_next (&iit))
+    btor_bvdomain_free (mm, btor_iter_hashint_next_data (&iit)->as_ptr);
+  btor_hashint_map_delete (ps.domains);
+  BTOR_RELEASE_STACK (nodes);
+  BTOR_RELEASE_STACK (roots);
+
+  btor->stats.bv_domain_fixed_var_bits = nfixed;
+  btor->time.bv_domain += btor_util_time_stamp () - start;
+  BTOR_MSG (btor->msg,
+            1,
+            "%u bv domain propagation rounds, %u fixed variable bits in %.1f "
+            "seconds",
+            rounds,
+            nfixed,
+            btor_util_time_stamp () - start);
+}
+
+/*------------------------------------------------------------------------*/
+
+static void
+clone_data_as_bvdomain_ptr (BtorMemMgr *mm,
+                            const void *map,
+                            BtorHashTableData *data,
+                            BtorHashTableData *cloned_data)
+{
+  assert (mm);
+  assert (data);
+  assert (cloned_data);
+
+  (void) map;
+  cloned_data->as_ptr = btor_bvdomain_copy (mm, (BtorBvDomain *) data->as_ptr);
+}
+
+BtorIntHashTable *
+btor_bvdomain_map_clone (BtorMemMgr *mm, BtorIntHashTable *map)
+{
+  assert (mm);
+  return btor_hashint_map_clone (mm, map, clone_data_as_bvdomain_ptr, 0);
+}
+
+void
+btor_bvdomain_map_delete (BtorMemMgr *mm, BtorIntHashTable *map)
+{
+  assert (mm);
+
+  BtorIntHashTableIterator it;
+
+  if (!map) return;
+  btor_iter_hashint_init (&it, map);
+  while (btor_iter_hashint_has_next (&it))
+    btor_bvdomain_free (mm, btor_iter_hashint_next_data (&it)->as_ptr);
+  btor_hashint_map_delete (map);
+}
@@ -0,0 +1,116 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORBVDOMAIN_H_INCLUDED
+#define BTORBVDOMAIN_H_INCLUDED
+
+#include "btorbv.h"
+#include "btortypes.h"
+#include "utils/btorhashint.h"
+#include "utils/btormem.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*------------------------------------------------------------------------*/
+
+/* Abstract domain of a bit-vector term (known bits and unsigned interval).
+ * Every value 'x' of the term satisfies
+ *
+ *   (x & lo) == lo, (x & ~hi) == 0 and min <= x <= max,
+ *
+ * i.e., a bit is fixed to 1 if it is set in 'lo', and fixed to 0 if it is
+ * not set in 'hi'. */
+struct BtorBvDomain
+{
+  BtorBitVector *lo;
+  BtorBitVector *hi;
+  BtorBitVector *min;
+  BtorBitVector *max;
+};
+
+typedef struct BtorBvDomain BtorBvDomain;
+
+/* Create new domain without any information (top). */
+BtorBvDomain *btor_bvdomain_new_init (BtorMemMgr *mm, uint32_t width);
+
+/* Create new domain that represents the given value only. */
+BtorBvDomain *btor_bvdomain_new_fixed (BtorMemMgr *mm, const BtorBitVector *bv);
+
+BtorBvDomain *btor_bvdomain_copy (BtorMemMgr *mm, const BtorBvDomain *d);
+
+void btor_bvdomain_free (BtorMemMgr *mm, BtorBvDomain *d);
+
+size_t btor_bvdomain_size (const BtorBvDomain *d);
+
+uint32_t btor_bvdomain_get_width (const BtorBvDomain *d);
+
+/* Create the domain of the bit-wise negation of the values in 'd'. */
+BtorBvDomain *btor_bvdomain_not (BtorMemMgr *mm, const BtorBvDomain *d);
+
+/* Restrict 'd' to the values in 'e'.  Returns false if the resulting domain
+ * is empty (in which case 'd' is left in an undefined state). */
+bool btor_bvdomain_meet (BtorMemMgr *mm, BtorBvDomain *d, const BtorBvDomain *e);
+
+/* Tighten the interval by the known bits and vice versa.  Returns false if
+ * the domain is empty. */
+bool btor_bvdomain_normalize (BtorMemMgr *mm, BtorBvDomain *d);
+
+bool btor_bvdomain_is_fixed (const BtorBvDomain *d);
+
+bool btor_bvdomain_is_fixed_bit (const BtorBvDomain *d, uint32_t pos);
+
+bool btor_bvdomain_is_fixed_bit_true (const BtorBvDomain *d, uint32_t pos);
+
+bool btor_bvdomain_is_fixed_bit_false (const BtorBvDomain *d, uint32_t pos);
+
+/* Returns true if 'd' represents all values of its width. */
+bool btor_bvdomain_is_init (const BtorBvDomain *d);
+
+/* Returns true if value 'bv' is in domain 'd'. */
+bool btor_bvdomain_contains (BtorMemMgr *mm,
+                             const BtorBvDomain *d,
+                             const BtorBitVector *bv);
+
+/* Returns a value in domain 'd' close to 'bv' (a copy of 'bv' if it is
+ * already contained in 'd'). */
+BtorBitVector *btor_bvdomain_clamp (BtorMemMgr *mm,
+                                    const BtorBvDomain *d,
+                                    const BtorBitVector *bv);
+
+/*------------------------------------------------------------------------*/
+
+/* Get the domain of 'exp' (may be inverted).  The returned domain is
+ * computed bottom-up from the structure of 'exp' only and thus holds
+ * independently of any constraint.  Domains of bit-vector operators are
+ * maintained in 'btor->bv_domains' and computed on node creation if
+ * BTOR_OPT_BV_DOMAIN is enabled (and lazily, otherwise). */
+BtorBvDomain *btor_bvdomain_get (Btor *btor, BtorNode *exp);
+
+/* Same as btor_bvdomain_get, but further restricts domains of bit-vector
+ * variables by the domains implied by the top level constraints (see
+ * btor_bvdomain_propagate). */
+BtorBvDomain *btor_bvdomain_get_constrained (Btor *btor, BtorNode *exp);
+
+/* Compute and store the domain of 'exp' (called on node creation). */
+void btor_bvdomain_compute (Btor *btor, BtorNode *exp);
+
+/* Remove the stored domains of 'exp' (called when 'exp' is erased). */
+void btor_bvdomain_remove (Btor *btor, BtorNode *exp);
+
+/* Propagate domains forward and backward over the top level constraints and
+ * store the resulting domains of bit-vector variables in
+ * 'btor->bv_var_domains'. */
+void btor_bvdomain_propagate (Btor *btor);
+
+/*------------------------------------------------------------------------*/
+
+BtorIntHashTable *btor_bvdomain_map_clone (BtorMemMgr *mm,
+                                           BtorIntHashTable *map);
+
+void btor_bvdomain_map_delete (BtorMemMgr *mm, BtorIntHashTable *map);
+
+#endif
@@ -235,13 +235,25 @@ chkclone_stats (Btor *btor, Btor *clone)
 #endif
 
   BTOR_CHKCLONE_STATS (max_rec_rw_calls);
+  BTOR_CHKCLONE_STATS (rw_rules_skipped);
   BTOR_CHKCLONE_STATS (var_substitutions);
   BTOR_CHKCLONE_STATS (uf_substitutions);
   BTOR_CHKCLONE_STATS (ec_substitutions);
+  BTOR_CHKCLONE_STATS (subst_visited);
+  BTOR_CHKCLONE_STATS (subst_rebuilt);
+  BTOR_CHKCLONE_STATS (subst_tables_updated);
   BTOR_CHKCLONE_STATS (linear_equations);
   BTOR_CHKCLONE_STATS (gaussian_eliminations);
+  BTOR_CHKCLONE_STATS (linear_systems);
+  BTOR_CHKCLONE_STATS (linear_system_elims);
   BTOR_CHKCLONE_STATS (eliminated_slices);
+  BTOR_CHKCLONE_STATS (reduced_width_vars);
+  BTOR_CHKCLONE_STATS (reduced_width_ops);
+  BTOR_CHKCLONE_STATS (sat_facts_units);
+  BTOR_CHKCLONE_STATS (sat_facts_equiv);
   BTOR_CHKCLONE_STATS (skeleton_constraints);
+  BTOR_CHKCLONE_STATS (extracted_lambdas);
+  BTOR_CHKCLONE_STATS (extracted_writes);
   BTOR_CHKCLONE_STATS (adds_normalized);
   BTOR_CHKCLONE_STATS (ands_normalized);
   BTOR_CHKCLONE_STATS (muls_normalized);
@@ -249,6 +261,7 @@ chkclone_stats (Btor *btor, Btor *clone)
   BTOR_CHKCLONE_STATS (ackermann_constraints);
   BTOR_CHKCLONE_STATS (bv_uc_props);
   BTOR_CHKCLONE_STATS (fun_uc_props);
+  BTOR_CHKCLONE_STATS (restored_uc_props);
   BTOR_CHKCLONE_STATS (lambdas_merged);
   BTOR_CHKCLONE_STATS (expressions);
   BTOR_CHKCLONE_STATS (clone_calls);
@@ -1092,9 +1105,18 @@ chkclone_slv (Btor *btor, Btor *clone)
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, dp_assumed_applies);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, dp_failed_eqs);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, dp_assumed_eqs);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, dp_clone_reuses);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, dp_reused_inputs);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, eval_exp_calls);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, propagations);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, propagations_down);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, components);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, component_checks);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, beta_cache_hits);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, beta_cache_misses);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, beta_cache_evictions);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, inc_check_kept);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, inc_check_invalidated);
   }
   else if (btor->slv->kind == BTOR_SLS_SOLVER_KIND)
   {
@@ -12,11 +12,13 @@
 #include "btoraigvec.h"
 #include "btorbeta.h"
 #include "btorbv.h"
+#include "btorbvdomain.h"
 #include "btorcore.h"
 #include "btorexp.h"
 #include "btorlog.h"
 #include "btormodel.h"
 #include "btormsg.h"
+#include "btorrewrite.h"
 #include "btorrwcache.h"
 #include "btorsat.h"
 #include "btorslvaigprop.h"
@@ -24,6 +26,7 @@
 #include "btorslvprop.h"
 #include "btorslvsls.h"
 #include "btorsort.h"
+#include "preprocess/btorunconstrained.h"
 #include "sat/btorlgl.h"
 #include "utils/btorhashint.h"
 #include "utils/btorhashptr.h"
@@ -262,6 +265,35 @@ btor_clone_data_as_bv_ptr_htable (BtorMemMgr *mm,
 
 /*------------------------------------------------------------------------*/
 
+static void
+clone_data_as_uc_def (BtorMemMgr *mm,
+                      const void *map,
+                      BtorHashTableData *data,
+                      BtorHashTableData *cloned_data)
+{
+  assert (mm);
+  assert (map);
+  assert (data);
+  assert (cloned_data);
+
+  uint32_t i;
+  BtorUCDef *def, *cdef;
+  BtorNodeMap *exp_map;
+
+  def     = (BtorUCDef *) data->as_ptr;
+  exp_map = (BtorNodeMap *) map;
+  BTOR_NEW (mm, cdef);
+  *cdef = *def;
+  for (i = 0; i < def->arity; i++)
+  {
+    cdef->e[i] = btor_nodemap_mapped (exp_map, def->e[i]);
+    assert (cdef->e[i]);
+  }
+  cloned_data->as_ptr = cdef;
+}
+
+/*------------------------------------------------------------------------*/
+
 static void
 clone_sorts_unique_table (Btor *btor, Btor *clone)
 {
@@ -938,11 +970,10 @@ clone_aux_btor (Btor *btor,
     clone->btor_sat_btor_called = 0;
     clone->last_sat_result      = 0;
     btor_reset_time (clone);
-#ifndef NDEBUG
     /* we need to explicitely reset the pointer to the table, since
      * it is the memcpy-ied pointer of btor->stats.rw_rules_applied */
     clone->stats.rw_rules_applied = 0;
-#endif
+    clone->rw_profile             = 0;
     btor_reset_stats (clone);
 #ifndef NDEBUG
     allocated += MEM_PTR_HASH_TABLE (clone->stats.rw_rules_applied);
@@ -1207,6 +1238,10 @@ clone_aux_btor (Btor *btor,
   assert ((allocated +=
            BTOR_SIZE_STACK (btor->failed_assumptions) * sizeof (BtorNode *))
           == clone->mm->allocated);
+  CLONE_PTR_HASH_TABLE_DATA (uc_defs, clone_data_as_uc_def);
+  assert ((allocated += MEM_PTR_HASH_TABLE (btor->uc_defs)
+                        + btor->uc_defs->count * sizeof (BtorUCDef))
+          == clone->mm->allocated);
 
   clone->assertions_cache =
       btor_hashint_table_clone (clone->mm, btor->assertions_cache);
@@ -1246,7 +1281,6 @@ clone_aux_btor (Btor *btor,
   }
   assert ((allocated += MEM_INT_HASH_MAP (btor->bv_model))
           == clone->mm->allocated);
-#ifndef NDEBUG
   if (!exp_layer_only && btor->stats.rw_rules_applied)
   {
     clone->stats.rw_rules_applied =
@@ -1258,8 +1292,10 @@ clone_aux_btor (Btor *btor,
                                   0);
     assert ((allocated += MEM_PTR_HASH_TABLE (btor->stats.rw_rules_applied))
             == clone->mm->allocated);
+    clone->rw_profile = btor_rewrite_profile_clone (mm, btor->rw_profile);
+    assert ((allocated += btor_rewrite_profile_size (btor->rw_profile))
+            == clone->mm->allocated);
   }
-#endif
   if (btor->fun_model)
   {
     clone->fun_model = btor_model_clone_fun (clone, btor->fun_model, false);
@@ -1286,6 +1322,26 @@ clone_aux_btor (Btor *btor,
   assert ((allocated += MEM_INT_HASH_MAP (btor->fun_model))
           == clone->mm->allocated);
 
+  clone->bv_domains     = btor_bvdomain_map_clone (mm, btor->bv_domains);
+  clone->bv_var_domains = btor_bvdomain_map_clone (mm, btor->bv_var_domains);
+#ifndef NDEBUG
+  if (btor->bv_domains)
+  {
+    btor_iter_hashint_init (&iit, btor->bv_domains);
+    while (btor_iter_hashint_has_next (&iit))
+      allocated += btor_bvdomain_size (btor_iter_hashint_next_data (&iit)->as_ptr);
+  }
+  if (btor->bv_var_domains)
+  {
+    btor_iter_hashint_init (&iit, btor->bv_var_domains);
+    while (btor_iter_hashint_has_next (&iit))
+      allocated += btor_bvdomain_size (btor_iter_hashint_next_data (&iit)->as_ptr);
+  }
+#endif
+  assert ((allocated += MEM_INT_HASH_MAP (btor->bv_domains)
+                        + MEM_INT_HASH_MAP (btor->bv_var_domains))
+          == clone->mm->allocated);
+
   /* NOTE: we need bv_model for cloning rhos */
   while (!BTOR_EMPTY_STACK (rhos))
   {
@@ -1422,6 +1478,13 @@ clone_aux_btor (Btor *btor,
       allocated += MEM_PTR_HASH_TABLE (slv->lemmas);
       allocated += BTOR_SIZE_STACK (slv->cur_lemmas) * sizeof (BtorNode *);
 
+      if (slv->abstractions)
+        allocated += MEM_PTR_HASH_TABLE (slv->abstractions);
+
+      if (slv->beta_cache)
+        allocated += MEM_PTR_HASH_TABLE (slv->beta_cache)
+                     + btor_beta_cache_entries_bytes (slv->beta_cache);
+
       if (slv->score)
       {
         h = btor_opt_get (btor, BTOR_OPT_FUN_JUST_HEURISTIC);
@@ -1857,6 +1920,9 @@ btor_clone_recursively_rebuild_exp (Btor *btor,
         case BTOR_ARGS_NODE:
           cur_clone = btor_exp_args (clone, e, cur->arity);
           break;
+        case BTOR_UPDATE_NODE:
+          cur_clone = btor_exp_update (clone, e[0], e[1], e[2]);
+          break;
         case BTOR_EXISTS_NODE:
           cur_clone = btor_exp_exists (clone, e[0], e[1]);
           break;
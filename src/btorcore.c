@@ -14,6 +14,8 @@
 #include <limits.h>
 
 #include "btorabort.h"
+#include "btoraigopt.h"
+#include "btorbvdomain.h"
 #ifndef NDEBUG
 #include "btorchkfailed.h"
 #include "btorchkmodel.h"
@@ -33,6 +35,7 @@
 #include "btorslvsls.h"
 #include "btorsubst.h"
 #include "preprocess/btorpreprocess.h"
+#include "preprocess/btorunconstrained.h"
 #include "preprocess/btorvarsubst.h"
 #include "utils/btorhashint.h"
 #include "utils/btornodeiter.h"
@@ -287,16 +290,14 @@ void
 btor_reset_stats (Btor *btor)
 {
   assert (btor);
-#ifndef NDEBUG
   if (btor->stats.rw_rules_applied)
     btor_hashptr_table_delete (btor->stats.rw_rules_applied);
-#endif
   BTOR_CLR (&btor->stats);
-#ifndef NDEBUG
+  btor_rewrite_profile_delete (btor->mm, btor->rw_profile);
+  btor->rw_profile = 0;
   assert (!btor->stats.rw_rules_applied);
   btor->stats.rw_rules_applied = btor_hashptr_table_new (
       btor->mm, (BtorHashPtr) btor_hash_str, (BtorCmpPtr) strcmp);
-#endif
 }
 
 static uint32_t
@@ -457,6 +458,10 @@ btor_print_stats (Btor *btor)
               1,
               "%5d unconstrained parameterized props",
               btor->stats.param_uc_props);
+    BTOR_MSG (btor->msg,
+              1,
+              "%5d unconstrained props restored",
+              btor->stats.restored_uc_props);
   }
   BTOR_MSG (btor->msg,
             1,
@@ -474,6 +479,18 @@ btor_print_stats (Btor *btor)
             1,
             "%5d synthesized nodes rewritten",
             btor->stats.rewrite_synth);
+  BTOR_MSG (btor->msg,
+            1,
+            "%5lld nodes visited in substitution passes",
+            btor->stats.subst_visited);
+  BTOR_MSG (btor->msg,
+            1,
+            "%5lld nodes rebuilt in substitution passes",
+            btor->stats.subst_rebuilt);
+  BTOR_MSG (btor->msg,
+            1,
+            "%5d node tables updated after substitution",
+            btor->stats.subst_tables_updated);
 
   BTOR_MSG (btor->msg,
             1,
@@ -483,14 +500,69 @@ btor_print_stats (Btor *btor)
             1,
             "%5d gaussian eliminations in linear equations",
             btor->stats.gaussian_eliminations);
+  if (btor_opt_get (btor, BTOR_OPT_SOLVE_LINEAR))
+  {
+    BTOR_MSG (btor->msg,
+              1,
+              "%5d solved linear systems",
+              btor->stats.linear_systems);
+    BTOR_MSG (btor->msg,
+              1,
+              "%5d variables eliminated in linear systems",
+              btor->stats.linear_system_elims);
+  }
   BTOR_MSG (btor->msg,
             1,
             "%5d eliminated sliced variables",
             btor->stats.eliminated_slices);
+  if (btor_opt_get (btor, BTOR_OPT_REDUCE_WIDTHS))
+  {
+    BTOR_MSG (btor->msg,
+              1,
+              "%5d reduced width variables",
+              btor->stats.reduced_width_vars);
+    BTOR_MSG (btor->msg,
+              1,
+              "%5d reduced width operations",
+              btor->stats.reduced_width_ops);
+  }
+  if (btor_opt_get (btor, BTOR_OPT_SAT_FACTS))
+  {
+    BTOR_MSG (btor->msg,
+              1,
+              "%5d imported SAT units",
+              btor->stats.sat_facts_units);
+    BTOR_MSG (btor->msg,
+              1,
+              "%5d imported SAT equivalences",
+              btor->stats.sat_facts_equiv);
+  }
   BTOR_MSG (btor->msg,
             1,
             "%5d extracted skeleton constraints",
             btor->stats.skeleton_constraints);
+  if (btor_opt_get (btor, BTOR_OPT_EXTRACT_LAMBDAS))
+  {
+    BTOR_MSG (btor->msg,
+              1,
+              "%5d lambdas extracted from writes",
+              btor->stats.extracted_lambdas);
+    BTOR_MSG (btor->msg,
+              1,
+              "%5d writes collapsed into extracted lambdas",
+              btor->stats.extracted_writes);
+  }
+  if (btor_opt_get (btor, BTOR_OPT_BV_DOMAIN))
+  {
+    BTOR_MSG (btor->msg,
+              1,
+              "%5d variable bits fixed by bv domains",
+              btor->stats.bv_domain_fixed_var_bits);
+    BTOR_MSG (btor->msg,
+              1,
+              "%5lld AIGs fixed by bv domains",
+              btor->stats.bv_domain_fixed_bits);
+  }
   BTOR_MSG (
       btor->msg, 1, "%5d and normalizations", btor->stats.ands_normalized);
   BTOR_MSG (
@@ -524,10 +596,13 @@ btor_print_stats (Btor *btor)
              + btor->rw_cache->cache->size * sizeof (BtorPtrHashBucket *))
                 / (double) (1 << 20));
 
-#ifndef NDEBUG
   BtorPtrHashTableIterator it;
   char *rule;
   int32_t num = 0;
+  BTOR_MSG (btor->msg,
+            1,
+            "  %lld rule predicates skipped by operand guards",
+            btor->stats.rw_rules_skipped);
   BTOR_MSG (btor->msg, 1, "applied rewriting rules:");
   if (btor->stats.rw_rules_applied->count == 0)
     BTOR_MSG (btor->msg, 1, "  none");
@@ -541,7 +616,10 @@ btor_print_stats (Btor *btor)
       BTOR_MSG (btor->msg, 1, "  %5d %s", num, rule);
     }
   }
-#endif
+  btor_rewrite_profile_print (btor);
+  if (btor_opt_get (btor, BTOR_OPT_RW_PROFILE) == BTOR_RW_PROFILE_DUMP)
+    btor_rewrite_profile_dump (btor, stdout);
+  btor_print_simp_pass_stats (btor);
 
   BTOR_MSG (btor->msg, 1, "");
   BTOR_MSG (btor->msg, 1, "bit blasting statistics:");
@@ -571,6 +649,21 @@ btor_print_stats (Btor *btor)
             1,
             "  %7lld CNF literals",
             btor->avmgr ? btor->avmgr->amgr->num_cnf_literals : 0);
+  if (btor_opt_get (btor, BTOR_OPT_AIG_OPT))
+  {
+    BTOR_MSG (btor->msg,
+              1,
+              "  %7lld AIG cut rewritings",
+              btor->avmgr ? btor->avmgr->amgr->num_aigopt_rewritten : 0);
+    BTOR_MSG (btor->msg,
+              1,
+              "  %7lld AIG refactorings",
+              btor->avmgr ? btor->avmgr->amgr->num_aigopt_refactored : 0);
+    BTOR_MSG (btor->msg,
+              1,
+              "  %7lld AIG balancings",
+              btor->avmgr ? btor->avmgr->amgr->num_aigopt_balanced : 0);
+  }
 
   if (btor->slv) btor->slv->api.print_stats (btor->slv);
 
@@ -581,6 +674,9 @@ btor_print_stats (Btor *btor)
             1,
             "%.2f seconds synthesize expressions",
             btor->time.synth_exp);
+  if (btor_opt_get (btor, BTOR_OPT_AIG_OPT))
+    BTOR_MSG (
+        btor->msg, 1, "%.2f seconds AIG optimization", btor->time.aigopt);
   BTOR_MSG (btor->msg,
             1,
             "%.2f seconds determining failed assumptions",
@@ -620,6 +716,27 @@ btor_print_stats (Btor *btor)
               btor->time.slicing,
               percent (btor->time.slicing, btor->time.simplify));
 
+  if (btor_opt_get (btor, BTOR_OPT_REDUCE_WIDTHS))
+    BTOR_MSG (btor->msg,
+              1,
+              "    %.2f seconds bit-width reduction (%.0f%%)",
+              btor->time.reduce_widths,
+              percent (btor->time.reduce_widths, btor->time.simplify));
+
+  if (btor_opt_get (btor, BTOR_OPT_SOLVE_LINEAR))
+    BTOR_MSG (btor->msg,
+              1,
+              "    %.2f seconds linear system solving (%.0f%%)",
+              btor->time.linear,
+              percent (btor->time.linear, btor->time.simplify));
+
+  if (btor_opt_get (btor, BTOR_OPT_SAT_FACTS))
+    BTOR_MSG (btor->msg,
+              1,
+              "    %.2f seconds SAT fact import (%.0f%%)",
+              btor->time.sat_facts,
+              percent (btor->time.sat_facts, btor->time.simplify));
+
 #ifndef BTOR_DO_NOT_PROCESS_SKELETON
   BTOR_MSG (btor->msg,
             1,
@@ -662,6 +779,13 @@ btor_print_stats (Btor *btor)
               btor->time.ack,
               percent (btor->time.ack, btor->time.simplify));
 
+  if (btor_opt_get (btor, BTOR_OPT_BV_DOMAIN))
+    BTOR_MSG (btor->msg,
+              1,
+              "    %.2f seconds bv domain propagation (%.0f%%)",
+              btor->time.bv_domain,
+              percent (btor->time.bv_domain, btor->time.simplify));
+
   if (btor->slv) btor->slv->api.print_time_stats (btor->slv);
 #endif
 
@@ -761,6 +885,10 @@ btor_new (void)
                               (BtorHashPtr) btor_node_hash_by_id,
                               (BtorCmpPtr) btor_node_compare_by_id);
   BTOR_INIT_STACK (mm, btor->failed_assumptions);
+  btor->uc_defs =
+      btor_hashptr_table_new (mm,
+                              (BtorHashPtr) btor_node_hash_by_id,
+                              (BtorCmpPtr) btor_node_compare_by_id);
   btor->parameterized =
       btor_hashptr_table_new (mm,
                               (BtorHashPtr) btor_node_hash_by_id,
@@ -770,10 +898,8 @@ btor_new (void)
   BTOR_INIT_STACK (mm, btor->assertions_trail);
   btor->assertions_cache = btor_hashint_table_new (mm);
 
-#ifndef NDEBUG
   btor->stats.rw_rules_applied = btor_hashptr_table_new (
       mm, (BtorHashPtr) btor_hash_str, (BtorCmpPtr) strcmp);
-#endif
 
   btor->true_exp = btor_exp_true (btor);
 
@@ -918,6 +1044,14 @@ btor_delete (Btor *btor)
 
   btor_delete_varsubst_constraints (btor);
 
+  btor_iter_hashptr_init (&it, btor->uc_defs);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    btor_delete_uc_def (btor, it.bucket->data.as_ptr);
+    btor_node_release (btor, btor_iter_hashptr_next (&it));
+  }
+  btor_hashptr_table_delete (btor->uc_defs);
+
   btor_iter_hashptr_init (&it, btor->inputs);
   btor_iter_hashptr_queue (&it, btor->embedded_constraints);
   btor_iter_hashptr_queue (&it, btor->unsynthesized_constraints);
@@ -1046,9 +1180,10 @@ btor_delete (Btor *btor)
   btor_hashptr_table_delete (btor->forall_vars);
   btor_hashptr_table_delete (btor->feqs);
   btor_hashptr_table_delete (btor->parameterized);
-#ifndef NDEBUG
+  btor_bvdomain_map_delete (mm, btor->bv_domains);
+  btor_bvdomain_map_delete (mm, btor->bv_var_domains);
   btor_hashptr_table_delete (btor->stats.rw_rules_applied);
-#endif
+  btor_rewrite_profile_delete (mm, btor->rw_profile);
 
   if (btor->avmgr) btor_aigvec_mgr_delete (btor->avmgr);
   btor_opt_delete_opts (btor);
@@ -1072,16 +1207,17 @@ btor_set_msg_prefix (Btor *btor, const char *prefix)
       prefix ? btor_mem_strdup (btor->mm, prefix) : (char *) prefix;
 }
 
-/* synthesizes unsynthesized constraints and updates constraints tables. */
+/* synthesizes unsynthesized constraint 'exp' and moves it to the table of
+ * synthesized constraints. */
 void
-btor_process_unsynthesized_constraints (Btor *btor)
+btor_process_unsynthesized_constraint (Btor *btor, BtorNode *exp)
 {
   assert (btor);
   assert (!btor->inconsistent);
+  assert (exp);
+  assert (btor_hashptr_table_get (btor->unsynthesized_constraints, exp));
 
   BtorPtrHashTable *uc, *sc;
-  BtorPtrHashBucket *bucket;
-  BtorNode *cur;
   BtorAIG *aig;
   BtorAIGMgr *amgr;
 
@@ -1089,6 +1225,43 @@ btor_process_unsynthesized_constraints (Btor *btor)
   sc   = btor->synthesized_constraints;
   amgr = btor_get_aig_mgr (btor);
 
+  if (!btor_hashptr_table_get (sc, exp))
+  {
+    aig = exp_to_aig (btor, exp);
+    if (aig == BTOR_AIG_FALSE)
+    {
+      btor->found_constraint_false = true;
+      return;
+    }
+    btor_aig_add_toplevel_to_sat (amgr, aig);
+    btor_aig_release (amgr, aig);
+    (void) btor_hashptr_table_add (sc, exp);
+    btor_hashptr_table_remove (uc, exp, 0, 0);
+
+    btor->stats.constraints.synthesized++;
+    report_constraint_stats (btor, false);
+  }
+  else
+  {
+    /* constraint is already in sc */
+    btor_hashptr_table_remove (uc, exp, 0, 0);
+    btor_node_release (btor, exp);
+  }
+}
+
+/* synthesizes unsynthesized constraints and updates constraints tables. */
+void
+btor_process_unsynthesized_constraints (Btor *btor)
+{
+  assert (btor);
+  assert (!btor->inconsistent);
+
+  BtorPtrHashTable *uc;
+  BtorPtrHashBucket *bucket;
+  BtorNode *cur;
+
+  uc = btor->unsynthesized_constraints;
+
   while (uc->count > 0)
   {
     bucket = uc->first;
@@ -1129,28 +1302,8 @@ btor_process_unsynthesized_constraints (Btor *btor)
 #endif
 #endif
 
-    if (!btor_hashptr_table_get (sc, cur))
-    {
-      aig = exp_to_aig (btor, cur);
-      if (aig == BTOR_AIG_FALSE)
-      {
-        btor->found_constraint_false = true;
-        break;
-      }
-      btor_aig_add_toplevel_to_sat (amgr, aig);
-      btor_aig_release (amgr, aig);
-      (void) btor_hashptr_table_add (sc, cur);
-      btor_hashptr_table_remove (uc, cur, 0, 0);
-
-      btor->stats.constraints.synthesized++;
-      report_constraint_stats (btor, false);
-    }
-    else
-    {
-      /* constraint is already in sc */
-      btor_hashptr_table_remove (uc, cur, 0, 0);
-      btor_node_release (btor, cur);
-    }
+    btor_process_unsynthesized_constraint (btor, cur);
+    if (btor->found_constraint_false) break;
   }
 }
 
@@ -2469,6 +2622,86 @@ btor_substitute_node (Btor *btor,
 
 /*------------------------------------------------------------------------*/
 
+/* Replace the AIGs of bits of 'exp' that are fixed in its bv domain by
+ * constant AIGs. */
+static void
+fix_aigvec_by_domain (Btor *btor, BtorNode *exp)
+{
+  assert (btor);
+  assert (exp);
+  assert (btor_node_is_regular (exp));
+  assert (exp->av);
+
+  uint32_t i, width;
+  BtorAIGMgr *amgr;
+  BtorAIG *aig;
+  BtorBvDomain *d;
+
+  amgr  = btor_get_aig_mgr (btor);
+  width = exp->av->width;
+  d     = btor_bvdomain_get_constrained (btor, exp);
+  assert (btor_bvdomain_get_width (d) == width);
+  for (i = 0; i < width; i++)
+  {
+    aig = exp->av->aigs[i];
+    if (btor_aig_is_const (aig)) continue;
+    /* aigs[0] is the most significant bit */
+    if (btor_bvdomain_is_fixed_bit_true (d, width - 1 - i))
+      exp->av->aigs[i] = BTOR_AIG_TRUE;
+    else if (btor_bvdomain_is_fixed_bit_false (d, width - 1 - i))
+      exp->av->aigs[i] = BTOR_AIG_FALSE;
+    else
+      continue;
+    btor_aig_release (amgr, aig);
+    btor->stats.bv_domain_fixed_bits += 1;
+  }
+  btor_bvdomain_free (btor->mm, d);
+}
+
+/* Optimize the AIGs of given (newly synthesized) expressions prior to
+ * encoding them to SAT. */
+static void
+optimize_aigvecs (Btor *btor, BtorNodePtrStack *nodes)
+{
+  assert (btor);
+  assert (nodes);
+
+  uint32_t i, j;
+  double start, limit, deadline;
+  BtorNode *cur;
+  BtorAIGPtrStack aigs;
+
+  limit = btor_opt_get (btor, BTOR_OPT_AIG_OPT_TIME_LIMIT) / 1000.0;
+  if (limit > 0 && btor->time.aigopt >= limit) return;
+
+  start    = btor_util_time_stamp ();
+  deadline = limit > 0 ? start + limit - btor->time.aigopt : 0;
+
+  BTOR_INIT_STACK (btor->mm, aigs);
+  for (i = 0; i < BTOR_COUNT_STACK (*nodes); i++)
+  {
+    cur = BTOR_PEEK_STACK (*nodes, i);
+    for (j = 0; j < cur->av->width; j++)
+      BTOR_PUSH_STACK (aigs, cur->av->aigs[j]);
+  }
+
+  btor_aigopt_optimize (btor_get_aig_mgr (btor),
+                        aigs.start,
+                        BTOR_COUNT_STACK (aigs),
+                        deadline);
+
+  /* optimized AIGs replace the original AIGs */
+  aigs.top = aigs.start;
+  for (i = 0; i < BTOR_COUNT_STACK (*nodes); i++)
+  {
+    cur = BTOR_PEEK_STACK (*nodes, i);
+    for (j = 0; j < cur->av->width; j++) cur->av->aigs[j] = *aigs.top++;
+  }
+  BTOR_RELEASE_STACK (aigs);
+
+  btor->time.aigopt += btor_util_time_stamp () - start;
+}
+
 /* bit vector skeleton is always encoded, i.e., if btor_node_is_synth is true,
  * then it is also encoded. with option lazy_synthesize enabled,
  * 'btor_synthesize_exp' stops at feq and apply nodes */
@@ -2477,7 +2710,7 @@ btor_synthesize_exp (Btor *btor,
                      BtorNode *exp,
                      BtorPtrHashTable *backannotation)
 {
-  BtorNodePtrStack exp_stack;
+  BtorNodePtrStack exp_stack, synthesized;
   BtorNode *cur, *value, *args;
   BtorAIGVec *av0, *av1, *av2;
   BtorMemMgr *mm;
@@ -2493,20 +2726,24 @@ btor_synthesize_exp (Btor *btor,
   bool invert_av1 = false;
   bool invert_av2 = false;
   double start;
-  bool restart, opt_lazy_synth;
+  bool restart, opt_lazy_synth, opt_aig_opt, opt_fun_abstract, opt_bv_domain;
   BtorIntHashTable *cache;
 
   assert (btor);
   assert (exp);
 
-  start          = btor_util_time_stamp ();
-  mm             = btor->mm;
-  avmgr          = btor->avmgr;
-  count          = 0;
-  cache          = btor_hashint_table_new (mm);
-  opt_lazy_synth = btor_opt_get (btor, BTOR_OPT_FUN_LAZY_SYNTHESIZE) == 1;
+  start            = btor_util_time_stamp ();
+  mm               = btor->mm;
+  avmgr            = btor->avmgr;
+  count            = 0;
+  cache            = btor_hashint_table_new (mm);
+  opt_lazy_synth   = btor_opt_get (btor, BTOR_OPT_FUN_LAZY_SYNTHESIZE) == 1;
+  opt_aig_opt      = btor_opt_get (btor, BTOR_OPT_AIG_OPT) == 1;
+  opt_fun_abstract = btor_opt_get (btor, BTOR_OPT_FUN_ABSTRACT) == 1;
+  opt_bv_domain    = btor_opt_get (btor, BTOR_OPT_BV_DOMAIN) == 1;
 
   BTOR_INIT_STACK (mm, exp_stack);
+  BTOR_INIT_STACK (mm, synthesized);
   BTOR_PUSH_STACK (exp_stack, exp);
   BTORLOG (2, "%s: %s", __FUNCTION__, btor_util_node2string (exp));
 
@@ -2534,6 +2771,9 @@ btor_synthesize_exp (Btor *btor,
       {
         assert (!cur->parameterized);
         cur->av = btor_aigvec_var (avmgr, btor_node_bv_get_width (btor, cur));
+        /* bits of variables may be fixed by the top level constraints */
+        if (opt_bv_domain && !backannotation && btor_node_is_bv_var (cur))
+          fix_aigvec_by_domain (btor, cur);
 
         if (btor_node_is_bv_var (cur) && backannotation
             && (name = btor_node_get_symbol (btor, cur)))
@@ -2660,6 +2900,8 @@ btor_synthesize_exp (Btor *btor,
           av1        = btor_node_real_addr (cur->e[1])->av;
           if (invert_av1) btor_aigvec_invert (avmgr, av1);
         }
+        /* multipliers and dividers may be abstracted by the fun solver */
+        if (opt_fun_abstract) cur->av = btor_fun_abstract_exp (btor, cur);
         switch (cur->kind)
         {
           case BTOR_BV_AND_NODE:
@@ -2672,7 +2914,7 @@ btor_synthesize_exp (Btor *btor,
             cur->av = btor_aigvec_add (avmgr, av0, av1);
             break;
           case BTOR_BV_MUL_NODE:
-            cur->av = btor_aigvec_mul (avmgr, av0, av1);
+            if (!cur->av) cur->av = btor_aigvec_mul (avmgr, av0, av1);
             break;
           case BTOR_BV_ULT_NODE:
             cur->av = btor_aigvec_ult (avmgr, av0, av1);
@@ -2684,10 +2926,10 @@ btor_synthesize_exp (Btor *btor,
             cur->av = btor_aigvec_srl (avmgr, av0, av1);
             break;
           case BTOR_BV_UDIV_NODE:
-            cur->av = btor_aigvec_udiv (avmgr, av0, av1);
+            if (!cur->av) cur->av = btor_aigvec_udiv (avmgr, av0, av1);
             break;
           case BTOR_BV_UREM_NODE:
-            cur->av = btor_aigvec_urem (avmgr, av0, av1);
+            if (!cur->av) cur->av = btor_aigvec_urem (avmgr, av0, av1);
             break;
           default:
             assert (cur->kind == BTOR_BV_CONCAT_NODE);
@@ -2705,7 +2947,8 @@ btor_synthesize_exp (Btor *btor,
           if (invert_av0) btor_aigvec_invert (avmgr, av0);
           if (invert_av1) btor_aigvec_invert (avmgr, av1);
         }
-        if (!opt_lazy_synth) btor_aigvec_to_sat_tseitin (avmgr, cur->av);
+        if (!opt_lazy_synth && !opt_aig_opt)
+          btor_aigvec_to_sat_tseitin (avmgr, cur->av);
       }
       else
       {
@@ -2753,11 +2996,24 @@ btor_synthesize_exp (Btor *btor,
         }
       }
       assert (cur->av);
+      if (opt_bv_domain) fix_aigvec_by_domain (btor, cur);
       BTORLOG (2, "  synthesized: %s", btor_util_node2string (cur));
-      btor_aigvec_to_sat_tseitin (avmgr, cur->av);
+      /* encoding is postponed until AIGs are optimized */
+      if (opt_aig_opt)
+        BTOR_PUSH_STACK (synthesized, cur);
+      else
+        btor_aigvec_to_sat_tseitin (avmgr, cur->av);
     }
   }
   BTOR_RELEASE_STACK (exp_stack);
+
+  if (!BTOR_EMPTY_STACK (synthesized))
+  {
+    optimize_aigvecs (btor, &synthesized);
+    for (i = 0; i < BTOR_COUNT_STACK (synthesized); i++)
+      btor_aigvec_to_sat_tseitin (avmgr, BTOR_PEEK_STACK (synthesized, i)->av);
+  }
+  BTOR_RELEASE_STACK (synthesized);
   btor_hashint_table_delete (cache);
 
   if (count > 0 && btor_opt_get (btor, BTOR_OPT_VERBOSITY) > 3)
@@ -3069,7 +3325,10 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
 
   if (chkmodel)
   {
-    if (res == BTOR_RESULT_SAT && !btor_opt_get (btor, BTOR_OPT_UCOPT))
+    if (res == BTOR_RESULT_SAT
+        && (!btor_opt_get (btor, BTOR_OPT_UCOPT)
+            || btor_opt_get (btor, BTOR_OPT_MODEL_GEN)
+            || btor_opt_get (btor, BTOR_OPT_INCREMENTAL)))
     {
       btor_check_model (chkmodel);
     }
@@ -61,6 +61,35 @@ struct BtorNodeUniqueTable
 
 typedef struct BtorNodeUniqueTable BtorNodeUniqueTable;
 
+/* Optional passes of the simplifier, scheduled by btor_simplify (see
+ * BTOR_OPT_SIMP_ADAPTIVE and BTOR_OPT_SIMP_PASS_TIME_LIMIT). */
+enum BtorSimpPass
+{
+  BTOR_SIMP_PASS_ELIMINATE_SLICES,
+  BTOR_SIMP_PASS_REDUCE_WIDTHS,
+  BTOR_SIMP_PASS_SKELETON,
+  BTOR_SIMP_PASS_SOLVE_LINEAR,
+  BTOR_SIMP_PASS_UCOPT,
+  BTOR_SIMP_PASS_EXTRACT_LAMBDAS,
+  BTOR_SIMP_PASS_MERGE_LAMBDAS,
+  BTOR_SIMP_PASS_NORMALIZE_ADDS,
+  BTOR_SIMP_PASS_NUM,
+};
+
+typedef enum BtorSimpPass BtorSimpPass;
+
+struct BtorSimpPassStats
+{
+  uint32_t runs;         /* number of runs */
+  uint32_t skipped;      /* number of deferred or over budget runs */
+  uint32_t backoff;      /* runs to defer after next unproductive run */
+  uint32_t delay;        /* remaining runs to defer */
+  int_least64_t removed; /* number of nodes removed */
+  double time;
+};
+
+typedef struct BtorSimpPassStats BtorSimpPassStats;
+
 struct BtorCallbacks
 {
   struct
@@ -121,12 +150,20 @@ struct Btor
 
   BtorIntHashTable *bv_model;
   BtorIntHashTable *fun_model;
+
+  /* known-bits and interval domains (see btorbvdomain.h) */
+  BtorIntHashTable *bv_domains;     /* bv operators, structural */
+  BtorIntHashTable *bv_var_domains; /* bv variables, implied by constraints */
   BtorNodePtrStack functions_with_model;
   BtorNodePtrStack outputs; /* used to synthesize BTOR2 outputs */
 
   uint32_t rec_rw_calls; /* calls for recursive rewriting */
   uint32_t valid_assignments;
   BtorRwCache *rw_cache;
+  struct BtorRwProfile *rw_profile; /* see BTOR_OPT_RW_PROFILE */
+  /* yield and scheduling state of simplification passes, kept across
+   * incremental calls (see btor_simplify) */
+  BtorSimpPassStats simp_passes[BTOR_SIMP_PASS_NUM];
 
   int32_t vis_idx; /* file index for visualizing expressions */
 
@@ -151,6 +188,10 @@ struct Btor
    * this stack is needed for boolector_get_failed_assumptions only */
   BtorNodePtrStack failed_assumptions;
 
+  /* maps variables introduced by unconstrained optimization to the
+   * definitions they replace (see btorunconstrained.h) */
+  BtorPtrHashTable *uc_defs;
+
   /* maintain assertions for different contexts push/pop */
   BtorNodePtrStack assertions;
   /* caches the assertions on stack 'assertions' */
@@ -186,19 +227,33 @@ struct Btor
     uint32_t var_substitutions; /* number substituted vars */
     uint32_t uf_substitutions;  /* num substituted uninterpreted functions */
     uint32_t ec_substitutions;  /* embedded constraint substitutions */
+    uint_least64_t subst_visited; /* nodes visited in substitution passes */
+    uint_least64_t subst_rebuilt; /* nodes replaced in substitution passes */
+    uint32_t subst_tables_updated; /* node tables updated after substitution */
     uint32_t linear_equations;  /* number of linear equations */
     uint32_t gaussian_eliminations; /* number of gaussian eliminations */
+    uint32_t linear_systems;        /* number of solved linear systems */
+    uint32_t linear_system_elims;   /* vars eliminated in linear systems */
     uint32_t eliminated_slices;     /* number of eliminated slices */
+    uint32_t reduced_width_vars;    /* number of reduced width variables */
+    uint32_t reduced_width_ops;     /* number of reduced width operations */
+    uint32_t sat_facts_units;       /* number of imported SAT units */
+    uint32_t sat_facts_equiv;       /* number of imported SAT equivalences */
     uint32_t skeleton_constraints;  /* number of skeleton constraints */
+    uint32_t extracted_lambdas;     /* lambdas extracted from writes */
+    uint32_t extracted_writes;      /* writes collapsed into lambdas */
     uint32_t adds_normalized;       /* number of add chains normalizations */
     uint32_t ands_normalized;       /* number of and chains normalizations */
     uint32_t muls_normalized;       /* number of mul chains normalizations */
     uint32_t ackermann_constraints;
+    uint32_t bv_domain_fixed_var_bits; /* var bits fixed by bv domains */
+    uint_least64_t bv_domain_fixed_bits;  /* AIGs fixed by bv domains */
     uint_least64_t prop_apply_lambda; /* number of static props over lambdas */
     uint_least64_t prop_apply_update; /* number of static props over updates */
     uint32_t bv_uc_props;
     uint32_t fun_uc_props;
     uint32_t param_uc_props;
+    uint32_t restored_uc_props;
     uint_least64_t lambdas_merged;
     BtorConstraintStats constraints;
     BtorConstraintStats oldconstraints;
@@ -207,9 +262,8 @@ struct Btor
     size_t node_bytes_alloc;
     uint_least64_t beta_reduce_calls;
     uint_least64_t betap_reduce_calls;
-#ifndef NDEBUG
     BtorPtrHashTable *rw_rules_applied;
-#endif
+    uint_least64_t rw_rules_skipped; /* rule predicates skipped by guards */
     uint_least64_t rewrite_synth;
   } stats;
 
@@ -222,6 +276,9 @@ struct Btor
     double elimapplies;
     double embedded;
     double slicing;
+    double reduce_widths;
+    double linear;
+    double sat_facts;
     double skel;
     double propagate;
     double beta;
@@ -229,6 +286,8 @@ struct Btor
     double failed;
     double cloning;
     double synth_exp;
+    double aigopt;
+    double bv_domain;
     double model_gen;
     double ucopt;
     double merge;
@@ -358,6 +417,7 @@ BtorNode *btor_substitute_nodes_node_map (Btor *btor,
 void btor_reset_incremental_usage (Btor *btor);
 void btor_add_again_assumptions (Btor *btor);
 void btor_process_unsynthesized_constraints (Btor *btor);
+void btor_process_unsynthesized_constraint (Btor *btor, BtorNode *exp);
 void btor_insert_unsynthesized_constraint (Btor *btor, BtorNode *constraint);
 void btor_set_simplified_exp (Btor *btor, BtorNode *exp, BtorNode *simplified);
 void btor_delete_varsubst_constraints (Btor *btor);
@@ -2836,23 +2836,8 @@ btormbt_state_opt (BtorMBT *mbt)
     }
 
     /* avoid invalid option combinations */
-    // FIXME remove as soon as ucopt works with mgen
-    /* do not enable unconstrained optimization if either model
-     * generation or incremental is enabled */
-    if (btoropt->kind == BTOR_OPT_UCOPT
-        && (boolector_get_opt (mbt->btor, BTOR_OPT_MODEL_GEN)
-            || boolector_get_opt (mbt->btor, BTOR_OPT_INCREMENTAL)))
-    {
-      continue;
-    }
-    else if ((btoropt->kind == BTOR_OPT_MODEL_GEN
-              || btoropt->kind == BTOR_OPT_INCREMENTAL)
-             && boolector_get_opt (mbt->btor, BTOR_OPT_UCOPT))
-    {
-      continue;
-    }
     /* do not enable justification if dual propagation is enabled */
-    else if (btoropt->kind == BTOR_OPT_FUN_JUST
+    if (btoropt->kind == BTOR_OPT_FUN_JUST
              && boolector_get_opt (mbt->btor, BTOR_OPT_FUN_DUAL_PROP))
     {
       continue;
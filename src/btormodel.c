@@ -13,6 +13,7 @@
 #include "btorclone.h"
 #include "btordbg.h"
 #include "btorlog.h"
+#include "preprocess/btorunconstrained.h"
 #include "utils/btorhashint.h"
 #include "utils/btorhashptr.h"
 #include "utils/btormem.h"
@@ -126,7 +127,7 @@ btor_model_remove_from_bv (Btor *btor,
   btor_node_release (btor, exp);
   if (btor_hashint_map_contains (bv_model, -id))
   {
-    btor_hashint_map_remove (bv_model, id, &d);
+    btor_hashint_map_remove (bv_model, -id, &d);
     btor_bv_free (btor->mm, d.as_ptr);
     btor_node_release (btor, exp);
   }
@@ -1287,6 +1288,10 @@ btor_model_generate (Btor *btor,
   compute_model_values (
       btor, bv_model, fun_model, nodes.start, BTOR_COUNT_STACK (nodes));
 
+  /* assign inputs eliminated by unconstrained optimization */
+  if (btor->uc_defs->count)
+    btor_reconstruct_unconstrained (btor, bv_model, fun_model);
+
   while (!BTOR_EMPTY_STACK (nodes))
     btor_node_release (btor, BTOR_POP_STACK (nodes));
   BTOR_RELEASE_STACK (nodes);
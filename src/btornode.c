@@ -15,6 +15,7 @@
 #include "btoraig.h"
 #include "btoraigvec.h"
 #include "btorbeta.h"
+#include "btorbvdomain.h"
 #include "btordbg.h"
 #include "btorexp.h"
 #include "btorlog.h"
@@ -866,6 +867,7 @@ erase_local_data_exp (Btor *btor, BtorNode *exp)
     btor_aigvec_release_delete (btor->avmgr, exp->av);
     exp->av = 0;
   }
+  btor_bvdomain_remove (btor, exp);
   exp->erased = 1;
 }
 
@@ -1897,6 +1899,8 @@ new_slice_exp_node (Btor *btor, BtorNode *e0, uint32_t upper, uint32_t lower)
                          btor_sort_bv (btor, upper - lower + 1));
   setup_node_and_add_to_id_table (btor, exp);
   connect_child_exp (btor, (BtorNode *) exp, e0, 0);
+  if (btor_opt_get (btor, BTOR_OPT_BV_DOMAIN))
+    btor_bvdomain_compute (btor, (BtorNode *) exp);
   return (BtorNode *) exp;
 }
 
@@ -2155,6 +2159,8 @@ new_node (Btor *btor, BtorNodeKind kind, uint32_t arity, BtorNode *e[])
     assert (!btor_hashptr_table_get (btor->feqs, exp));
     btor_hashptr_table_add (btor->feqs, exp)->data.as_int = 0;
   }
+  else if (btor_opt_get (btor, BTOR_OPT_BV_DOMAIN))
+    btor_bvdomain_compute (btor, (BtorNode *) exp);
 
   return (BtorNode *) exp;
 }
@@ -415,6 +415,30 @@ btor_opt_init_opts (Btor *btor)
             0,
             3,
             "rewrite level");
+  init_opt (btor,
+            BTOR_OPT_RW_PROFILE,
+            false,
+            false,
+            "rw-profile",
+            0,
+            BTOR_RW_PROFILE_DFLT,
+            BTOR_RW_PROFILE_MIN,
+            BTOR_RW_PROFILE_MAX,
+            "profile rewrite rules");
+  opts = btor_hashptr_table_new (
+      btor->mm, (BtorHashPtr) btor_hash_str, (BtorCmpPtr) strcmpoptval);
+  add_opt_help (mm, opts, "none", BTOR_RW_PROFILE_NONE, "no profiling");
+  add_opt_help (mm,
+                opts,
+                "stats",
+                BTOR_RW_PROFILE_STATS,
+                "report rule profile in statistics");
+  add_opt_help (mm,
+                opts,
+                "dump",
+                BTOR_RW_PROFILE_DUMP,
+                "additionally print machine-readable rule profile");
+  btor->options[BTOR_OPT_RW_PROFILE].options = opts;
   init_opt (btor,
             BTOR_OPT_SKELETON_PREPROC,
             false,
@@ -435,6 +459,30 @@ btor_opt_init_opts (Btor *btor)
             0,
             1,
             "add ackermann constraints");
+  init_opt (btor,
+            BTOR_OPT_ACKERMANN_PAIRS,
+            false,
+            false,
+            "ackermann-pairs",
+            0,
+            BTOR_ACKERMANN_PAIRS_DFLT,
+            BTOR_ACKERMANN_PAIRS_MIN,
+            BTOR_ACKERMANN_PAIRS_MAX,
+            "pairs of applies with eager ackermann constraints");
+  opts = btor_hashptr_table_new (
+      btor->mm, (BtorHashPtr) btor_hash_str, (BtorCmpPtr) strcmpoptval);
+  add_opt_help (mm,
+                opts,
+                "all",
+                BTOR_ACKERMANN_PAIRS_ALL,
+                "all pairs of applies of a function");
+  add_opt_help (mm,
+                opts,
+                "shared",
+                BTOR_ACKERMANN_PAIRS_SHARED,
+                "pairs with shared argument subterms, all other "
+                "instances are added lazily as lemmas");
+  btor->options[BTOR_OPT_ACKERMANN_PAIRS].options = opts;
   init_opt (btor,
             BTOR_OPT_BETA_REDUCE,
             false,
@@ -467,6 +515,57 @@ btor_opt_init_opts (Btor *btor)
             0,
             1,
             "eliminate slices on variables");
+  init_opt (btor,
+            BTOR_OPT_REDUCE_WIDTHS,
+            false,
+            true,
+            "reduce-widths",
+            0,
+            0,
+            0,
+            1,
+            "reduce bit-width of variables and operations");
+  init_opt (btor,
+            BTOR_OPT_SOLVE_LINEAR,
+            false,
+            true,
+            "solve-linear",
+            0,
+            0,
+            0,
+            1,
+            "solve systems of linear equations modulo 2^width");
+  init_opt (btor,
+            BTOR_OPT_SAT_FACTS,
+            false,
+            true,
+            "sat-facts",
+            0,
+            0,
+            0,
+            1,
+            "import SAT solver units and equivalences in incremental mode");
+  init_opt (btor,
+            BTOR_OPT_SIMP_ADAPTIVE,
+            false,
+            true,
+            "simp-adaptive",
+            0,
+            0,
+            0,
+            1,
+            "defer unproductive simplification passes");
+  init_opt (btor,
+            BTOR_OPT_SIMP_PASS_TIME_LIMIT,
+            false,
+            false,
+            "simp-pass-time-limit",
+            0,
+            0,
+            0,
+            UINT32_MAX,
+            "time limit per simplification pass and call in ms "
+            "(0 for no limit)");
   init_opt (btor,
             BTOR_OPT_VAR_SUBST,
             false,
@@ -527,6 +626,37 @@ btor_opt_init_opts (Btor *btor)
             0,
             1,
             "normalize add/mul/and operators");
+  init_opt (btor,
+            BTOR_OPT_AIG_OPT,
+            false,
+            true,
+            "aig-opt",
+            0,
+            0,
+            0,
+            1,
+            "optimize AIGs (rewriting, refactoring, balancing) prior to "
+            "CNF encoding");
+  init_opt (btor,
+            BTOR_OPT_AIG_OPT_TIME_LIMIT,
+            false,
+            false,
+            "aig-opt-time-limit",
+            0,
+            10000,
+            0,
+            UINT32_MAX,
+            "time limit for AIG optimization in ms (0 for no limit)");
+  init_opt (btor,
+            BTOR_OPT_BV_DOMAIN,
+            false,
+            true,
+            "bv-domain",
+            0,
+            0,
+            0,
+            1,
+            "known-bits and interval analysis of bit-vector terms");
 
   /* FUN engine ---------------------------------------------------------- */
   init_opt (btor,
@@ -668,6 +798,58 @@ btor_opt_init_opts (Btor *btor)
                 "generate lemmas for all conflicts");
   btor->options[BTOR_OPT_FUN_EAGER_LEMMAS].options  = opts;
 
+  init_opt (btor,
+            BTOR_OPT_FUN_ABSTRACT,
+            false,
+            true,
+            "fun-abstract",
+            "fun-abs",
+            0,
+            0,
+            1,
+            "lazily bit-blast multipliers and dividers "
+            "(counterexample-guided abstraction refinement)");
+  init_opt (btor,
+            BTOR_OPT_FUN_ABSTRACT_WIDTH,
+            false,
+            false,
+            "fun-abstract-width",
+            0,
+            8,
+            2,
+            UINT32_MAX,
+            "minimum bit-width of abstracted multipliers and dividers");
+  init_opt (btor,
+            BTOR_OPT_FUN_DECOMPOSE,
+            false,
+            true,
+            "fun-decompose",
+            0,
+            0,
+            0,
+            1,
+            "solve independent components of the formula one at a time");
+  init_opt (btor,
+            BTOR_OPT_FUN_BETA_CACHE,
+            false,
+            true,
+            "fun-beta-cache",
+            0,
+            1,
+            0,
+            1,
+            "cache partial beta reduction results across refinements");
+  init_opt (btor,
+            BTOR_OPT_FUN_INC_CHECK,
+            false,
+            true,
+            "fun-inc-check",
+            0,
+            1,
+            0,
+            1,
+            "keep model assignments across refinements if unchanged");
+
   init_opt (btor,
             BTOR_OPT_FUN_STORE_LAMBDAS,
             false,
@@ -1614,27 +1796,6 @@ btor_opt_set (Btor *btor, const BtorOption opt, uint32_t val)
   else if (opt == BTOR_OPT_MODEL_GEN)
   {
     if (!val && btor_opt_get (btor, opt)) btor_model_delete (btor);
-    if (val && btor_opt_get (btor, BTOR_OPT_UCOPT))
-    {
-      btor_opt_set (btor, BTOR_OPT_UCOPT, 0);
-      BTOR_MSG (btor->msg,
-                1,
-                "Disabling unconstrained optimization since model generation "
-                "is enabled");
-    }
-    assert (!val || !btor_opt_get (btor, BTOR_OPT_UCOPT));
-  }
-  else if (opt == BTOR_OPT_UCOPT)
-  {
-    if (val && btor_opt_get (btor, BTOR_OPT_MODEL_GEN))
-    {
-      BTOR_MSG (btor->msg,
-                1,
-                "Disabling unconstrained optimization since model generation "
-                "is enabled");
-      val = 0;
-    }
-    assert (!val || !btor_opt_get (btor, BTOR_OPT_INCREMENTAL));
   }
   else if (opt == BTOR_OPT_SAT_ENGINE)
   {
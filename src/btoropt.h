@@ -127,6 +127,14 @@ extern const char *const g_btor_se_name[BTOR_SAT_ENGINE_MAX + 1];
 #define BTOR_BETA_REDUCE_MAX BTOR_BETA_REDUCE_ALL
 #define BTOR_BETA_REDUCE_DFLT BTOR_BETA_REDUCE_NONE
 
+#define BTOR_ACKERMANN_PAIRS_MIN BTOR_ACKERMANN_PAIRS_ALL
+#define BTOR_ACKERMANN_PAIRS_MAX BTOR_ACKERMANN_PAIRS_SHARED
+#define BTOR_ACKERMANN_PAIRS_DFLT BTOR_ACKERMANN_PAIRS_ALL
+
+#define BTOR_RW_PROFILE_MIN BTOR_RW_PROFILE_NONE
+#define BTOR_RW_PROFILE_MAX BTOR_RW_PROFILE_DUMP
+#define BTOR_RW_PROFILE_DFLT BTOR_RW_PROFILE_NONE
+
 /*------------------------------------------------------------------------*/
 
 void btor_opt_init_opts (Btor *btor);
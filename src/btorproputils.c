@@ -8,6 +8,7 @@
 
 #include "btorproputils.h"
 
+#include "btorbvdomain.h"
 #include "btorprintmodel.h"
 #include "btorslsutils.h"
 #include "utils/btornodeiter.h"
@@ -3496,11 +3497,12 @@ btor_proputils_select_move_prop (Btor *btor,
   assert (btor_bv_to_uint64 ((BtorBitVector *) btor_model_get_bv (btor, root))
           == 0);
 
-  bool b;
+  bool b, opt_bv_domain;
   int32_t i, nconst;
   uint64_t nprops;
   BtorNode *cur, *real_cur;
   BtorBitVector *bve[3], *bvcur, *bvenew, *tmp;
+  BtorBvDomain *dom;
   int32_t (*select_path) (
       Btor *, BtorNode *, BtorBitVector *, BtorBitVector **);
   BtorBitVector *(*compute_value) (
@@ -3509,9 +3511,10 @@ btor_proputils_select_move_prop (Btor *btor,
   char *a;
 #endif
 
-  *input      = 0;
-  *assignment = 0;
-  nprops      = 0;
+  *input        = 0;
+  *assignment   = 0;
+  nprops        = 0;
+  opt_bv_domain = btor_opt_get (btor, BTOR_OPT_BV_DOMAIN) == 1;
 
   cur   = root;
   bvcur = btor_bv_one (btor->mm, 1);
@@ -3622,6 +3625,19 @@ btor_proputils_select_move_prop (Btor *btor,
           btor, real_cur, bvcur, bve, select_path, compute_value, &bvenew);
       if (!bvenew) break; /* non-recoverable conflict */
 
+      /* move value into the domain of the selected child */
+      if (opt_bv_domain)
+      {
+        dom = btor_bvdomain_get_constrained (btor, cur);
+        if (!btor_bvdomain_contains (btor->mm, dom, bvenew))
+        {
+          tmp    = bvenew;
+          bvenew = btor_bvdomain_clamp (btor->mm, dom, tmp);
+          btor_bv_free (btor->mm, tmp);
+        }
+        btor_bvdomain_free (btor->mm, dom);
+      }
+
       btor_bv_free (btor->mm, bvcur);
       bvcur = bvenew;
     }
@@ -11,6 +11,7 @@
 
 #include "btorbeta.h"
 #include "btorbv.h"
+#include "btorbvdomain.h"
 #include "btorcore.h"
 #include "btordbg.h"
 #include "btorexp.h"
@@ -24,6 +25,7 @@
 #include "btorrewrite.h"
 
 #include <assert.h>
+#include <string.h>
 
 // TODO: mul: power of 2 optimizations
 
@@ -87,36 +89,483 @@
     (btor)->rec_rw_calls--;            \
   } while (0)
 
+/* -------------------------------------------------------------------------- */
+/* rule dispatch */
+
+/* Operand guards of the rewrite rules, i.e., necessary conditions on the
+ * operands of a rewrite function that are implied by 'applies_<rw_rule>'.
+ * Guards are checked against the operand signature of the current rewrite
+ * call (see BtorRwSig) before the (more expensive) 'applies_<rw_rule>'
+ * predicate is evaluated, which rules out most candidates by a few bit tests.
+ *
+ * Format:  RW_RULE (rw_rule, kinds e0, kinds e1, kinds e2, regular, inverted)
+ *
+ * where 'kinds ei' is the set of admissible kinds of the real address of the
+ * i-th operand (RW_ANY if unconstrained), and 'regular' ('inverted') is the
+ * set of operands that must not be (must be) inverted.
+ *
+ * Note: rules that are not listed here can not be used with ADD_RW_RULE. */
+
+#define RW_ANY 0
+#define RW_K(kind) (1u << BTOR_##kind##_NODE)
+#define RW_OP(i) (1u << (i))
+
+#define RW_K_CONST RW_K (BV_CONST)
+#define RW_K_OP_COND \
+  (RW_K (BV_ADD) | RW_K (BV_AND) | RW_K (BV_MUL) | RW_K (BV_UDIV) \
+   | RW_K (BV_UREM))
+#define RW_K_COMM_OP_COND (RW_K (BV_ADD) | RW_K (BV_AND) | RW_K (BV_MUL))
+
+#define BTOR_RW_RULES(RW_RULE)                                                 \
+  /* binary */                                                                 \
+  RW_RULE (const_binary_exp, RW_K_CONST, RW_K_CONST, RW_ANY, 0, 0)             \
+  RW_RULE (special_const_lhs_binary_exp, RW_K_CONST, RW_ANY, RW_ANY, 0, 0)     \
+  RW_RULE (special_const_rhs_binary_exp, RW_ANY, RW_K_CONST, RW_ANY, 0, 0)     \
+  /* slice */                                                                  \
+  RW_RULE (full_slice, RW_ANY, RW_ANY, RW_ANY, 0, 0)                           \
+  RW_RULE (const_slice, RW_K_CONST, RW_ANY, RW_ANY, 0, 0)                      \
+  RW_RULE (slice_slice, RW_K (BV_SLICE), RW_ANY, RW_ANY, 0, 0)                 \
+  RW_RULE (concat_lower_slice, RW_K (BV_CONCAT), RW_ANY, RW_ANY, 0, 0)         \
+  RW_RULE (concat_upper_slice, RW_K (BV_CONCAT), RW_ANY, RW_ANY, 0, 0)         \
+  RW_RULE (concat_rec_upper_slice, RW_K (BV_CONCAT), RW_ANY, RW_ANY, 0, 0)     \
+  RW_RULE (concat_rec_lower_slice, RW_K (BV_CONCAT), RW_ANY, RW_ANY, 0, 0)     \
+  RW_RULE (concat_rec_slice, RW_K (BV_CONCAT), RW_ANY, RW_ANY, 0, 0)           \
+  RW_RULE (and_slice, RW_K (BV_AND), RW_ANY, RW_ANY, 0, 0)                     \
+  RW_RULE (bcond_slice, RW_K (COND), RW_ANY, RW_ANY, 0, 0)                     \
+  RW_RULE (zero_lower_slice,                                                   \
+           RW_K (BV_MUL) | RW_K (BV_ADD),                                      \
+           RW_ANY,                                                             \
+           RW_ANY,                                                             \
+           0,                                                                  \
+           0)                                                                  \
+  /* eq */                                                                     \
+  RW_RULE (true_eq, RW_ANY, RW_ANY, RW_ANY, 0, 0)                              \
+  RW_RULE (false_eq, RW_ANY, RW_ANY, RW_ANY, 0, 0)                             \
+  RW_RULE (domain_eq, RW_ANY, RW_ANY, RW_ANY, 0, 0)                            \
+  RW_RULE (bcond_eq, RW_K (COND), RW_K (COND), RW_ANY, 0, 0)                   \
+  RW_RULE (add_left_eq, RW_K (BV_ADD), RW_ANY, RW_ANY, RW_OP (0), 0)           \
+  RW_RULE (add_right_eq, RW_K (BV_ADD), RW_ANY, RW_ANY, RW_OP (0), 0)          \
+  RW_RULE (add_add_1_eq,                                                       \
+           RW_K (BV_ADD),                                                      \
+           RW_K (BV_ADD),                                                      \
+           RW_ANY,                                                             \
+           RW_OP (0) | RW_OP (1),                                              \
+           0)                                                                  \
+  RW_RULE (add_add_2_eq,                                                       \
+           RW_K (BV_ADD),                                                      \
+           RW_K (BV_ADD),                                                      \
+           RW_ANY,                                                             \
+           RW_OP (0) | RW_OP (1),                                              \
+           0)                                                                  \
+  RW_RULE (add_add_3_eq,                                                       \
+           RW_K (BV_ADD),                                                      \
+           RW_K (BV_ADD),                                                      \
+           RW_ANY,                                                             \
+           RW_OP (0) | RW_OP (1),                                              \
+           0)                                                                  \
+  RW_RULE (add_add_4_eq,                                                       \
+           RW_K (BV_ADD),                                                      \
+           RW_K (BV_ADD),                                                      \
+           RW_ANY,                                                             \
+           RW_OP (0) | RW_OP (1),                                              \
+           0)                                                                  \
+  RW_RULE (sub_eq, RW_ANY, RW_K (BV_ADD), RW_ANY, RW_OP (1), 0)                \
+  RW_RULE (bcond_uneq_if_eq, RW_K (COND), RW_ANY, RW_ANY, RW_OP (0), 0)        \
+  RW_RULE (bcond_uneq_else_eq, RW_K (COND), RW_ANY, RW_ANY, RW_OP (0), 0)      \
+  RW_RULE (bcond_if_eq, RW_ANY, RW_K (COND), RW_ANY, 0, 0)                     \
+  RW_RULE (bcond_else_eq, RW_ANY, RW_K (COND), RW_ANY, 0, 0)                   \
+  RW_RULE (distrib_add_mul_eq,                                                 \
+           RW_K (BV_MUL),                                                      \
+           RW_K (BV_ADD),                                                      \
+           RW_ANY,                                                             \
+           RW_OP (0) | RW_OP (1),                                              \
+           0)                                                                  \
+  RW_RULE (concat_eq, RW_K (BV_CONCAT), RW_ANY, RW_ANY, 0, 0)                  \
+  /* ult */                                                                    \
+  RW_RULE (false_ult, RW_ANY, RW_ANY, RW_ANY, 0, 0)                            \
+  RW_RULE (domain_ult, RW_ANY, RW_ANY, RW_ANY, 0, 0)                           \
+  RW_RULE (bool_ult, RW_ANY, RW_ANY, RW_ANY, 0, 0)                             \
+  RW_RULE (concat_upper_ult,                                                   \
+           RW_K (BV_CONCAT),                                                   \
+           RW_K (BV_CONCAT),                                                   \
+           RW_ANY,                                                             \
+           RW_OP (0) | RW_OP (1),                                              \
+           0)                                                                  \
+  RW_RULE (concat_lower_ult,                                                   \
+           RW_K (BV_CONCAT),                                                   \
+           RW_K (BV_CONCAT),                                                   \
+           RW_ANY,                                                             \
+           RW_OP (0) | RW_OP (1),                                              \
+           0)                                                                  \
+  RW_RULE (bcond_ult, RW_K (COND), RW_K (COND), RW_ANY, 0, 0)                  \
+  /* and */                                                                    \
+  RW_RULE (idem1_and, RW_ANY, RW_ANY, RW_ANY, 0, 0)                            \
+  RW_RULE (contr1_and, RW_ANY, RW_ANY, RW_ANY, 0, 0)                           \
+  RW_RULE (contr2_and,                                                         \
+           RW_K (BV_AND),                                                      \
+           RW_K (BV_AND),                                                      \
+           RW_ANY,                                                             \
+           RW_OP (0) | RW_OP (1),                                              \
+           0)                                                                  \
+  RW_RULE (idem2_and,                                                          \
+           RW_K (BV_AND),                                                      \
+           RW_K (BV_AND),                                                      \
+           RW_ANY,                                                             \
+           RW_OP (0) | RW_OP (1),                                              \
+           0)                                                                  \
+  RW_RULE (comm_and,                                                           \
+           RW_K (BV_AND),                                                      \
+           RW_K (BV_AND),                                                      \
+           RW_ANY,                                                             \
+           RW_OP (0) | RW_OP (1),                                              \
+           0)                                                                  \
+  RW_RULE (bool_xnor_and,                                                      \
+           RW_K (BV_AND),                                                      \
+           RW_K (BV_AND),                                                      \
+           RW_ANY,                                                             \
+           0,                                                                  \
+           RW_OP (0) | RW_OP (1))                                              \
+  RW_RULE (resol1_and,                                                         \
+           RW_K (BV_AND),                                                      \
+           RW_K (BV_AND),                                                      \
+           RW_ANY,                                                             \
+           0,                                                                  \
+           RW_OP (0) | RW_OP (1))                                              \
+  RW_RULE (resol2_and,                                                         \
+           RW_K (BV_AND),                                                      \
+           RW_K (BV_AND),                                                      \
+           RW_ANY,                                                             \
+           0,                                                                  \
+           RW_OP (0) | RW_OP (1))                                              \
+  RW_RULE (ult_false_and,                                                      \
+           RW_K (BV_ULT),                                                      \
+           RW_K (BV_ULT),                                                      \
+           RW_ANY,                                                             \
+           RW_OP (0) | RW_OP (1),                                              \
+           0)                                                                  \
+  RW_RULE (ult_and,                                                            \
+           RW_K (BV_ULT),                                                      \
+           RW_K (BV_ULT),                                                      \
+           RW_ANY,                                                             \
+           0,                                                                  \
+           RW_OP (0) | RW_OP (1))                                              \
+  RW_RULE (contr_rec_and, RW_ANY, RW_ANY, RW_ANY, 0, 0)                        \
+  RW_RULE (subsum1_and,                                                        \
+           RW_K (BV_AND),                                                      \
+           RW_K (BV_AND),                                                      \
+           RW_ANY,                                                             \
+           RW_OP (0),                                                          \
+           RW_OP (1))                                                          \
+  RW_RULE (subst1_and,                                                         \
+           RW_K (BV_AND),                                                      \
+           RW_K (BV_AND),                                                      \
+           RW_ANY,                                                             \
+           RW_OP (0),                                                          \
+           RW_OP (1))                                                          \
+  RW_RULE (subst2_and,                                                         \
+           RW_K (BV_AND),                                                      \
+           RW_K (BV_AND),                                                      \
+           RW_ANY,                                                             \
+           RW_OP (0),                                                          \
+           RW_OP (1))                                                          \
+  RW_RULE (subsum2_and, RW_K (BV_AND), RW_ANY, RW_ANY, 0, RW_OP (0))           \
+  RW_RULE (subst3_and, RW_K (BV_AND), RW_ANY, RW_ANY, 0, RW_OP (0))            \
+  RW_RULE (subst4_and, RW_K (BV_AND), RW_ANY, RW_ANY, 0, RW_OP (0))            \
+  RW_RULE (contr3_and, RW_K (BV_AND), RW_ANY, RW_ANY, RW_OP (0), 0)            \
+  RW_RULE (idem3_and, RW_K (BV_AND), RW_ANY, RW_ANY, RW_OP (0), 0)             \
+  RW_RULE (const1_and, RW_K (BV_AND), RW_K_CONST, RW_ANY, RW_OP (0), 0)        \
+  RW_RULE (const2_and, RW_K (BV_AND), RW_K_CONST, RW_ANY, RW_OP (0), 0)        \
+  RW_RULE (concat_and, RW_K (BV_CONCAT), RW_K (BV_CONCAT), RW_ANY, 0, 0)       \
+  /* add */                                                                    \
+  RW_RULE (bool_add, RW_ANY, RW_ANY, RW_ANY, 0, 0)                             \
+  RW_RULE (mult_add, RW_ANY, RW_ANY, RW_ANY, 0, 0)                             \
+  RW_RULE (not_add, RW_ANY, RW_ANY, RW_ANY, 0, 0)                              \
+  RW_RULE (bcond_add, RW_K (COND), RW_K (COND), RW_ANY, 0, 0)                  \
+  RW_RULE (urem_add, RW_ANY, RW_ANY, RW_ANY, 0, 0)                             \
+  RW_RULE (neg_add, RW_ANY, RW_K (BV_ADD), RW_ANY, RW_OP (1), 0)               \
+  RW_RULE (zero_add, RW_K_CONST, RW_ANY, RW_ANY, 0, 0)                         \
+  RW_RULE (const_lhs_add, RW_K_CONST, RW_K (BV_ADD), RW_ANY, RW_OP (1), 0)     \
+  RW_RULE (const_rhs_add, RW_K_CONST, RW_K (BV_ADD), RW_ANY, RW_OP (1), 0)     \
+  RW_RULE (const_neg_lhs_add, RW_K (BV_MUL), RW_ANY, RW_ANY, 0, RW_OP (0))     \
+  RW_RULE (const_neg_rhs_add, RW_K (BV_MUL), RW_ANY, RW_ANY, 0, RW_OP (0))     \
+  RW_RULE (push_ite_add, RW_K (COND), RW_ANY, RW_ANY, RW_OP (0), 0)            \
+  /* mul */                                                                    \
+  RW_RULE (bool_mul, RW_ANY, RW_ANY, RW_ANY, 0, 0)                             \
+  RW_RULE (const_lhs_mul, RW_K_CONST, RW_K (BV_MUL), RW_ANY, RW_OP (1), 0)     \
+  RW_RULE (const_rhs_mul, RW_K_CONST, RW_K (BV_MUL), RW_ANY, RW_OP (1), 0)     \
+  RW_RULE (const_mul, RW_K_CONST, RW_K (BV_ADD), RW_ANY, RW_OP (1), 0)         \
+  RW_RULE (push_ite_mul, RW_K (COND), RW_ANY, RW_ANY, RW_OP (0), 0)            \
+  RW_RULE (sll_mul, RW_K (BV_SLL), RW_ANY, RW_ANY, RW_OP (0), 0)               \
+  RW_RULE (neg_mul,                                                            \
+           RW_K (BV_ADD),                                                      \
+           RW_K (BV_ADD),                                                      \
+           RW_ANY,                                                             \
+           RW_OP (0) | RW_OP (1),                                              \
+           0)                                                                  \
+  /* udiv */                                                                   \
+  RW_RULE (bool_udiv, RW_ANY, RW_ANY, RW_ANY, 0, 0)                            \
+  RW_RULE (power2_udiv, RW_ANY, RW_K_CONST, RW_ANY, RW_OP (1), 0)              \
+  RW_RULE (one_udiv, RW_ANY, RW_ANY, RW_ANY, 0, 0)                             \
+  RW_RULE (bcond_udiv, RW_K (COND), RW_K (COND), RW_ANY, 0, 0)                 \
+  /* urem */                                                                   \
+  RW_RULE (bool_urem, RW_ANY, RW_ANY, RW_ANY, 0, 0)                            \
+  RW_RULE (zero_urem, RW_ANY, RW_ANY, RW_ANY, 0, 0)                            \
+  /* concat */                                                                 \
+  RW_RULE (const_concat, RW_K (BV_CONCAT), RW_K_CONST, RW_ANY, 0, 0)           \
+  RW_RULE (slice_concat, RW_K (BV_SLICE), RW_K (BV_SLICE), RW_ANY, 0, 0)       \
+  RW_RULE (and_lhs_concat, RW_K (BV_AND), RW_ANY, RW_ANY, 0, 0)                \
+  RW_RULE (and_rhs_concat, RW_ANY, RW_K (BV_AND), RW_ANY, 0, 0)                \
+  /* sll, srl */                                                               \
+  RW_RULE (const_sll, RW_ANY, RW_K_CONST, RW_ANY, 0, 0)                        \
+  RW_RULE (const_srl, RW_ANY, RW_K_CONST, RW_ANY, 0, 0)                        \
+  /* apply */                                                                  \
+  RW_RULE (const_lambda_apply, RW_K (LAMBDA), RW_ANY, RW_ANY, 0, 0)            \
+  RW_RULE (param_lambda_apply, RW_K (LAMBDA), RW_ANY, RW_ANY, 0, 0)            \
+  RW_RULE (apply_apply, RW_K (LAMBDA), RW_ANY, RW_ANY, 0, 0)                   \
+  RW_RULE (prop_apply_lambda, RW_K (LAMBDA), RW_ANY, RW_ANY, 0, 0)             \
+  RW_RULE (prop_apply_update, RW_K (UPDATE), RW_ANY, RW_ANY, 0, 0)             \
+  /* quantifiers */                                                            \
+  RW_RULE (const_quantifier, RW_ANY, RW_ANY, RW_ANY, 0, 0)                     \
+  RW_RULE (eq_forall, RW_ANY, RW_K (BV_EQ), RW_ANY, 0, 0)                      \
+  RW_RULE (eq_exists, RW_ANY, RW_K (BV_EQ), RW_ANY, 0, 0)                      \
+  /* cond */                                                                   \
+  RW_RULE (equal_branches_cond, RW_ANY, RW_ANY, RW_ANY, 0, 0)                  \
+  RW_RULE (const_cond, RW_K_CONST, RW_ANY, RW_ANY, 0, 0)                       \
+  RW_RULE (cond_if_dom_cond, RW_ANY, RW_K (COND), RW_ANY, 0, 0)                \
+  RW_RULE (cond_if_merge_if_cond, RW_ANY, RW_K (COND), RW_ANY, 0, 0)           \
+  RW_RULE (cond_if_merge_else_cond, RW_ANY, RW_K (COND), RW_ANY, 0, 0)         \
+  RW_RULE (cond_else_dom_cond, RW_ANY, RW_ANY, RW_K (COND), 0, 0)              \
+  RW_RULE (cond_else_merge_if_cond, RW_ANY, RW_ANY, RW_K (COND), 0, 0)         \
+  RW_RULE (cond_else_merge_else_cond, RW_ANY, RW_ANY, RW_K (COND), 0, 0)       \
+  RW_RULE (bool_cond, RW_ANY, RW_ANY, RW_ANY, 0, 0)                            \
+  RW_RULE (add_if_cond, RW_ANY, RW_K (BV_ADD), RW_ANY, RW_OP (1), 0)           \
+  RW_RULE (add_else_cond, RW_ANY, RW_ANY, RW_K (BV_ADD), RW_OP (2), 0)         \
+  RW_RULE (concat_cond, RW_ANY, RW_K (BV_CONCAT), RW_K (BV_CONCAT), 0, 0)      \
+  RW_RULE (op_lhs_cond,                                                        \
+           RW_ANY,                                                             \
+           RW_K_OP_COND,                                                       \
+           RW_K_OP_COND,                                                       \
+           RW_OP (1) | RW_OP (2),                                              \
+           0)                                                                  \
+  RW_RULE (op_rhs_cond,                                                        \
+           RW_ANY,                                                             \
+           RW_K_OP_COND,                                                       \
+           RW_K_OP_COND,                                                       \
+           RW_OP (1) | RW_OP (2),                                              \
+           0)                                                                  \
+  RW_RULE (comm_op_1_cond,                                                     \
+           RW_ANY,                                                             \
+           RW_K_COMM_OP_COND,                                                  \
+           RW_K_COMM_OP_COND,                                                  \
+           RW_OP (1) | RW_OP (2),                                              \
+           0)                                                                  \
+  RW_RULE (comm_op_2_cond,                                                     \
+           RW_ANY,                                                             \
+           RW_K_COMM_OP_COND,                                                  \
+           RW_K_COMM_OP_COND,                                                  \
+           RW_OP (1) | RW_OP (2),                                              \
+           0)
+
+enum BtorRwRule
+{
+#define RW_RULE(rw_rule, k0, k1, k2, reg, inv) BTOR_RW_RULE_##rw_rule,
+  BTOR_RW_RULES (RW_RULE)
+#undef RW_RULE
+      BTOR_RW_RULE_NUM
+};
+
+typedef enum BtorRwRule BtorRwRule;
+
+struct BtorRwRuleGuard
+{
+  uint32_t kinds[3]; /* admissible kinds of the operands, RW_ANY if any */
+  uint32_t regular;  /* operands that must be regular */
+  uint32_t inverted; /* operands that must be inverted */
+};
+
+typedef struct BtorRwRuleGuard BtorRwRuleGuard;
+
+static const BtorRwRuleGuard rw_rule_guards[BTOR_RW_RULE_NUM] = {
+#define RW_RULE(rw_rule, k0, k1, k2, reg, inv) {{k0, k1, k2}, reg, inv},
+    BTOR_RW_RULES (RW_RULE)
+#undef RW_RULE
+};
+
+/* Operand signature of a rewrite call. */
+struct BtorRwSig
+{
+  uint32_t kinds[3]; /* kinds of the real operands, 0 for missing operands */
+  uint32_t inverted; /* inverted operands */
+};
+
+typedef struct BtorRwSig BtorRwSig;
+
+static inline void
+rw_sig_init (BtorRwSig *sig, BtorNode *e0, BtorNode *e1, BtorNode *e2)
+{
+  uint32_t i;
+  BtorNode *e[3] = {e0, e1, e2};
+
+  sig->inverted = 0;
+  for (i = 0; i < 3; i++)
+  {
+    if (!e[i])
+    {
+      sig->kinds[i] = 0;
+      continue;
+    }
+    sig->kinds[i] = 1u << btor_node_real_addr (e[i])->kind;
+    if (btor_node_is_inverted (e[i])) sig->inverted |= RW_OP (i);
+  }
+}
+
+static inline bool
+rw_sig_admits (const BtorRwSig *sig, BtorRwRule rule)
+{
+  const BtorRwRuleGuard *g = &rw_rule_guards[rule];
+  return (g->kinds[0] == RW_ANY || (g->kinds[0] & sig->kinds[0]))
+         && (g->kinds[1] == RW_ANY || (g->kinds[1] & sig->kinds[1]))
+         && (g->kinds[2] == RW_ANY || (g->kinds[2] & sig->kinds[2]))
+         && !(g->regular & sig->inverted)
+         && (g->inverted & sig->inverted) == g->inverted;
+}
+
+/* -------------------------------------------------------------------------- */
+/* rule profile */
+
+/* only every 2^BTOR_RW_PROFILE_SAMPLE_SHIFT-th attempt of a rule is timed */
+#define BTOR_RW_PROFILE_SAMPLE_SHIFT 4
+#define BTOR_RW_PROFILE_SAMPLE_MASK ((1u << BTOR_RW_PROFILE_SAMPLE_SHIFT) - 1)
+
+static const char *const rw_rule_names[BTOR_RW_RULE_NUM] = {
+#define RW_RULE(rw_rule, k0, k1, k2, reg, inv) #rw_rule,
+    BTOR_RW_RULES (RW_RULE)
+#undef RW_RULE
+};
+
+struct BtorRwProfileRule
+{
+  uint_least64_t attempts;  /* applies_<rw_rule> evaluations */
+  uint_least64_t successes; /* rule applied */
+  uint_least64_t samples;   /* timed attempts */
+  double time;              /* time of timed attempts */
+  int_least64_t saved;      /* nodes saved by applying the rule */
+};
+
+typedef struct BtorRwProfileRule BtorRwProfileRule;
+
+struct BtorRwProfileFun
+{
+  uint_least64_t calls;
+  double time;
+};
+
+typedef struct BtorRwProfileFun BtorRwProfileFun;
+
+struct BtorRwProfile
+{
+  BtorRwProfileRule rules[BTOR_RW_RULE_NUM];
+  BtorRwProfileFun funs[BTOR_NUM_OPS_NODE]; /* indexed by node kind */
+};
+
+/* Profile state of a single rule attempt. */
+struct BtorRwProbe
+{
+  BtorRwProfileRule *rule;    /* 0 if profiling is disabled */
+  uint_least64_t expressions; /* number of expressions created so far */
+  double start;               /* start time, < 0 if not timed */
+};
+
+typedef struct BtorRwProbe BtorRwProbe;
+
+static inline void
+rw_profile_start (Btor *btor, BtorRwRule rule, BtorRwProbe *probe)
+{
+  BtorRwProfileRule *r;
+
+  probe->rule        = 0;
+  probe->expressions = 0;
+  probe->start       = -1;
+  if (!btor->rw_profile) return;
+
+  r                  = &btor->rw_profile->rules[rule];
+  probe->rule        = r;
+  probe->expressions = btor->stats.expressions;
+  if ((r->attempts++ & BTOR_RW_PROFILE_SAMPLE_MASK) == 0)
+    probe->start = btor_util_process_time_thread ();
+}
+
+static inline void
+rw_profile_stop (Btor *btor, BtorRwProbe *probe, BtorNode *result)
+{
+  BtorRwProfileRule *r;
+
+  if (!(r = probe->rule)) return;
+
+  if (probe->start >= 0)
+  {
+    r->samples += 1;
+    r->time += btor_util_process_time_thread () - probe->start;
+  }
+  if (result)
+  {
+    /* without the rule, exactly one node would have been created */
+    r->successes += 1;
+    r->saved += 1 - (int_least64_t) (btor->stats.expressions - probe->expressions);
+  }
+}
+
+/* Estimated time spent in rule 'r', extrapolated from the timed attempts. */
+static double
+rw_profile_rule_time (BtorRwProfileRule *r)
+{
+  return r->samples ? r->time * r->attempts / r->samples : 0;
+}
+
+static inline void
+rw_profile_init (Btor *btor)
+{
+  if (!btor->rw_profile && btor_opt_get (btor, BTOR_OPT_RW_PROFILE))
+    BTOR_CNEW (btor->mm, btor->rw_profile);
+}
+
+static inline void
+rw_profile_fun (Btor *btor, BtorNodeKind kind, double time)
+{
+  if (!btor->rw_profile) return;
+  btor->rw_profile->funs[kind].calls += 1;
+  btor->rw_profile->funs[kind].time += time;
+}
+
+/* -------------------------------------------------------------------------- */
+
 // TODO: special_const_binary rewriting may return 0, hence the check if
 //       (result), may be obsolete if special_const_binary will be split
-#ifndef NDEBUG
 #define ADD_RW_RULE(rw_rule, ...)                                              \
-  if (applies_##rw_rule (btor, __VA_ARGS__))                                   \
+  if (!rw_sig_admits (&rw_sig, BTOR_RW_RULE_##rw_rule))                        \
+  {                                                                            \
+    btor->stats.rw_rules_skipped++;                                            \
+  }                                                                            \
+  else                                                                         \
   {                                                                            \
-    assert (!result);                                                          \
-    result = apply_##rw_rule (btor, __VA_ARGS__);                              \
+    BtorRwProbe rw_probe;                                                      \
+    rw_profile_start (btor, BTOR_RW_RULE_##rw_rule, &rw_probe);                \
+    if (applies_##rw_rule (btor, __VA_ARGS__))                                 \
+    {                                                                          \
+      assert (!result);                                                        \
+      result = apply_##rw_rule (btor, __VA_ARGS__);                            \
+    }                                                                          \
+    rw_profile_stop (btor, &rw_probe, result);                                 \
     if (result)                                                                \
     {                                                                          \
-      if (btor->stats.rw_rules_applied)                                        \
-      {                                                                        \
-        BtorPtrHashBucket *b =                                                 \
-            btor_hashptr_table_get (btor->stats.rw_rules_applied, #rw_rule);   \
-        if (!b)                                                                \
-          b = btor_hashptr_table_add (btor->stats.rw_rules_applied, #rw_rule); \
-        b->data.as_int += 1;                                                   \
-      }                                                                        \
+      BtorPtrHashBucket *b =                                                   \
+          btor_hashptr_table_get (btor->stats.rw_rules_applied, #rw_rule);     \
+      if (!b)                                                                  \
+        b = btor_hashptr_table_add (btor->stats.rw_rules_applied, #rw_rule);   \
+      b->data.as_int += 1;                                                     \
       goto DONE;                                                               \
     }                                                                          \
   }
-#else
-#define ADD_RW_RULE(rw_rule, ...)                 \
-  if (applies_##rw_rule (btor, __VA_ARGS__))      \
-  {                                               \
-    assert (!result);                             \
-    result = apply_##rw_rule (btor, __VA_ARGS__); \
-    if (result) goto DONE;                        \
-  }
-#endif
 //{fprintf (stderr, "apply: %s (%s)\n", #rw_rule, __FUNCTION__);
 
 /* -------------------------------------------------------------------------- */
@@ -1761,6 +2210,36 @@ apply_false_eq (Btor *btor, BtorNode *e0, BtorNode *e1)
   return btor_exp_false (btor);
 }
 
+/*
+ * match:  a = b, where the bv domains of a and b are disjoint
+ * result: false
+ */
+static inline bool
+applies_domain_eq (Btor *btor, BtorNode *e0, BtorNode *e1)
+{
+  bool res;
+  BtorBvDomain *d0, *d1;
+
+  if (!btor_opt_get (btor, BTOR_OPT_BV_DOMAIN) || btor_node_is_fun (e0))
+    return false;
+
+  d0  = btor_bvdomain_get (btor, e0);
+  d1  = btor_bvdomain_get (btor, e1);
+  res = !btor_bvdomain_meet (btor->mm, d0, d1);
+  btor_bvdomain_free (btor->mm, d0);
+  btor_bvdomain_free (btor->mm, d1);
+  return res;
+}
+
+static inline BtorNode *
+apply_domain_eq (Btor *btor, BtorNode *e0, BtorNode *e1)
+{
+  assert (applies_domain_eq (btor, e0, e1));
+  (void) e0;
+  (void) e1;
+  return btor_exp_false (btor);
+}
+
 /*
  * match:  a + b = a
  * result: b = 0
@@ -2506,6 +2985,45 @@ apply_false_ult (Btor *btor, BtorNode *e0, BtorNode *e1)
   return btor_exp_false (btor);
 }
 
+/*
+ * match:  a < b, where max(a) < min(b) or min(a) >= max(b) in the bv domains
+ *         of a and b
+ * result: true or false
+ */
+static inline int32_t
+domain_ult (Btor *btor, BtorNode *e0, BtorNode *e1)
+{
+  int32_t res;
+  BtorBvDomain *d0, *d1;
+
+  d0 = btor_bvdomain_get (btor, e0);
+  d1 = btor_bvdomain_get (btor, e1);
+  if (btor_bv_compare (d0->max, d1->min) < 0)
+    res = 1;
+  else if (btor_bv_compare (d0->min, d1->max) >= 0)
+    res = 0;
+  else
+    res = -1;
+  btor_bvdomain_free (btor->mm, d0);
+  btor_bvdomain_free (btor->mm, d1);
+  return res;
+}
+
+static inline bool
+applies_domain_ult (Btor *btor, BtorNode *e0, BtorNode *e1)
+{
+  return btor_opt_get (btor, BTOR_OPT_BV_DOMAIN)
+         && domain_ult (btor, e0, e1) >= 0;
+}
+
+static inline BtorNode *
+apply_domain_ult (Btor *btor, BtorNode *e0, BtorNode *e1)
+{
+  assert (applies_domain_ult (btor, e0, e1));
+  return domain_ult (btor, e0, e1) ? btor_exp_true (btor)
+                                   : btor_exp_false (btor);
+}
+
 /*
  * match:  a < b, where len(a) = 1
  * result: !a AND b
@@ -6446,6 +6964,7 @@ static BtorNode *
 rewrite_slice_exp (Btor *btor, BtorNode *e, uint32_t upper, uint32_t lower)
 {
   BtorNode *result = 0;
+  BtorRwSig rw_sig;
 
   e = btor_simplify_exp (btor, e);
   assert (btor_dbg_precond_slice_exp (btor, e, upper, lower));
@@ -6455,6 +6974,7 @@ rewrite_slice_exp (Btor *btor, BtorNode *e, uint32_t upper, uint32_t lower)
 
   if (!result)
   {
+    rw_sig_init (&rw_sig, e, 0, 0);
     ADD_RW_RULE (full_slice, e, upper, lower);
     ADD_RW_RULE (const_slice, e, upper, lower);
     ADD_RW_RULE (slice_slice, e, upper, lower);
@@ -6494,6 +7014,7 @@ rewrite_eq_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 {
   bool swap_ops = false;
   BtorNode *result = 0;
+  BtorRwSig rw_sig;
   BtorNodeKind kind;
 
   e0 = btor_simplify_exp (btor, e0);
@@ -6511,6 +7032,7 @@ SWAP_OPERANDS:
 
   if (!result)
   {
+    rw_sig_init (&rw_sig, e0, e1, 0);
     if (!swap_ops)
     {
       ADD_RW_RULE (const_binary_exp, kind, e0, e1);
@@ -6523,6 +7045,7 @@ SWAP_OPERANDS:
        */
       ADD_RW_RULE (true_eq, e0, e1);
       ADD_RW_RULE (false_eq, e0, e1);
+      ADD_RW_RULE (domain_eq, e0, e1);
       ADD_RW_RULE (bcond_eq, e0, e1);
       ADD_RW_RULE (special_const_lhs_binary_exp, kind, e0, e1);
       ADD_RW_RULE (special_const_rhs_binary_exp, kind, e0, e1);
@@ -6579,6 +7102,7 @@ static BtorNode *
 rewrite_ult_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 {
   BtorNode *result = 0;
+  BtorRwSig rw_sig;
 
   e0 = btor_simplify_exp (btor, e0);
   e1 = btor_simplify_exp (btor, e1);
@@ -6593,10 +7117,12 @@ rewrite_ult_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 
   if (!result)
   {
+    rw_sig_init (&rw_sig, e0, e1, 0);
     ADD_RW_RULE (const_binary_exp, BTOR_BV_ULT_NODE, e0, e1);
     ADD_RW_RULE (special_const_lhs_binary_exp, BTOR_BV_ULT_NODE, e0, e1);
     ADD_RW_RULE (special_const_rhs_binary_exp, BTOR_BV_ULT_NODE, e0, e1);
     ADD_RW_RULE (false_ult, e0, e1);
+    ADD_RW_RULE (domain_ult, e0, e1);
     ADD_RW_RULE (bool_ult, e0, e1);
     ADD_RW_RULE (concat_upper_ult, e0, e1);
     ADD_RW_RULE (concat_lower_ult, e0, e1);
@@ -6630,6 +7156,7 @@ rewrite_and_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 {
   bool swap_ops = false;
   BtorNode *result = 0;
+  BtorRwSig rw_sig;
 
   e0 = btor_simplify_exp (btor, e0);
   e1 = btor_simplify_exp (btor, e1);
@@ -6645,6 +7172,7 @@ SWAP_OPERANDS:
 
   if (!result)
   {
+    rw_sig_init (&rw_sig, e0, e1, 0);
     if (!swap_ops)
     {
       ADD_RW_RULE (const_binary_exp, BTOR_BV_AND_NODE, e0, e1);
@@ -6712,6 +7240,7 @@ rewrite_add_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 {
   bool swap_ops = false;
   BtorNode *result = 0;
+  BtorRwSig rw_sig;
 
   e0 = btor_simplify_exp (btor, e0);
   e1 = btor_simplify_exp (btor, e1);
@@ -6727,6 +7256,7 @@ SWAP_OPERANDS:
 
   if (!result)
   {
+    rw_sig_init (&rw_sig, e0, e1, 0);
     if (!swap_ops)
     {
       ADD_RW_RULE (const_binary_exp, BTOR_BV_ADD_NODE, e0, e1);
@@ -6785,6 +7315,7 @@ rewrite_mul_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 {
   bool swap_ops = false;
   BtorNode *result = 0;
+  BtorRwSig rw_sig;
 
   e0 = btor_simplify_exp (btor, e0);
   e1 = btor_simplify_exp (btor, e1);
@@ -6800,6 +7331,7 @@ SWAP_OPERANDS:
 
   if (!result)
   {
+    rw_sig_init (&rw_sig, e0, e1, 0);
     if (!swap_ops)
     {
       ADD_RW_RULE (const_binary_exp, BTOR_BV_MUL_NODE, e0, e1);
@@ -6854,6 +7386,7 @@ static BtorNode *
 rewrite_udiv_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 {
   BtorNode *result = 0;
+  BtorRwSig rw_sig;
 
   e0 = btor_simplify_exp (btor, e0);
   e1 = btor_simplify_exp (btor, e1);
@@ -6868,6 +7401,7 @@ rewrite_udiv_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 
   if (!result)
   {
+    rw_sig_init (&rw_sig, e0, e1, 0);
     // TODO what about non powers of 2, like divisor 3, which means that
     // some upper bits are 0 ...
 
@@ -6906,6 +7440,7 @@ static BtorNode *
 rewrite_urem_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 {
   BtorNode *result = 0;
+  BtorRwSig rw_sig;
 
   e0 = btor_simplify_exp (btor, e0);
   e1 = btor_simplify_exp (btor, e1);
@@ -6920,6 +7455,7 @@ rewrite_urem_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 
   if (!result)
   {
+    rw_sig_init (&rw_sig, e0, e1, 0);
     // TODO do optimize for powers of two even AIGs do it as well !!!
 
     // TODO what about non powers of 2, like modulo 3, which means that
@@ -6958,6 +7494,7 @@ static BtorNode *
 rewrite_concat_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 {
   BtorNode *result = 0;
+  BtorRwSig rw_sig;
 
   e0 = btor_simplify_exp (btor, e0);
   e1 = btor_simplify_exp (btor, e1);
@@ -6972,6 +7509,7 @@ rewrite_concat_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 
   if (!result)
   {
+    rw_sig_init (&rw_sig, e0, e1, 0);
     ADD_RW_RULE (const_binary_exp, BTOR_BV_CONCAT_NODE, e0, e1);
     ADD_RW_RULE (special_const_lhs_binary_exp, BTOR_BV_CONCAT_NODE, e0, e1);
     ADD_RW_RULE (special_const_rhs_binary_exp, BTOR_BV_CONCAT_NODE, e0, e1);
@@ -7007,6 +7545,7 @@ static BtorNode *
 rewrite_sll_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 {
   BtorNode *result = 0;
+  BtorRwSig rw_sig;
 
   e0 = btor_simplify_exp (btor, e0);
   e1 = btor_simplify_exp (btor, e1);
@@ -7017,6 +7556,7 @@ rewrite_sll_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 
   if (!result)
   {
+    rw_sig_init (&rw_sig, e0, e1, 0);
     ADD_RW_RULE (const_binary_exp, BTOR_BV_SLL_NODE, e0, e1);
     ADD_RW_RULE (special_const_lhs_binary_exp, BTOR_BV_SLL_NODE, e0, e1);
     ADD_RW_RULE (special_const_rhs_binary_exp, BTOR_BV_SLL_NODE, e0, e1);
@@ -7047,6 +7587,7 @@ static BtorNode *
 rewrite_srl_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 {
   BtorNode *result = 0;
+  BtorRwSig rw_sig;
 
   e0 = btor_simplify_exp (btor, e0);
   e1 = btor_simplify_exp (btor, e1);
@@ -7057,6 +7598,7 @@ rewrite_srl_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 
   if (!result)
   {
+    rw_sig_init (&rw_sig, e0, e1, 0);
     ADD_RW_RULE (const_binary_exp, BTOR_BV_SRL_NODE, e0, e1);
     ADD_RW_RULE (special_const_lhs_binary_exp, BTOR_BV_SRL_NODE, e0, e1);
     ADD_RW_RULE (special_const_rhs_binary_exp, BTOR_BV_SRL_NODE, e0, e1);
@@ -7088,6 +7630,7 @@ static BtorNode *
 rewrite_apply_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 {
   BtorNode *result = 0;
+  BtorRwSig rw_sig;
 
   e0 = btor_simplify_exp (btor, e0);
   e1 = btor_simplify_exp (btor, e1);
@@ -7098,6 +7641,7 @@ rewrite_apply_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 
   if (!result)
   {
+    rw_sig_init (&rw_sig, e0, e1, 0);
     ADD_RW_RULE (const_lambda_apply, e0, e1);
     ADD_RW_RULE (param_lambda_apply, e0, e1);
     ADD_RW_RULE (apply_apply, e0, e1);
@@ -7151,6 +7695,7 @@ static BtorNode *
 rewrite_forall_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 {
   BtorNode *result = 0;
+  BtorRwSig rw_sig;
 
   e0 = btor_simplify_exp (btor, e0);
   e1 = btor_simplify_exp (btor, e1);
@@ -7160,6 +7705,7 @@ rewrite_forall_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 
   if (!result)
   {
+    rw_sig_init (&rw_sig, e0, e1, 0);
     ADD_RW_RULE (const_quantifier, e0, e1);
     ADD_RW_RULE (eq_forall, e0, e1);
     //  ADD_RW_RULE (param_free_forall, e0, e1);
@@ -7189,6 +7735,7 @@ static BtorNode *
 rewrite_exists_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 {
   BtorNode *result = 0;
+  BtorRwSig rw_sig;
 
   e0 = btor_simplify_exp (btor, e0);
   e1 = btor_simplify_exp (btor, e1);
@@ -7198,6 +7745,7 @@ rewrite_exists_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 
   if (!result)
   {
+    rw_sig_init (&rw_sig, e0, e1, 0);
     ADD_RW_RULE (const_quantifier, e0, e1);
     ADD_RW_RULE (eq_exists, e0, e1);
     //  ADD_RW_RULE (param_free_exists, e0, e1);
@@ -7227,6 +7775,7 @@ static BtorNode *
 rewrite_cond_exp (Btor *btor, BtorNode *e0, BtorNode *e1, BtorNode *e2)
 {
   BtorNode *result = 0;
+  BtorRwSig rw_sig;
 
   e0 = btor_simplify_exp (btor, e0);
   e1 = btor_simplify_exp (btor, e1);
@@ -7247,6 +7796,7 @@ rewrite_cond_exp (Btor *btor, BtorNode *e0, BtorNode *e1, BtorNode *e2)
 
   if (!result)
   {
+    rw_sig_init (&rw_sig, e0, e1, e2);
     ADD_RW_RULE (equal_branches_cond, e0, e1, e2);
     ADD_RW_RULE (const_cond, e0, e1, e2);
     ADD_RW_RULE (cond_if_dom_cond, e0, e1, e2);
@@ -7304,9 +7854,14 @@ btor_rewrite_slice_exp (Btor *btor,
   assert (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 0);
 
   BtorNode *res;
-  double start = btor_util_time_stamp ();
-  res          = rewrite_slice_exp (btor, exp, upper, lower);
-  btor->time.rewrite += btor_util_time_stamp () - start;
+  double start, delta;
+
+  rw_profile_init (btor);
+  start = btor_util_time_stamp ();
+  res   = rewrite_slice_exp (btor, exp, upper, lower);
+  delta = btor_util_time_stamp () - start;
+  btor->time.rewrite += delta;
+  rw_profile_fun (btor, BTOR_BV_SLICE_NODE, delta);
   return res;
 }
 
@@ -7323,7 +7878,10 @@ btor_rewrite_binary_exp (Btor *btor,
   assert (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 0);
 
   BtorNode *result;
-  double start = btor_util_time_stamp ();
+  double start, delta;
+
+  rw_profile_init (btor);
+  start = btor_util_time_stamp ();
 
   switch (kind)
   {
@@ -7359,7 +7917,9 @@ btor_rewrite_binary_exp (Btor *btor,
       result = rewrite_lambda_exp (btor, e0, e1);
   }
 
-  btor->time.rewrite += btor_util_time_stamp () - start;
+  delta = btor_util_time_stamp () - start;
+  btor->time.rewrite += delta;
+  rw_profile_fun (btor, kind, delta);
   return result;
 }
 
@@ -7377,8 +7937,128 @@ btor_rewrite_ternary_exp (
   (void) kind;
 
   BtorNode *res;
-  double start = btor_util_time_stamp ();
-  res          = rewrite_cond_exp (btor, e0, e1, e2);
-  btor->time.rewrite += btor_util_time_stamp () - start;
+  double start, delta;
+
+  rw_profile_init (btor);
+  start = btor_util_time_stamp ();
+  res   = rewrite_cond_exp (btor, e0, e1, e2);
+  delta = btor_util_time_stamp () - start;
+  btor->time.rewrite += delta;
+  rw_profile_fun (btor, BTOR_COND_NODE, delta);
   return res;
 }
+
+/* -------------------------------------------------------------------------- */
+
+BtorRwProfile *
+btor_rewrite_profile_clone (BtorMemMgr *mm, BtorRwProfile *profile)
+{
+  assert (mm);
+
+  BtorRwProfile *res;
+
+  if (!profile) return 0;
+  BTOR_NEW (mm, res);
+  memcpy (res, profile, sizeof (BtorRwProfile));
+  return res;
+}
+
+void
+btor_rewrite_profile_delete (BtorMemMgr *mm, BtorRwProfile *profile)
+{
+  assert (mm);
+  if (profile) BTOR_DELETE (mm, profile);
+}
+
+size_t
+btor_rewrite_profile_size (BtorRwProfile *profile)
+{
+  return profile ? sizeof (BtorRwProfile) : 0;
+}
+
+void
+btor_rewrite_profile_print (Btor *btor)
+{
+  assert (btor);
+
+  uint32_t i;
+  BtorRwProfile *profile;
+  BtorRwProfileRule *r;
+  BtorRwProfileFun *f;
+
+  if (!(profile = btor->rw_profile)) return;
+
+  BTOR_MSG (btor->msg, 1, "");
+  BTOR_MSG (btor->msg, 1, "rewrite rule profile:");
+  BTOR_MSG (btor->msg,
+            1,
+            "  %10s %10s %9s %8s  %s",
+            "attempts",
+            "applied",
+            "time",
+            "saved",
+            "rule");
+  for (i = 0; i < BTOR_RW_RULE_NUM; i++)
+  {
+    r = &profile->rules[i];
+    if (!r->attempts) continue;
+    BTOR_MSG (btor->msg,
+              1,
+              "  %10lld %10lld %8.3fs %8lld  %s",
+              r->attempts,
+              r->successes,
+              rw_profile_rule_time (r),
+              r->saved,
+              rw_rule_names[i]);
+  }
+  BTOR_MSG (btor->msg, 1, "rewrite function profile (top-level calls):");
+  BTOR_MSG (btor->msg, 1, "  %10s %9s  %s", "calls", "time", "kind");
+  for (i = 0; i < BTOR_NUM_OPS_NODE; i++)
+  {
+    f = &profile->funs[i];
+    if (!f->calls) continue;
+    BTOR_MSG (btor->msg,
+              1,
+              "  %10lld %8.3fs  %s",
+              f->calls,
+              f->time,
+              g_btor_op2str[i]);
+  }
+}
+
+void
+btor_rewrite_profile_dump (Btor *btor, FILE *file)
+{
+  assert (btor);
+  assert (file);
+
+  uint32_t i;
+  BtorRwProfile *profile;
+  BtorRwProfileRule *r;
+  BtorRwProfileFun *f;
+
+  if (!(profile = btor->rw_profile)) return;
+
+  for (i = 0; i < BTOR_RW_RULE_NUM; i++)
+  {
+    r = &profile->rules[i];
+    fprintf (file,
+             "rw-profile rule %s %lld %lld %.6f %lld\n",
+             rw_rule_names[i],
+             (long long) r->attempts,
+             (long long) r->successes,
+             rw_profile_rule_time (r),
+             (long long) r->saved);
+  }
+  for (i = 0; i < BTOR_NUM_OPS_NODE; i++)
+  {
+    f = &profile->funs[i];
+    if (!f->calls) continue;
+    fprintf (file,
+             "rw-profile fun %s %lld %.6f\n",
+             g_btor_op2str[i],
+             (long long) f->calls,
+             f->time);
+  }
+  fflush (file);
+}
@@ -14,6 +14,8 @@
 
 #include "btornode.h"
 
+#include <stdio.h>
+
 /*------------------------------------------------------------------------*/
 
 BtorNode *btor_rewrite_slice_exp (Btor *btor,
@@ -34,4 +36,26 @@ bool btor_rewrite_linear_term (Btor *btor,
                                BtorBitVector **fp,
                                BtorNode **lp,
                                BtorNode **rp);
+
+/*------------------------------------------------------------------------*/
+/* Rewrite rule profile, enabled via BTOR_OPT_RW_PROFILE. */
+
+typedef struct BtorRwProfile BtorRwProfile;
+
+BtorRwProfile *btor_rewrite_profile_clone (BtorMemMgr *mm,
+                                           BtorRwProfile *profile);
+
+void btor_rewrite_profile_delete (BtorMemMgr *mm, BtorRwProfile *profile);
+
+size_t btor_rewrite_profile_size (BtorRwProfile *profile);
+
+/* Print the profile of 'btor' as part of the statistics. */
+void btor_rewrite_profile_print (Btor *btor);
+
+/* Print the profile of 'btor' to 'file', one entry per line:
+ *   rw-profile rule <rule> <attempts> <successes> <seconds> <saved nodes>
+ *   rw-profile fun <kind> <calls> <seconds>
+ */
+void btor_rewrite_profile_dump (Btor *btor, FILE *file);
+
 #endif
@@ -55,6 +55,21 @@ clone_fun_solver (Btor *clone, BtorFunSolver *slv, BtorNodeMap *exp_map)
   btor_clone_node_ptr_stack (
       clone->mm, &slv->cur_lemmas, &res->cur_lemmas, exp_map, false);
 
+  if (slv->abstractions)
+    res->abstractions = btor_hashptr_table_clone (clone->mm,
+                                                  slv->abstractions,
+                                                  btor_clone_key_as_node,
+                                                  btor_clone_data_as_int,
+                                                  exp_map,
+                                                  0);
+
+  if (slv->beta_cache)
+    res->beta_cache =
+        btor_beta_cache_clone (clone->mm, slv->beta_cache, exp_map);
+
+  /* the dual prop clone is not cloned but rebuilt on demand */
+  memset (&res->dp, 0, sizeof (res->dp));
+
   if (slv->score)
   {
     h = btor_opt_get (btor, BTOR_OPT_FUN_JUST_HEURISTIC);
@@ -98,6 +113,42 @@ clone_fun_solver (Btor *clone, BtorFunSolver *slv, BtorNodeMap *exp_map)
   return res;
 }
 
+struct BtorFunDualPropInput
+{
+  BtorBitVector *bv; /* assumed assignment */
+  BtorNode *eq;      /* assumption in the dual prop clone */
+};
+
+typedef struct BtorFunDualPropInput BtorFunDualPropInput;
+
+static void
+delete_dual_prop_clone (BtorFunSolver *slv)
+{
+  assert (slv);
+
+  Btor *btor;
+  BtorFunDualPropInput *input;
+  BtorPtrHashTableIterator it;
+
+  if (!slv->dp.clone) return;
+
+  btor = slv->btor;
+  btor_iter_hashptr_init (&it, slv->dp.inputs);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    input = it.bucket->data.as_ptr;
+    (void) btor_iter_hashptr_next (&it);
+    btor_bv_free (btor->mm, input->bv);
+    btor_node_release (slv->dp.clone, input->eq);
+    BTOR_DELETE (btor->mm, input);
+  }
+  btor_hashptr_table_delete (slv->dp.inputs);
+  btor_nodemap_delete (slv->dp.exp_map);
+  btor_node_release (slv->dp.clone, slv->dp.root);
+  btor_delete (slv->dp.clone);
+  memset (&slv->dp, 0, sizeof (slv->dp));
+}
+
 static void
 delete_fun_solver (BtorFunSolver *slv)
 {
@@ -118,6 +169,18 @@ delete_fun_solver (BtorFunSolver *slv)
     btor_node_release (btor, btor_iter_hashptr_next (&it));
   btor_hashptr_table_delete (slv->lemmas);
 
+  if (slv->abstractions)
+  {
+    btor_iter_hashptr_init (&it, slv->abstractions);
+    while (btor_iter_hashptr_has_next (&it))
+      btor_node_release (btor, btor_iter_hashptr_next (&it));
+    btor_hashptr_table_delete (slv->abstractions);
+  }
+
+  if (slv->beta_cache) btor_beta_cache_delete (btor, slv->beta_cache);
+
+  delete_dual_prop_clone (slv);
+
   if (slv->score)
   {
     btor_iter_hashptr_init (&it, slv->score);
@@ -210,7 +273,7 @@ incremental_required (Btor *btor)
 }
 
 static void
-configure_sat_mgr (Btor *btor)
+configure_sat_mgr (Btor *btor, bool decompose)
 {
   BtorSATMgr *smgr;
 
@@ -220,8 +283,9 @@ configure_sat_mgr (Btor *btor)
   btor_sat_init (smgr);
 
   /* reset SAT solver to non-incremental if all functions have been
-   * eliminated */
+   * eliminated (abstraction refinement requires incremental SAT) */
   if (!btor_opt_get (btor, BTOR_OPT_INCREMENTAL) && smgr->inc_required
+      && !btor_opt_get (btor, BTOR_OPT_FUN_ABSTRACT) && !decompose
       && !incremental_required (btor))
   {
     smgr->inc_required = false;
@@ -331,6 +395,315 @@ get_bv_assignment (Btor *btor, BtorNode *exp)
 
 /*------------------------------------------------------------------------*/
 
+/* Counterexample-guided abstraction of multipliers and dividers.
+ * Abstracted operators are represented by fresh AIG variables constrained by
+ * cheap axioms (zero/one, lsb and bounds; commutativity is guaranteed by
+ * normalization). If the SAT solver assigns a value to an abstracted operator
+ * that is inconsistent with the values of its operands, the operator is
+ * bit-blasted and the result is constrained to be equal to its abstraction.
+ */
+
+static bool
+is_abstractable (Btor *btor, BtorNode *exp)
+{
+  assert (btor_node_is_regular (exp));
+
+  return (btor_node_is_bv_mul (exp) || btor_node_is_bv_udiv (exp)
+          || btor_node_is_bv_urem (exp))
+         && btor_node_bv_get_width (btor, exp)
+                >= btor_opt_get (btor, BTOR_OPT_FUN_ABSTRACT_WIDTH);
+}
+
+BtorAIGVec *
+btor_fun_abstract_exp (Btor *btor, BtorNode *exp)
+{
+  assert (btor);
+  assert (exp);
+  assert (btor_node_is_regular (exp));
+  assert (!exp->av);
+
+  BtorFunSolver *slv;
+  BtorPtrHashBucket *b;
+
+  slv = BTOR_FUN_SOLVER (btor);
+  if (!slv || slv->kind != BTOR_FUN_SOLVER_KIND
+      || !btor_opt_get (btor, BTOR_OPT_FUN_ABSTRACT)
+      || !btor_sat_is_initialized (btor_get_sat_mgr (btor))
+      || !is_abstractable (btor, exp))
+    return 0;
+
+  if (!slv->abstractions)
+    slv->abstractions =
+        btor_hashptr_table_new (btor->mm,
+                                (BtorHashPtr) btor_node_hash_by_id,
+                                (BtorCmpPtr) btor_node_compare_by_id);
+  assert (!btor_hashptr_table_get (slv->abstractions, exp));
+  b = btor_hashptr_table_add (slv->abstractions, btor_node_copy (btor, exp));
+  b->data.as_int = BTOR_FUN_ABSTRACTION_NEW;
+  slv->stats.abstractions++;
+  BTORLOG (2, "abstract: %s", btor_util_node2string (exp));
+  return btor_aigvec_var (btor->avmgr, btor_node_bv_get_width (btor, exp));
+}
+
+static BtorAIGVec *
+get_aigvec (Btor *btor, BtorNode *exp)
+{
+  assert (btor_node_real_addr (exp)->av);
+
+  if (btor_node_is_inverted (exp))
+    return btor_aigvec_not (btor->avmgr, btor_node_real_addr (exp)->av);
+  return btor_aigvec_copy (btor->avmgr, exp->av);
+}
+
+static BtorAIG *
+aigvec_eq (BtorAIGVecMgr *avmgr, BtorAIGVec *av0, BtorAIGVec *av1)
+{
+  BtorAIG *res;
+  BtorAIGVec *eq;
+
+  eq  = btor_aigvec_eq (avmgr, av0, av1);
+  res = btor_aig_copy (btor_aigvec_get_aig_mgr (avmgr), eq->aigs[0]);
+  btor_aigvec_release_delete (avmgr, eq);
+  return res;
+}
+
+static BtorAIG *
+aigvec_ult (BtorAIGVecMgr *avmgr, BtorAIGVec *av0, BtorAIGVec *av1)
+{
+  BtorAIG *res;
+  BtorAIGVec *ult;
+
+  ult = btor_aigvec_ult (avmgr, av0, av1);
+  res = btor_aig_copy (btor_aigvec_get_aig_mgr (avmgr), ult->aigs[0]);
+  btor_aigvec_release_delete (avmgr, ult);
+  return res;
+}
+
+/* Add 'axiom' as top-level constraint and release it.
+ * Note: 'axiom' may simplify to false due to top-level assignments of the SAT
+ * solver, in which case the formula is unsatisfiable. */
+static void
+add_axiom (Btor *btor, BtorAIG *axiom)
+{
+  BtorAIGMgr *amgr;
+
+  amgr = btor_get_aig_mgr (btor);
+  if (axiom == BTOR_AIG_FALSE)
+    btor->found_constraint_false = true;
+  else
+    btor_aig_add_toplevel_to_sat (amgr, axiom);
+  btor_aig_release (amgr, axiom);
+}
+
+/* Add axiom 'a0 -> a1' and release 'a0' and 'a1'. */
+static void
+add_implication (Btor *btor, BtorAIG *a0, BtorAIG *a1)
+{
+  BtorAIGMgr *amgr;
+
+  amgr = btor_get_aig_mgr (btor);
+  add_axiom (btor, btor_aig_or (amgr, BTOR_INVERT_AIG (a0), a1));
+  btor_aig_release (amgr, a0);
+  btor_aig_release (amgr, a1);
+}
+
+static void
+add_abstraction_axioms (Btor *btor, BtorNode *exp)
+{
+  assert (btor_node_is_regular (exp));
+  assert (exp->av);
+
+  uint32_t width;
+  BtorAIGVecMgr *avmgr;
+  BtorAIGMgr *amgr;
+  BtorAIGVec *av0, *av1, *zero, *one, *ones;
+  BtorBitVector *bv;
+  BtorAIG *lsb;
+
+  avmgr = btor->avmgr;
+  amgr  = btor_get_aig_mgr (btor);
+  width = btor_node_bv_get_width (btor, exp);
+  av0   = get_aigvec (btor, exp->e[0]);
+  av1   = get_aigvec (btor, exp->e[1]);
+
+  bv   = btor_bv_new (btor->mm, width);
+  zero = btor_aigvec_const (avmgr, bv);
+  btor_bv_free (btor->mm, bv);
+  bv  = btor_bv_one (btor->mm, width);
+  one = btor_aigvec_const (avmgr, bv);
+  btor_bv_free (btor->mm, bv);
+
+  if (btor_node_is_bv_mul (exp))
+  {
+    /* a = 0 -> a * b = 0,  b = 0 -> a * b = 0 */
+    add_implication (btor,
+                     aigvec_eq (avmgr, av0, zero),
+                     aigvec_eq (avmgr, exp->av, zero));
+    add_implication (btor,
+                     aigvec_eq (avmgr, av1, zero),
+                     aigvec_eq (avmgr, exp->av, zero));
+    /* a = 1 -> a * b = b,  b = 1 -> a * b = a */
+    add_implication (btor,
+                     aigvec_eq (avmgr, av0, one),
+                     aigvec_eq (avmgr, exp->av, av1));
+    add_implication (btor,
+                     aigvec_eq (avmgr, av1, one),
+                     aigvec_eq (avmgr, exp->av, av0));
+    /* (a * b)[0] = a[0] & b[0] */
+    lsb = btor_aig_and (amgr, av0->aigs[width - 1], av1->aigs[width - 1]);
+    add_axiom (btor, btor_aig_eq (amgr, exp->av->aigs[width - 1], lsb));
+    btor_aig_release (amgr, lsb);
+  }
+  else if (btor_node_is_bv_udiv (exp))
+  {
+    bv   = btor_bv_ones (btor->mm, width);
+    ones = btor_aigvec_const (avmgr, bv);
+    btor_bv_free (btor->mm, bv);
+    /* b = 0 -> a / b = ~0 */
+    add_implication (btor,
+                     aigvec_eq (avmgr, av1, zero),
+                     aigvec_eq (avmgr, exp->av, ones));
+    /* b = 1 -> a / b = a */
+    add_implication (btor,
+                     aigvec_eq (avmgr, av1, one),
+                     aigvec_eq (avmgr, exp->av, av0));
+    /* b != 0 -> a / b <= a */
+    add_implication (btor,
+                     BTOR_INVERT_AIG (aigvec_eq (avmgr, av1, zero)),
+                     BTOR_INVERT_AIG (aigvec_ult (avmgr, av0, exp->av)));
+    btor_aigvec_release_delete (avmgr, ones);
+  }
+  else
+  {
+    assert (btor_node_is_bv_urem (exp));
+    /* b = 0 -> a % b = a */
+    add_implication (btor,
+                     aigvec_eq (avmgr, av1, zero),
+                     aigvec_eq (avmgr, exp->av, av0));
+    /* b != 0 -> a % b < b */
+    add_implication (btor,
+                     BTOR_INVERT_AIG (aigvec_eq (avmgr, av1, zero)),
+                     aigvec_ult (avmgr, exp->av, av1));
+    /* a % b <= a */
+    add_axiom (btor, BTOR_INVERT_AIG (aigvec_ult (avmgr, av0, exp->av)));
+  }
+
+  btor_aigvec_release_delete (avmgr, zero);
+  btor_aigvec_release_delete (avmgr, one);
+  btor_aigvec_release_delete (avmgr, av0);
+  btor_aigvec_release_delete (avmgr, av1);
+}
+
+/* Add axioms for all new abstractions. */
+static void
+add_abstractions_axioms (Btor *btor)
+{
+  BtorFunSolver *slv;
+  BtorPtrHashTableIterator it;
+  BtorPtrHashBucket *b;
+  BtorNode *cur;
+
+  slv = BTOR_FUN_SOLVER (btor);
+  if (!slv->abstractions) return;
+
+  btor_iter_hashptr_init (&it, slv->abstractions);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    b   = it.bucket;
+    cur = btor_iter_hashptr_next (&it);
+    if (b->data.as_int != BTOR_FUN_ABSTRACTION_NEW) continue;
+    add_abstraction_axioms (btor, cur);
+    b->data.as_int = BTOR_FUN_ABSTRACTION_AXIOMS;
+  }
+}
+
+static BtorBitVector *
+get_synth_assignment (Btor *btor, BtorNode *exp)
+{
+  BtorBitVector *bv, *res;
+
+  bv = btor_bv_get_assignment (btor->mm, btor_node_real_addr (exp));
+  if (!btor_node_is_inverted (exp)) return bv;
+  res = btor_bv_not (btor->mm, bv);
+  btor_bv_free (btor->mm, bv);
+  return res;
+}
+
+/* Check the current SAT assignment of all abstracted operators and bit-blast
+ * operators with inconsistent assignments. Returns the number of refined
+ * abstractions. */
+static uint32_t
+refine_abstractions (Btor *btor)
+{
+  uint32_t res;
+  double start;
+  BtorFunSolver *slv;
+  BtorPtrHashTableIterator it;
+  BtorPtrHashBucket *b;
+  BtorNode *cur;
+  BtorAIGVecMgr *avmgr;
+  BtorAIGVec *av0, *av1, *av;
+  BtorBitVector *bv0, *bv1, *bv, *bvexp;
+
+  slv = BTOR_FUN_SOLVER (btor);
+  if (!slv->abstractions) return 0;
+
+  start = btor_util_time_stamp ();
+  res   = 0;
+  avmgr = btor->avmgr;
+
+  btor_iter_hashptr_init (&it, slv->abstractions);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    b   = it.bucket;
+    cur = btor_iter_hashptr_next (&it);
+    if (b->data.as_int == BTOR_FUN_ABSTRACTION_REFINED) continue;
+
+    bv0 = get_synth_assignment (btor, cur->e[0]);
+    bv1 = get_synth_assignment (btor, cur->e[1]);
+    bv  = get_synth_assignment (btor, cur);
+    if (btor_node_is_bv_mul (cur))
+      bvexp = btor_bv_mul (btor->mm, bv0, bv1);
+    else if (btor_node_is_bv_udiv (cur))
+      bvexp = btor_bv_udiv (btor->mm, bv0, bv1);
+    else
+    {
+      assert (btor_node_is_bv_urem (cur));
+      bvexp = btor_bv_urem (btor->mm, bv0, bv1);
+    }
+
+    if (btor_bv_compare (bv, bvexp))
+    {
+      BTORLOG (1, "refine: %s", btor_util_node2string (cur));
+      av0 = get_aigvec (btor, cur->e[0]);
+      av1 = get_aigvec (btor, cur->e[1]);
+      if (btor_node_is_bv_mul (cur))
+        av = btor_aigvec_mul (avmgr, av0, av1);
+      else if (btor_node_is_bv_udiv (cur))
+        av = btor_aigvec_udiv (avmgr, av0, av1);
+      else
+        av = btor_aigvec_urem (avmgr, av0, av1);
+      add_axiom (btor, aigvec_eq (avmgr, cur->av, av));
+      btor_aigvec_release_delete (avmgr, av);
+      btor_aigvec_release_delete (avmgr, av0);
+      btor_aigvec_release_delete (avmgr, av1);
+      b->data.as_int = BTOR_FUN_ABSTRACTION_REFINED;
+      slv->stats.abstraction_refinements++;
+      res++;
+    }
+
+    btor_bv_free (btor->mm, bv0);
+    btor_bv_free (btor->mm, bv1);
+    btor_bv_free (btor->mm, bv);
+    btor_bv_free (btor->mm, bvexp);
+  }
+
+  slv->time.abstraction_refinement += btor_util_time_stamp () - start;
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
 static Btor *
 new_exp_layer_clone_for_dual_prop (Btor *btor,
                                    BtorNodeMap **exp_map,
@@ -361,13 +734,18 @@ new_exp_layer_clone_for_dual_prop (Btor *btor,
   //  btor_opt_set (clone, BTOR_OPT_LOGLEVEL, 0);
   //  btor_opt_set (clone, BTOR_OPT_VERBOSITY, 0);
   btor_opt_set (clone, BTOR_OPT_FUN_DUAL_PROP, 0);
+  btor_opt_set (clone, BTOR_OPT_FUN_ABSTRACT, 0);
 
   assert (!btor_sat_is_initialized (btor_get_sat_mgr (clone)));
   btor_opt_set_str (clone, BTOR_OPT_SAT_ENGINE, "plain=1");
-  configure_sat_mgr (clone);
+  configure_sat_mgr (clone, false);
+
+  btor_iter_hashptr_init (&it, clone->assumptions);
+  while (btor_iter_hashptr_has_next (&it))
+    btor_node_real_addr (btor_iter_hashptr_next (&it))->constraint = 0;
 
+  /* assumptions are added to the root of each sat call separately */
   btor_iter_hashptr_init (&it, clone->unsynthesized_constraints);
-  btor_iter_hashptr_queue (&it, clone->assumptions);
   while (btor_iter_hashptr_has_next (&it))
   {
     cur                                   = btor_iter_hashptr_next (&it);
@@ -404,6 +782,96 @@ new_exp_layer_clone_for_dual_prop (Btor *btor,
   return clone;
 }
 
+static uint32_t
+count_simplified (BtorNodeMap *exp_map)
+{
+  uint32_t res;
+  BtorNodeMapIterator it;
+
+  res = 0;
+  btor_iter_nodemap_init (&it, exp_map);
+  while (btor_iter_nodemap_has_next (&it))
+    res += btor_node_is_simplified (btor_iter_nodemap_next (&it));
+  return res;
+}
+
+/* Returns the dual prop clone and the conjunction 'root' of the constraints
+ * and assumptions of the current sat call in the clone.
+ * In incremental mode, the clone is kept across sat calls and only
+ * constraints asserted since the last call are added. It is rebuilt if
+ * expressions it was created from got simplified in the meantime. */
+static Btor *
+get_dual_prop_clone (Btor *btor, BtorNode **root)
+{
+  assert (btor);
+  assert (btor->slv);
+  assert (btor->slv->kind == BTOR_FUN_SOLVER_KIND);
+  assert (root);
+
+  double start;
+  BtorFunSolver *slv;
+  Btor *clone;
+  BtorNode *cur, *and;
+  BtorPtrHashTableIterator it;
+
+  slv = BTOR_FUN_SOLVER (btor);
+
+  if (slv->dp.clone
+      && count_simplified (slv->dp.exp_map) != slv->dp.num_simplified)
+    delete_dual_prop_clone (slv);
+
+  if (!slv->dp.clone)
+  {
+    slv->dp.clone = new_exp_layer_clone_for_dual_prop (
+        btor, &slv->dp.exp_map, &slv->dp.root);
+    if (!slv->dp.clone) return 0;
+    slv->dp.inputs = btor_hashptr_table_new (
+        btor->mm,
+        (BtorHashPtr) btor_node_hash_by_id,
+        (BtorCmpPtr) btor_node_compare_by_id);
+    slv->dp.num_simplified = count_simplified (slv->dp.exp_map);
+  }
+  else
+  {
+    start = btor_util_time_stamp ();
+    slv->stats.dp_clone_reuses++;
+    clone = slv->dp.clone;
+    btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+    while (btor_iter_hashptr_has_next (&it))
+    {
+      cur = btor_clone_recursively_rebuild_exp (
+          btor,
+          clone,
+          btor_iter_hashptr_next (&it),
+          slv->dp.exp_map,
+          btor_opt_get (clone, BTOR_OPT_REWRITE_LEVEL));
+      and = btor_exp_bv_and (clone, slv->dp.root, cur);
+      btor_node_release (clone, cur);
+      btor_node_release (clone, slv->dp.root);
+      slv->dp.root = and;
+    }
+    slv->time.search_init_apps_cloning += btor_util_time_stamp () - start;
+  }
+
+  clone = slv->dp.clone;
+  *root = btor_node_copy (clone, slv->dp.root);
+  btor_iter_hashptr_init (&it, btor->assumptions);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    cur = btor_clone_recursively_rebuild_exp (
+        btor,
+        clone,
+        btor_iter_hashptr_next (&it),
+        slv->dp.exp_map,
+        btor_opt_get (clone, BTOR_OPT_REWRITE_LEVEL));
+    and = btor_exp_bv_and (clone, *root, cur);
+    btor_node_release (clone, cur);
+    btor_node_release (clone, *root);
+    *root = and;
+  }
+  return clone;
+}
+
 static void
 assume_inputs (Btor *btor,
                Btor *clone,
@@ -423,6 +891,11 @@ assume_inputs (Btor *btor,
   uint32_t i;
   BtorNode *cur_btor, *cur_clone, *bv_const, *bv_eq;
   BtorBitVector *bv;
+  BtorFunSolver *slv;
+  BtorFunDualPropInput *input;
+  BtorPtrHashBucket *b;
+
+  slv = BTOR_FUN_SOLVER (btor);
 
   for (i = 0; i < BTOR_COUNT_STACK (*inputs); i++)
   {
@@ -434,18 +907,44 @@ assume_inputs (Btor *btor,
     btor_nodemap_map (key_map, cur_clone, cur_btor);
 
     assert (btor_node_is_regular (cur_btor));
-    bv       = get_bv_assignment (btor, cur_btor);
-    bv_const = btor_exp_bv_const (clone, bv);
-    btor_bv_free (btor->mm, bv);
-    bv_eq = btor_exp_eq (clone, cur_clone, bv_const);
-    BTORLOG (1,
-             "assume input: %s (%s = %s)",
-             btor_util_node2string (bv_eq),
-             btor_util_node2string (cur_btor),
-             btor_util_node2string (bv_const));
+    bv = get_bv_assignment (btor, cur_btor);
+
+    /* reuse assumption if the assignment did not change since the last
+     * refinement round (or sat call) */
+    b     = btor_hashptr_table_get (slv->dp.inputs, cur_clone);
+    input = b ? b->data.as_ptr : 0;
+    if (input && !btor_bv_compare (bv, input->bv))
+    {
+      btor_bv_free (btor->mm, bv);
+      bv_eq = btor_node_copy (clone, input->eq);
+      slv->stats.dp_reused_inputs++;
+    }
+    else
+    {
+      bv_const = btor_exp_bv_const (clone, bv);
+      bv_eq    = btor_exp_eq (clone, cur_clone, bv_const);
+      BTORLOG (1,
+               "assume input: %s (%s = %s)",
+               btor_util_node2string (bv_eq),
+               btor_util_node2string (cur_btor),
+               btor_util_node2string (bv_const));
+      btor_node_release (clone, bv_const);
+      if (input)
+      {
+        btor_bv_free (btor->mm, input->bv);
+        btor_node_release (clone, input->eq);
+      }
+      else
+      {
+        BTOR_NEW (btor->mm, input);
+        btor_hashptr_table_add (slv->dp.inputs, cur_clone)->data.as_ptr =
+            input;
+      }
+      input->bv = bv;
+      input->eq = btor_node_copy (clone, bv_eq);
+    }
     btor_assume_exp (clone, bv_eq);
     btor_nodemap_map (assumptions, bv_eq, cur_clone);
-    btor_node_release (clone, bv_const);
     btor_node_release (clone, bv_eq);
   }
 }
@@ -581,7 +1080,7 @@ sat_aux_btor_dual_prop (Btor *btor)
   if (btor->inconsistent) goto DONE;
 
   BTOR_MSG (btor->msg, 1, "calling SAT");
-  configure_sat_mgr (btor);
+  configure_sat_mgr (btor, false);
 
   if (btor->valid_assignments == 1) btor_reset_incremental_usage (btor);
 
@@ -918,15 +1417,26 @@ add_lemma_to_dual_prop_clone (Btor *btor,
   assert (lemma);
 
   BtorNode *clemma, *and;
+  BtorFunSolver *slv;
+
+  slv = BTOR_FUN_SOLVER (btor);
 
   /* clone and rebuild lemma with rewrite level 0 (as we want the exact
    * expression) */
   clemma = btor_clone_recursively_rebuild_exp (btor, clone, lemma, exp_map, 0);
   assert (clemma);
   and = btor_exp_bv_and (clone, *root, clemma);
-  btor_node_release (clone, clemma);
   btor_node_release (clone, *root);
   *root = and;
+  /* asserted lemmas also hold in subsequent sat calls */
+  if (!slv->assume_lemmas)
+  {
+    assert (clone == slv->dp.clone);
+    and = btor_exp_bv_and (clone, slv->dp.root, clemma);
+    btor_node_release (clone, slv->dp.root);
+    slv->dp.root = and;
+  }
+  btor_node_release (clone, clemma);
 }
 
 /*------------------------------------------------------------------------*/
@@ -1477,9 +1987,15 @@ add_lemma (Btor *btor, BtorNode *fun, BtorNode *app1, BtorNode *app2)
   {
     assert (btor_node_is_lambda (fun));
 
-    btor_beta_assign_args (btor, fun, app1->e[1]);
-    value = btor_beta_reduce_partial (btor, fun, 0);
-    btor_beta_unassign_params (btor, fun);
+    if (slv->beta_cache)
+      value = btor_beta_reduce_partial_cached (
+          btor, fun, app1->e[1], 0, slv->beta_cache);
+    else
+    {
+      btor_beta_assign_args (btor, fun, app1->e[1]);
+      value = btor_beta_reduce_partial (btor, fun, 0);
+      btor_beta_unassign_params (btor, fun);
+    }
     assert (!btor_node_is_lambda (value));
 
     /* path from conflicting fun to value */
@@ -1824,10 +2340,16 @@ propagate (Btor *btor,
     conds = btor_hashptr_table_new (mm,
                                     (BtorHashPtr) btor_node_hash_by_id,
                                     (BtorCmpPtr) btor_node_compare_by_id);
-    btor_beta_assign_args (btor, fun, args);
-    fun_value = btor_beta_reduce_partial (btor, fun, conds);
+    if (slv->beta_cache)
+      fun_value = btor_beta_reduce_partial_cached (
+          btor, fun, args, conds, slv->beta_cache);
+    else
+    {
+      btor_beta_assign_args (btor, fun, args);
+      fun_value = btor_beta_reduce_partial (btor, fun, conds);
+      btor_beta_unassign_params (btor, fun);
+    }
     assert (!btor_node_is_fun (fun_value));
-    btor_beta_unassign_params (btor, fun);
 
     prop_down = false;
     if (!btor_node_is_inverted (fun_value) && btor_node_is_apply (fun_value))
@@ -2228,13 +2750,204 @@ push_unreachable_applies (Btor *btor, BtorNodePtrStack *init_apps)
   btor_hashint_table_delete (cache);
 }
 
+/* Remove assignments derived via evaluation from the bit vector model if
+ * their cone contains an input or synthesized node in 'changed' or without
+ * an assignment. Returns the number of removed assignments. */
+static uint32_t
+invalidate_derived_assignments (Btor *btor, BtorIntHashTable *changed)
+{
+  assert (btor);
+  assert (btor->bv_model);
+  assert (changed);
+
+  int32_t id;
+  uint32_t i, j, res;
+  bool dirty;
+  BtorNode *cur, *real_cur;
+  BtorNodePtrStack derived, visit;
+  BtorHashTableData *d;
+  BtorIntHashTable *cache;
+  BtorIntHashTableIterator it;
+  BtorMemMgr *mm;
+
+  mm    = btor->mm;
+  res   = 0;
+  cache = btor_hashint_map_new (mm);
+  BTOR_INIT_STACK (mm, derived);
+  BTOR_INIT_STACK (mm, visit);
+
+  btor_iter_hashint_init (&it, btor->bv_model);
+  while (btor_iter_hashint_has_next (&it))
+  {
+    id = btor_iter_hashint_next (&it);
+    if (id < 0) continue;
+    cur = btor_node_get_by_id (btor, id);
+    if (btor_node_is_bv_const (cur) || btor_node_is_synth (cur)
+        || btor_node_is_bv_var (cur) || btor_node_is_apply (cur)
+        || btor_node_is_fun_eq (cur))
+      continue;
+    BTOR_PUSH_STACK (derived, cur);
+  }
+
+  for (i = 0; i < BTOR_COUNT_STACK (derived); i++)
+  {
+    BTOR_PUSH_STACK (visit, BTOR_PEEK_STACK (derived, i));
+    while (!BTOR_EMPTY_STACK (visit))
+    {
+      real_cur = btor_node_real_addr (
+          btor_node_get_simplified (btor, BTOR_POP_STACK (visit)));
+      d = btor_hashint_map_get (cache, real_cur->id);
+
+      if (!d)
+      {
+        d = btor_hashint_map_add (cache, real_cur->id);
+        if (btor_node_is_bv_const (real_cur))
+        {
+          d->as_int = 0;
+          continue;
+        }
+        /* leaves of the evaluation */
+        if (btor_node_is_bv_var (real_cur) || btor_node_is_apply (real_cur)
+            || btor_node_is_fun_eq (real_cur)
+            || (btor_node_is_synth (real_cur)
+                && btor_hashint_map_contains (btor->bv_model, real_cur->id)))
+        {
+          d->as_int =
+              !btor_hashint_map_contains (btor->bv_model, real_cur->id)
+              || btor_hashint_table_contains (changed, real_cur->id);
+          continue;
+        }
+        d->as_int = -1;
+        BTOR_PUSH_STACK (visit, real_cur);
+        for (j = 0; j < real_cur->arity; j++)
+          BTOR_PUSH_STACK (visit, real_cur->e[j]);
+      }
+      else if (d->as_int == -1)
+      {
+        dirty = false;
+        for (j = 0; j < real_cur->arity && !dirty; j++)
+        {
+          cur   = btor_node_real_addr (
+              btor_node_get_simplified (btor, real_cur->e[j]));
+          dirty = btor_hashint_map_get (cache, cur->id)->as_int == 1;
+        }
+        d->as_int = dirty;
+      }
+    }
+  }
+
+  /* remove after all cones are checked since the leaves are determined
+   * via the model */
+  for (i = 0; i < BTOR_COUNT_STACK (derived); i++)
+  {
+    cur = BTOR_PEEK_STACK (derived, i);
+    if (btor_hashint_map_get (cache, cur->id)->as_int != 1) continue;
+    btor_model_remove_from_bv (btor, btor->bv_model, cur);
+    res++;
+  }
+
+  BTOR_RELEASE_STACK (derived);
+  BTOR_RELEASE_STACK (visit);
+  btor_hashint_map_delete (cache);
+  return res;
+}
+
+/* Update the bit vector model of the previous refinement round to the
+ * current SAT assignment. Assignments of inputs and synthesized nodes are
+ * re-read and compared, assignments derived via evaluation are only kept if
+ * none of the assignments they were derived from changed. */
+static void
+update_bv_model (Btor *btor)
+{
+  assert (btor);
+  assert (btor->slv);
+  assert (btor->slv->kind == BTOR_FUN_SOLVER_KIND);
+  assert (btor->bv_model);
+
+  int32_t id;
+  uint32_t i, invalidated;
+  BtorNode *cur;
+  BtorNodePtrStack nodes, inverted;
+  BtorBitVector *bv;
+  BtorFunSolver *slv;
+  BtorHashTableData *d, data;
+  BtorIntHashTable *changed;
+  BtorIntHashTableIterator it;
+  BtorMemMgr *mm;
+
+  mm      = btor->mm;
+  slv     = BTOR_FUN_SOLVER (btor);
+  changed = btor_hashint_table_new (mm);
+  BTOR_INIT_STACK (mm, nodes);
+  BTOR_INIT_STACK (mm, inverted);
+
+  btor_iter_hashint_init (&it, btor->bv_model);
+  while (btor_iter_hashint_has_next (&it))
+  {
+    id = btor_iter_hashint_next (&it);
+    if (id < 0)
+      BTOR_PUSH_STACK (inverted, btor_node_get_by_id (btor, -id));
+    else
+      BTOR_PUSH_STACK (nodes, btor_node_get_by_id (btor, id));
+  }
+
+  /* assignments of inverted nodes are only cached during model generation */
+  for (i = 0; i < BTOR_COUNT_STACK (inverted); i++)
+  {
+    cur = BTOR_PEEK_STACK (inverted, i);
+    btor_hashint_map_remove (btor->bv_model, -cur->id, &data);
+    btor_bv_free (mm, data.as_ptr);
+    btor_node_release (btor, cur);
+  }
+
+  invalidated = 0;
+  for (i = 0; i < BTOR_COUNT_STACK (nodes); i++)
+  {
+    cur = BTOR_PEEK_STACK (nodes, i);
+    assert (btor_node_is_regular (cur));
+    if (btor_node_is_simplified (cur))
+    {
+      btor_hashint_table_add (changed, cur->id);
+      btor_model_remove_from_bv (btor, btor->bv_model, cur);
+      invalidated++;
+      continue;
+    }
+    /* inputs and synthesized nodes get their assignment from the SAT
+     * solver */
+    if (btor_node_is_bv_const (cur)
+        || (!btor_node_is_synth (cur) && !btor_node_is_bv_var (cur)
+            && !btor_node_is_apply (cur) && !btor_node_is_fun_eq (cur)))
+      continue;
+    d  = btor_hashint_map_get (btor->bv_model, cur->id);
+    bv = btor_bv_get_assignment (mm, cur);
+    if (btor_bv_compare (bv, d->as_ptr))
+    {
+      btor_hashint_table_add (changed, cur->id);
+      btor_bv_free (mm, d->as_ptr);
+      d->as_ptr = bv;
+      invalidated++;
+    }
+    else
+      btor_bv_free (mm, bv);
+  }
+  invalidated += invalidate_derived_assignments (btor, changed);
+
+  slv->stats.inc_check_invalidated += invalidated;
+  slv->stats.inc_check_kept += BTOR_COUNT_STACK (nodes) - invalidated;
+
+  BTOR_RELEASE_STACK (nodes);
+  BTOR_RELEASE_STACK (inverted);
+  btor_hashint_table_delete (changed);
+}
+
 static void
 check_and_resolve_conflicts (Btor *btor,
                              Btor *clone,
                              BtorNode *clone_root,
                              BtorNodeMap *exp_map,
                              BtorNodePtrStack *init_apps,
-                             BtorIntHashTable *init_apps_cache)
+                             BtorIntHashTable *init_apps_cache,
+                             bool update_model)
 {
   assert (btor);
   assert (btor->slv);
@@ -2249,7 +2962,7 @@ check_and_resolve_conflicts (Btor *btor,
   BtorNodePtrStack prop_stack;
   BtorNodePtrStack top_applies;
   BtorPtrHashTable *cleanup_table;
-  BtorIntHashTable *apply_search_cache;
+  BtorIntHashTable *apply_search_cache, *removed;
   BtorPtrHashTableIterator pit;
   BtorIntHashTableIterator iit;
 
@@ -2262,8 +2975,13 @@ check_and_resolve_conflicts (Btor *btor,
                                           (BtorCmpPtr) btor_node_compare_by_id);
 
   /* initialize new bit vector model, which will be constructed while
-   * consistency checking. this also deletes the model from the previous run */
-  btor_model_init_bv (btor, &btor->bv_model);
+   * consistency checking. this also deletes the model from the previous run.
+   * in later refinement rounds, the model of the previous round is updated
+   * to the current assignment instead */
+  if (update_model && btor->bv_model)
+    update_bv_model (btor);
+  else
+    btor_model_init_bv (btor, &btor->bv_model);
 
   BTOR_INIT_STACK (mm, prop_stack);
   BTOR_INIT_STACK (mm, top_applies);
@@ -2340,13 +3058,22 @@ check_and_resolve_conflicts (Btor *btor,
    * model construction */
   if (!found_conflicts)
   {
+    removed = btor_hashint_table_new (mm);
     btor_iter_hashint_init (&iit, btor->bv_model);
     while (btor_iter_hashint_has_next (&iit))
     {
       cur = btor_node_get_by_id (btor, btor_iter_hashint_next (&iit));
       if (btor_node_is_apply (cur) && !cur->propagated)
+      {
+        btor_hashint_table_add (removed, cur->id);
         btor_model_remove_from_bv (btor, btor->bv_model, cur);
+      }
     }
+    /* assignments kept from previous rounds may have been derived from
+     * these applies without propagating them in this round */
+    if (update_model && removed->count)
+      invalidate_derived_assignments (btor, removed);
+    btor_hashint_table_delete (removed);
   }
 
   start_cleanup = btor_util_time_stamp ();
@@ -2406,6 +3133,184 @@ reset_lemma_cache (BtorFunSolver *slv)
                                         (BtorCmpPtr) btor_node_compare_by_id);
 }
 
+/*------------------------------------------------------------------------*/
+
+struct BtorFunComponentConstraint
+{
+  BtorNode *exp; /* constraint */
+  int32_t repr;  /* id of the representative of its component */
+  uint32_t size; /* size of its component */
+};
+
+typedef struct BtorFunComponentConstraint BtorFunComponentConstraint;
+
+static int32_t
+compare_component_constraints (const void *a, const void *b)
+{
+  const BtorFunComponentConstraint *ca, *cb;
+
+  ca = (const BtorFunComponentConstraint *) a;
+  cb = (const BtorFunComponentConstraint *) b;
+
+  if (ca->size != cb->size) return ca->size < cb->size ? -1 : 1;
+  if (ca->repr != cb->repr) return ca->repr < cb->repr ? -1 : 1;
+  return btor_node_get_id (ca->exp) - btor_node_get_id (cb->exp);
+}
+
+/* Partition the unsynthesized constraints into components that do not share
+ * any non-constant node (and hence no variable or function).  The
+ * constraints are pushed onto 'constraints' grouped by component and in
+ * order of increasing component size, 'starts' holds the index of the first
+ * constraint of each component. */
+static void
+collect_components (Btor *btor,
+                    BtorNodePtrStack *constraints,
+                    BtorUIntStack *starts)
+{
+  assert (btor);
+  assert (constraints);
+  assert (starts);
+  assert (BTOR_EMPTY_STACK (*constraints));
+  assert (BTOR_EMPTY_STACK (*starts));
+
+  uint32_t i, j, n, size;
+  double start, delta;
+  BtorNode *cur, *root, *owner;
+  BtorNodePtrStack visit;
+  BtorPtrHashTableIterator it;
+  BtorIntHashTable *owners, *sizes;
+  BtorHashTableData *d;
+  BtorUnionFind *ufind;
+  BtorFunComponentConstraint *cc;
+  BtorMemMgr *mm;
+
+  start = btor_util_time_stamp ();
+  mm    = btor->mm;
+  n     = btor->unsynthesized_constraints->count;
+  if (n < 2) return;
+
+  BTOR_INIT_STACK (mm, visit);
+  BTOR_CNEWN (mm, cc, n);
+  ufind  = btor_ufind_new (mm);
+  owners = btor_hashint_map_new (mm);
+  sizes  = btor_hashint_map_new (mm);
+
+  /* every node is owned by the first constraint that reaches it, constraints
+   * reaching a node owned by another constraint are merged */
+  i = 0;
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    cc[i].exp = btor_iter_hashptr_next (&it);
+    root      = btor_node_real_addr (cc[i++].exp);
+    btor_ufind_add (ufind, root);
+    size = 0;
+    BTOR_PUSH_STACK (visit, root);
+    while (!BTOR_EMPTY_STACK (visit))
+    {
+      cur = btor_node_real_addr (BTOR_POP_STACK (visit));
+      if (btor_node_is_bv_const (cur)) continue;
+      if ((d = btor_hashint_map_get (owners, cur->id)))
+      {
+        owner = d->as_ptr;
+        if (owner != root) btor_ufind_merge (ufind, root, owner);
+        continue;
+      }
+      btor_hashint_map_add (owners, cur->id)->as_ptr = root;
+      size++;
+      for (j = 0; j < cur->arity; j++) BTOR_PUSH_STACK (visit, cur->e[j]);
+    }
+    if ((d = btor_hashint_map_get (sizes, root->id)))
+      d->as_int += size;
+    else
+      btor_hashint_map_add (sizes, root->id)->as_int = size;
+  }
+  assert (i == n);
+
+  /* accumulate component sizes at their representatives */
+  for (i = 0; i < n; i++)
+  {
+    root       = btor_node_real_addr (cc[i].exp);
+    cc[i].repr = btor_node_get_id (btor_ufind_get_repr (ufind, root));
+    if (cc[i].repr == root->id) continue;
+    d = btor_hashint_map_get (sizes, root->id);
+    if (!d) continue;
+    size = d->as_int;
+    btor_hashint_map_remove (sizes, root->id, 0);
+    if ((d = btor_hashint_map_get (sizes, cc[i].repr)))
+      d->as_int += size;
+    else
+      btor_hashint_map_add (sizes, cc[i].repr)->as_int = size;
+  }
+  for (i = 0; i < n; i++)
+    cc[i].size = btor_hashint_map_get (sizes, cc[i].repr)->as_int;
+
+  qsort (cc, n, sizeof (*cc), compare_component_constraints);
+  for (i = 0; i < n; i++)
+  {
+    if (i == 0 || cc[i].repr != cc[i - 1].repr) BTOR_PUSH_STACK (*starts, i);
+    BTOR_PUSH_STACK (*constraints, cc[i].exp);
+  }
+
+  btor_hashint_map_delete (sizes);
+  btor_hashint_map_delete (owners);
+  btor_ufind_delete (ufind);
+  BTOR_DELETEN (mm, cc, n);
+  BTOR_RELEASE_STACK (visit);
+
+  delta = btor_util_time_stamp () - start;
+  BTOR_FUN_SOLVER (btor)->stats.components += BTOR_COUNT_STACK (*starts);
+  BTOR_FUN_SOLVER (btor)->time.decompose += delta;
+  BTOR_MSG (btor->msg,
+            1,
+            "found %u independent components in %.3f seconds",
+            BTOR_COUNT_STACK (*starts),
+            delta);
+}
+
+/* Bit-blast and check the components collected by collect_components one at
+ * a time.  The largest (last) component is left for the main refinement
+ * loop, which checks it together with all other constraints.  Returns
+ * BTOR_RESULT_UNSAT as soon as a component is unsatisfiable. */
+static BtorSolverResult
+solve_components (Btor *btor,
+                  BtorNodePtrStack *constraints,
+                  BtorUIntStack *starts)
+{
+  assert (btor);
+  assert (constraints);
+  assert (starts);
+  assert (BTOR_COUNT_STACK (*starts) > 1);
+
+  uint32_t i, j, end;
+  BtorFunSolver *slv;
+  BtorSolverResult res;
+
+  slv = BTOR_FUN_SOLVER (btor);
+  res = BTOR_RESULT_SAT;
+
+  for (i = 0; i + 1 < BTOR_COUNT_STACK (*starts); i++)
+  {
+    end = BTOR_PEEK_STACK (*starts, i + 1);
+    for (j = BTOR_PEEK_STACK (*starts, i); j < end; j++)
+    {
+      btor_process_unsynthesized_constraint (btor,
+                                             BTOR_PEEK_STACK (*constraints, j));
+      if (btor->found_constraint_false) return BTOR_RESULT_UNSAT;
+    }
+    add_abstractions_axioms (btor);
+
+    BTORLOG (1,
+             "check component %u with %u constraints",
+             i,
+             end - BTOR_PEEK_STACK (*starts, i));
+    slv->stats.component_checks++;
+    res = timed_sat_sat (btor, slv->sat_limit);
+    if (res != BTOR_RESULT_SAT) break;
+  }
+  return res;
+}
+
 static BtorSolverResult
 sat_fun_solver (BtorFunSolver *slv)
 {
@@ -2415,25 +3320,30 @@ sat_fun_solver (BtorFunSolver *slv)
   assert (slv->btor->slv == (BtorSolver *) slv);
 
   uint32_t i;
-  bool done;
+  bool done, update_model;
   BtorSolverResult result;
   Btor *btor, *clone;
   BtorNode *clone_root, *lemma;
   BtorNodeMap *exp_map;
   BtorIntHashTable *init_apps_cache;
-  BtorNodePtrStack init_apps;
+  BtorNodePtrStack init_apps, comp_constraints;
+  BtorUIntStack comp_starts;
 
   btor = slv->btor;
   assert (!btor->inconsistent);
 
+  BTOR_INIT_STACK (btor->mm, comp_constraints);
+  BTOR_INIT_STACK (btor->mm, comp_starts);
+
   /* make initial applies in bv skeleton global in order to prevent
    * traversing the whole formula every refinement round */
   BTOR_INIT_STACK (btor->mm, init_apps);
   init_apps_cache = btor_hashint_table_new (btor->mm);
 
-  clone      = 0;
-  clone_root = 0;
-  exp_map    = 0;
+  clone        = 0;
+  clone_root   = 0;
+  exp_map      = 0;
+  update_model = false;
 
   if ((btor_opt_get (btor, BTOR_OPT_FUN_PREPROP)
        || btor_opt_get (btor, BTOR_OPT_FUN_PRESLS))
@@ -2487,7 +3397,20 @@ sat_fun_solver (BtorFunSolver *slv)
     goto DONE;
   }
 
-  configure_sat_mgr (btor);
+  if (btor_opt_get (btor, BTOR_OPT_FUN_DECOMPOSE)
+      && !btor_opt_get (btor, BTOR_OPT_PRINT_DIMACS))
+  {
+    collect_components (btor, &comp_constraints, &comp_starts);
+  }
+
+  configure_sat_mgr (btor, BTOR_COUNT_STACK (comp_starts) > 1);
+
+  if (btor_opt_get (btor, BTOR_OPT_FUN_BETA_CACHE))
+  {
+    if (!slv->beta_cache) slv->beta_cache = btor_beta_cache_new (btor);
+    slv->stats.beta_cache_evictions +=
+        btor_beta_cache_evict (btor, slv->beta_cache);
+  }
 
   if (slv->assume_lemmas) reset_lemma_cache (slv);
 
@@ -2496,7 +3419,21 @@ sat_fun_solver (BtorFunSolver *slv)
   /* initialize dual prop clone */
   if (btor_opt_get (btor, BTOR_OPT_FUN_DUAL_PROP))
   {
-    clone = new_exp_layer_clone_for_dual_prop (btor, &exp_map, &clone_root);
+    clone   = get_dual_prop_clone (btor, &clone_root);
+    exp_map = slv->dp.exp_map;
+  }
+  else
+    delete_dual_prop_clone (slv);
+
+  /* check independent components separately, an unsatisfiable component
+   * makes the whole formula unsatisfiable without bit-blasting the rest */
+  if (BTOR_COUNT_STACK (comp_starts) > 1)
+  {
+    result = solve_components (btor, &comp_constraints, &comp_starts);
+    if (result == BTOR_RESULT_UNKNOWN) goto DONE;
+    /* with assumptions, the main loop determines the failed assumptions */
+    if (result == BTOR_RESULT_UNSAT && btor->assumptions->count == 0)
+      goto DONE;
   }
 
   while (true)
@@ -2509,6 +3446,7 @@ sat_fun_solver (BtorFunSolver *slv)
     }
 
     btor_process_unsynthesized_constraints (btor);
+    add_abstractions_axioms (btor);
     if (btor->found_constraint_false)
     {
     UNSAT:
@@ -2534,10 +3472,19 @@ sat_fun_solver (BtorFunSolver *slv)
 
     assert (result == BTOR_RESULT_SAT);
 
+    /* bit-blast abstracted operators with inconsistent assignment */
+    if (refine_abstractions (btor)) continue;
+
     if (btor->ufs->count == 0 && btor->lambdas->count == 0) break;
 
-    check_and_resolve_conflicts (
-        btor, clone, clone_root, exp_map, &init_apps, init_apps_cache);
+    check_and_resolve_conflicts (btor,
+                                 clone,
+                                 clone_root,
+                                 exp_map,
+                                 &init_apps,
+                                 init_apps_cache,
+                                 update_model);
+    update_model = btor_opt_get (btor, BTOR_OPT_FUN_INC_CHECK) > 0;
     if (BTOR_EMPTY_STACK (slv->cur_lemmas)) break;
     slv->stats.refinement_iterations++;
 
@@ -2577,13 +3524,15 @@ sat_fun_solver (BtorFunSolver *slv)
 DONE:
   BTOR_RELEASE_STACK (init_apps);
   btor_hashint_table_delete (init_apps_cache);
+  BTOR_RELEASE_STACK (comp_constraints);
+  BTOR_RELEASE_STACK (comp_starts);
 
   if (clone)
   {
     assert (exp_map);
-    btor_nodemap_delete (exp_map);
     btor_node_release (clone, clone_root);
-    btor_delete (clone);
+    if (!btor_opt_get (btor, BTOR_OPT_INCREMENTAL))
+      delete_dual_prop_clone (slv);
   }
   return result;
 }
@@ -2679,6 +3628,47 @@ print_stats_fun_solver (BtorFunSolver *slv)
   BTOR_MSG (
       btor->msg, 1, "%7lld propagations down", slv->stats.propagations_down);
 
+  if (slv->stats.abstractions)
+  {
+    BTOR_MSG (btor->msg,
+              1,
+              "%d/%d abstracted operators (refined/total)",
+              slv->stats.abstraction_refinements,
+              slv->stats.abstractions);
+  }
+
+  if (slv->beta_cache)
+  {
+    BTOR_MSG (btor->msg,
+              1,
+              "%7lld beta reduction cache hits, %lld misses",
+              slv->stats.beta_cache_hits,
+              slv->stats.beta_cache_misses);
+    BTOR_MSG (btor->msg,
+              1,
+              "%7lld beta reduction cache evictions",
+              slv->stats.beta_cache_evictions);
+  }
+
+  if (btor_opt_get (btor, BTOR_OPT_FUN_INC_CHECK))
+  {
+    BTOR_MSG (btor->msg,
+              1,
+              "%7lld model assignments kept across refinements, %lld "
+              "invalidated",
+              slv->stats.inc_check_kept,
+              slv->stats.inc_check_invalidated);
+  }
+
+  if (slv->stats.components)
+  {
+    BTOR_MSG (btor->msg,
+              1,
+              "%d independent components, %d component checks",
+              slv->stats.components,
+              slv->stats.component_checks);
+  }
+
   if (btor_opt_get (btor, BTOR_OPT_FUN_DUAL_PROP))
   {
     BTOR_MSG (btor->msg,
@@ -2691,6 +3681,11 @@ print_stats_fun_solver (BtorFunSolver *slv)
               "%d/%d dual prop. applies (failed/assumed)",
               slv->stats.dp_failed_applies,
               slv->stats.dp_assumed_applies);
+    BTOR_MSG (btor->msg,
+              1,
+              "%d dual prop. clone reuses, %lld input assumptions reused",
+              slv->stats.dp_clone_reuses,
+              slv->stats.dp_reused_inputs);
   }
 }
 
@@ -2779,6 +3774,16 @@ print_time_stats_fun_solver (BtorFunSolver *slv)
             1,
             "  %.2f seconds propagation cleanup",
             slv->time.prop_cleanup);
+  if (slv->stats.abstractions)
+    BTOR_MSG (btor->msg,
+              1,
+              "%.2f seconds abstraction refinement",
+              slv->time.abstraction_refinement);
+  if (slv->stats.components)
+    BTOR_MSG (btor->msg,
+              1,
+              "%.2f seconds component decomposition",
+              slv->time.decompose);
 
   BTOR_MSG (btor->msg, 1, "%.2f seconds in pure SAT solving", slv->time.sat);
   BTOR_MSG (btor->msg, 1, "");
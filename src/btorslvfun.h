@@ -10,9 +10,11 @@
 #ifndef BTORSLVFUN_H_INCLUDED
 #define BTORSLVFUN_H_INCLUDED
 
+#include "btoraigvec.h"
 #include "btornode.h"
 #include "btorslv.h"
 #include "utils/btorhashptr.h"
+#include "utils/btornodemap.h"
 
 #define BTOR_FUN_SOLVER(btor) ((BtorFunSolver *) (btor)->slv)
 
@@ -25,6 +27,24 @@ struct BtorFunSolver
 
   BtorPtrHashTable *score; /* dcr score */
 
+  /* abstracted multipliers and dividers (BTOR_OPT_FUN_ABSTRACT),
+   * maps node to BtorFunAbstractionState */
+  BtorPtrHashTable *abstractions;
+
+  /* partial beta reduction cache (BTOR_OPT_FUN_BETA_CACHE) */
+  BtorPtrHashTable *beta_cache;
+
+  /* dual propagation clone (BTOR_OPT_FUN_DUAL_PROP), kept across sat calls
+   * in incremental mode */
+  struct
+  {
+    Btor *clone;
+    BtorNodeMap *exp_map;
+    BtorNode *root;           /* conjunction of asserted constraints */
+    BtorPtrHashTable *inputs; /* maps clone input to its last assumption */
+    uint32_t num_simplified;  /* simplified expressions in 'exp_map' */
+  } dp;
+
   // TODO (ma): make options for these
   int32_t lod_limit;
   int32_t sat_limit;
@@ -50,10 +70,25 @@ struct BtorFunSolver
     uint32_t dp_assumed_applies;
     uint32_t dp_failed_eqs;
     uint32_t dp_assumed_eqs;
+    uint32_t dp_clone_reuses;        /* sat calls reusing the clone */
+    uint_least64_t dp_reused_inputs; /* input assumptions kept */
 
     uint_least64_t eval_exp_calls;
     uint_least64_t propagations;
     uint_least64_t propagations_down;
+
+    uint32_t abstractions;            /* number of abstracted operators */
+    uint32_t abstraction_refinements; /* number of bit-blasted abstractions */
+
+    uint32_t components;       /* number of independent components */
+    uint32_t component_checks; /* number of SAT calls on single components */
+
+    uint_least64_t beta_cache_hits;
+    uint_least64_t beta_cache_misses;
+    uint_least64_t beta_cache_evictions;
+
+    uint_least64_t inc_check_kept; /* model assignments kept across rounds */
+    uint_least64_t inc_check_invalidated;
   } stats;
 
   struct
@@ -76,13 +111,28 @@ struct BtorFunSolver
     double find_conf_app;
     double check_extensionality;
     double prop_cleanup;
+    double abstraction_refinement;
+    double decompose;
   } time;
 };
 
 typedef struct BtorFunSolver BtorFunSolver;
 
+enum BtorFunAbstractionState
+{
+  BTOR_FUN_ABSTRACTION_NEW,     /* axioms not yet added */
+  BTOR_FUN_ABSTRACTION_AXIOMS,  /* axioms added */
+  BTOR_FUN_ABSTRACTION_REFINED, /* bit-blasted */
+};
+typedef enum BtorFunAbstractionState BtorFunAbstractionState;
+
 BtorSolver *btor_new_fun_solver (Btor *btor);
 
+/* Returns a vector of fresh AIG variables representing multiplier or
+ * divider 'exp' if 'exp' is abstracted by the fun solver, and 0 otherwise.
+ * Abstractions are refined (bit-blasted) on demand during solving. */
+BtorAIGVec *btor_fun_abstract_exp (Btor *btor, BtorNode *exp);
+
 // TODO (ma): this is just a fix for now, this should be moved elsewhere
 /* Evaluates expression and returns its value. */
 BtorBitVector *btor_eval_exp (Btor *btor, BtorNode *exp);
@@ -21,6 +21,7 @@
 #include "btorprintmodel.h"
 #include "btorproputils.h"
 #include "btorslsutils.h"
+#include "preprocess/btorunconstrained.h"
 
 #include "utils/btorhashint.h"
 #include "utils/btorhashptr.h"
@@ -407,7 +408,14 @@ generate_model_prop_solver (BtorPropSolver *slv,
 
   Btor *btor = slv->btor;
 
-  if (!reset && btor->bv_model) return;
+  if (!reset && btor->bv_model)
+  {
+    /* the search only updates the values of the formula inputs, inputs
+     * eliminated by unconstrained optimization are derived from these */
+    if (btor->uc_defs->count)
+      btor_reconstruct_unconstrained (btor, btor->bv_model, btor->fun_model);
+    return;
+  }
   btor_model_init_bv (btor, &btor->bv_model);
   btor_model_init_fun (btor, &btor->fun_model);
   btor_model_generate (
@@ -51,6 +51,32 @@ update_assumptions (Btor *btor)
     btor_node_release (btor, btor_iter_hashptr_next (&it));
   btor_hashptr_table_delete (btor->assumptions);
   btor->assumptions = ass;
+  btor->stats.subst_tables_updated++;
+}
+
+static bool
+is_assumption (Btor *btor, BtorNode *exp)
+{
+  assert (btor_node_is_regular (exp));
+  return btor_hashptr_table_get (btor->assumptions, exp)
+         || btor_hashptr_table_get (btor->assumptions, btor_node_invert (exp));
+}
+
+static bool
+is_static_rho_simplified (BtorPtrHashTable *static_rho)
+{
+  BtorNode *data, *key;
+  BtorPtrHashTableIterator it;
+
+  btor_iter_hashptr_init (&it, static_rho);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    data = it.bucket->data.as_ptr;
+    key  = btor_iter_hashptr_next (&it);
+    if (btor_node_is_simplified (key) || btor_node_is_simplified (data))
+      return true;
+  }
+  return false;
 }
 
 /* update hash tables of nodes in order to get rid of proxy nodes
@@ -69,7 +95,9 @@ update_node_hash_tables (Btor *btor)
     cur        = btor_iter_hashptr_next (&it);
     static_rho = btor_node_lambda_get_static_rho (cur);
 
-    if (!static_rho) continue;
+    /* only rebuild static_rhos that refer to simplified nodes */
+    if (!static_rho || !is_static_rho_simplified (static_rho)) continue;
+    btor->stats.subst_tables_updated++;
 
     new_static_rho =
         btor_hashptr_table_new (btor->mm,
@@ -286,6 +314,8 @@ substitute (Btor *btor,
 #endif
   BtorPtrHashTableIterator it;
   bool opt_nondestr_subst = btor_opt_get (btor, BTOR_OPT_NONDESTR_SUBST) == 1;
+  /* hash tables that refer to nodes simplified in this pass */
+  bool dirty_static_rhos = false, dirty_assumptions = false;
 
   if (nroots == 0) return;
 
@@ -455,9 +485,13 @@ RESTART:
         {
           simplified = btor_simplify_exp (btor, rebuilt);
           btor_set_simplified_exp (btor, cur, simplified);
+          dirty_static_rhos = btor->lambdas->count > 0;
+          if (!dirty_assumptions) dirty_assumptions = is_assumption (btor, cur);
+          btor->stats.subst_rebuilt++;
         }
       }
       btor_node_release (btor, rebuilt);
+      btor->stats.subst_visited++;
 
       /* mark as done */
       cur->rebuild = 0;
@@ -510,8 +544,8 @@ RESTART:
 #endif
   BTOR_RELEASE_STACK (visit);
 
-  update_node_hash_tables (btor);
-  update_assumptions (btor);
+  if (dirty_static_rhos) update_node_hash_tables (btor);
+  if (dirty_assumptions) update_assumptions (btor);
 
   while (!BTOR_EMPTY_STACK (release_stack))
   {
@@ -540,9 +574,11 @@ btor_substitute_and_rebuild (Btor *btor, BtorPtrHashTable *substs)
   bool ispushed;
   uint32_t i;
   bool opt_nondestr_subst;
+  double start;
 
   if (substs->count == 0u) return;
 
+  start              = btor_util_time_stamp ();
   mm                 = btor->mm;
   opt_nondestr_subst = btor_opt_get (btor, BTOR_OPT_NONDESTR_SUBST) == 1;
 
@@ -611,4 +647,5 @@ btor_substitute_and_rebuild (Btor *btor, BtorPtrHashTable *substs)
   BTOR_RELEASE_STACK (root_stack);
 
   assert (btor_dbg_check_lambdas_static_rho_proxy_free (btor));
+  btor->time.subst_rebuild += btor_util_time_stamp () - start;
 }
@@ -238,6 +238,19 @@ enum BtorOption
   */
   BTOR_OPT_REWRITE_LEVEL,
 
+  /*!
+    * **BTOR_OPT_RW_PROFILE**
+
+      | Set the profiling mode (``value``: 0-2) of the rewriting engine.
+
+      * 0: no profiling
+      * 1: report attempts, successes, (sampled) time and saved nodes per
+           rewrite rule and calls and time per rewrite function in the
+           statistics
+      * 2: additionally print the profile in a machine-readable format
+  */
+  BTOR_OPT_RW_PROFILE,
+
   /*!
     * **BTOR_OPT_SKELETON_PREPROC**
 
@@ -254,6 +267,22 @@ enum BtorOption
   */
   BTOR_OPT_ACKERMANN,
 
+  /*!
+    * **BTOR_OPT_ACKERMANN_PAIRS**
+
+      | Select the pairs of function applications for which Ackermann
+        constraints are added eagerly (see BTOR_OPT_ACKERMANN).
+
+      * BTOR_ACKERMANN_PAIRS_ALL [default]:
+        all pairs of applications of the same function
+      * BTOR_ACKERMANN_PAIRS_SHARED:
+        only pairs of applications with arguments that share subterms.
+        All other instances are added lazily by the function solver, which
+        only checks applications with the same argument values in the
+        current model and adds violated instances as lemmas.
+  */
+  BTOR_OPT_ACKERMANN_PAIRS,
+
   /*!
     * **BTOR_OPT_BETA_REDUCE**
 
@@ -270,6 +299,55 @@ enum BtorOption
   */
   BTOR_OPT_ELIMINATE_SLICES,
 
+  /*!
+    * **BTOR_OPT_REDUCE_WIDTHS**
+
+      Enable (``value``: 1) or disable (``value``: 0) bit-width reduction of
+      bit-vector variables and operations.
+  */
+  BTOR_OPT_REDUCE_WIDTHS,
+
+  /*!
+    * **BTOR_OPT_SOLVE_LINEAR**
+
+      Enable (``value``: 1) or disable (``value``: 0) solving systems of
+      top-level linear bit-vector equations of the same width jointly modulo
+      2^width.
+  */
+  BTOR_OPT_SOLVE_LINEAR,
+
+  /*!
+    * **BTOR_OPT_SAT_FACTS**
+
+      Enable (``value``: 1) or disable (``value``: 0) importing literals fixed
+      and equivalences detected by the SAT solver as word-level constraints
+      in subsequent incremental calls.
+  */
+  BTOR_OPT_SAT_FACTS,
+
+  /*!
+    * **BTOR_OPT_SIMP_ADAPTIVE**
+
+      Enable (``value``: 1) or disable (``value``: 0) adaptive scheduling of
+      the optional simplification passes (slice elimination, bit-width
+      reduction, skeleton preprocessing, unconstrained optimization, lambda
+      extraction and merging, adder normalization).  A pass that removed no
+      nodes (or only few nodes per second) and created no new substitutions
+      is deferred for an exponentially growing number of rounds and
+      incremental calls.
+  */
+  BTOR_OPT_SIMP_ADAPTIVE,
+
+  /*!
+    * **BTOR_OPT_SIMP_PASS_TIME_LIMIT**
+
+      Set time limit in milliseconds for each optional simplification pass
+      (see BTOR_OPT_SIMP_ADAPTIVE) per call to the simplifier.  A pass is not
+      run again within a call once it has used up its time limit.
+      No limit if ``value`` is 0.
+  */
+  BTOR_OPT_SIMP_PASS_TIME_LIMIT,
+
   /*!
     * **BTOR_OPT_VAR_SUBST**
 
@@ -283,6 +361,11 @@ enum BtorOption
 
       Enable (``value``: 1) or disable (``value``: 0) unconstrained
       optimization.
+
+      In combination with model generation or incremental solving, only
+      bit-vector terms whose inputs can be reconstructed from a model are
+      optimized. Their definitions are kept to assign eliminated inputs and
+      are re-added if an input becomes constrained in a later call.
   */
   BTOR_OPT_UCOPT,
 
@@ -318,6 +401,35 @@ enum BtorOption
   */
   BTOR_OPT_NORMALIZE_ADD,
 
+  /*!
+    * **BTOR_OPT_AIG_OPT**
+
+      Enable (``value``: 1) or disable (``value``: 0) optimization of
+      bit-blasted AIGs (cut based rewriting, refactoring and balancing)
+      prior to CNF encoding.
+  */
+  BTOR_OPT_AIG_OPT,
+
+  /*!
+    * **BTOR_OPT_AIG_OPT_TIME_LIMIT**
+
+      Set time limit in milliseconds for AIG optimization (see
+      BTOR_OPT_AIG_OPT) over all calls to the SAT solver.
+      If the limit is reached, AIGs are encoded without optimization.
+      No limit if ``value`` is 0.
+  */
+  BTOR_OPT_AIG_OPT_TIME_LIMIT,
+
+  /*!
+    * **BTOR_OPT_BV_DOMAIN**
+
+      Enable (``value``: 1) or disable (``value``: 0) known-bits and
+      unsigned interval analysis of bit-vector terms.  The computed
+      domains are used for rewriting, bit-blasting and for propagation
+      based local search.
+  */
+  BTOR_OPT_BV_DOMAIN,
+
   /* --------------------------------------------------------------------- */
   /*!
     **Fun Engine Options:**
@@ -409,6 +521,64 @@ enum BtorOption
   */
   BTOR_OPT_FUN_EAGER_LEMMAS,
 
+  /*!
+    * **BTOR_OPT_FUN_ABSTRACT**
+
+      Enable (``value``: 1) or disable (``value``: 0) abstraction of
+      bit-vector multiplication, unsigned division and unsigned remainder.
+
+      When enabled, these operators are not bit-blasted eagerly but
+      represented by fresh variables constrained by cheap axioms.
+      Operators are bit-blasted on demand if the value assigned to them by
+      the SAT solver is not consistent with their semantics.
+  */
+  BTOR_OPT_FUN_ABSTRACT,
+
+  /*!
+    * **BTOR_OPT_FUN_ABSTRACT_WIDTH**
+
+      Set the minimum bit-width of operators to abstract (see
+      BTOR_OPT_FUN_ABSTRACT).
+  */
+  BTOR_OPT_FUN_ABSTRACT_WIDTH,
+
+  /*!
+    * **BTOR_OPT_FUN_DECOMPOSE**
+
+      Enable (``value``: 1) or disable (``value``: 0) solving of independent
+      components.
+
+      When enabled, the constraints are partitioned into components that do
+      not share any variable or function.  Components are bit-blasted and
+      checked one at a time in order of increasing size, and solving stops
+      as soon as one of them is unsatisfiable.
+  */
+  BTOR_OPT_FUN_DECOMPOSE,
+
+  /*!
+    * **BTOR_OPT_FUN_BETA_CACHE**
+
+      Enable (``value``: 1) or disable (``value``: 0) caching of partial
+      beta reduction results during consistency checking.
+
+      Results are kept across refinement rounds and incremental calls and
+      are reused as long as the conditions evaluated during reduction have
+      the same values under the current model.
+  */
+  BTOR_OPT_FUN_BETA_CACHE,
+
+  /*!
+    * **BTOR_OPT_FUN_INC_CHECK**
+
+      Enable (``value``: 1) or disable (``value``: 0) incremental consistency
+      checking in the lemmas on demand loop.
+
+      The bit vector model of the previous refinement round is kept and only
+      assignments that changed (or were derived from changed assignments)
+      are recomputed.
+  */
+  BTOR_OPT_FUN_INC_CHECK,
+
   BTOR_OPT_FUN_STORE_LAMBDAS,
 
   /*!
@@ -988,6 +1158,21 @@ enum BtorOptBetaReduceMode
 };
 typedef enum BtorOptBetaReduceMode BtorOptBetaReduceMode;
 
+enum BtorOptAckermannPairs
+{
+  BTOR_ACKERMANN_PAIRS_ALL,
+  BTOR_ACKERMANN_PAIRS_SHARED,
+};
+typedef enum BtorOptAckermannPairs BtorOptAckermannPairs;
+
+enum BtorOptRwProfileMode
+{
+  BTOR_RW_PROFILE_NONE,
+  BTOR_RW_PROFILE_STATS,
+  BTOR_RW_PROFILE_DUMP,
+};
+typedef enum BtorOptRwProfileMode BtorOptRwProfileMode;
+
 /* --------------------------------------------------------------------- */
 
 /* Callback function to be executed on abort, primarily intended to be used for
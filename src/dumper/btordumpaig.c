@@ -11,6 +11,7 @@
 #include "btordumpaig.h"
 
 #include "btorabort.h"
+#include "btoraigopt.h"
 #include "btoraigvec.h"
 #include "utils/btornodeiter.h"
 #include "utils/btorutil.h"
@@ -64,7 +65,7 @@ dumpaig_dump_aux (Btor *btor,
   BtorAIG *tmp, *merged;
   BtorAIGMgr *amgr;
   BtorAIGVecMgr *avmgr;
-  uint32_t lazy_synthesize;
+  uint32_t lazy_synthesize, limit;
   BtorAIGPtrStack roots;
 
   BTOR_INIT_STACK (btor->mm, roots);
@@ -111,6 +112,17 @@ dumpaig_dump_aux (Btor *btor,
     if (merge_roots) BTOR_PUSH_STACK (roots, merged);
   }
 
+  /* optimize over expression boundaries */
+  if (btor_opt_get (btor, BTOR_OPT_AIG_OPT))
+  {
+    limit = btor_opt_get (btor, BTOR_OPT_AIG_OPT_TIME_LIMIT);
+    btor_aigopt_optimize (
+        amgr,
+        roots.start,
+        BTOR_COUNT_STACK (roots),
+        limit ? btor_util_time_stamp () + limit / 1000.0 : 0);
+  }
+
   BTOR_PUSH_STACK_IF (BTOR_EMPTY_STACK (roots), roots, BTOR_AIG_TRUE);
 
   btor_dumpaig_dump_seq (amgr,
@@ -14,25 +14,209 @@
 #include "utils/btornodeiter.h"
 #include "utils/btorutil.h"
 
+#include <stdlib.h>
+
+/* Buckets of applies that share an argument subterm with more than this
+ * number of applies are not considered in BTOR_ACKERMANN_PAIRS_SHARED mode
+ * (their pairs are left to lemmas on demand). */
+#define BTOR_ACK_SHARED_MAX_BUCKET 64
+
+struct BtorAckKey
+{
+  uint32_t pos; /* argument position */
+  uint32_t id;  /* id of the (shared) argument subterm */
+  uint32_t idx; /* index of the apply */
+};
+
+typedef struct BtorAckKey BtorAckKey;
+
+BTOR_DECLARE_STACK (BtorAckKey, BtorAckKey);
+BTOR_DECLARE_STACK (BtorUInt64, uint64_t);
+
+static void
+add_ackermann_constraint (Btor *btor, BtorNode *app_i, BtorNode *app_j)
+{
+  BtorNode *p, *c, *imp, *a_i, *a_j, *eq, *tmp;
+  BtorArgsIterator ait_i, ait_j;
+
+  p = 0;
+  assert (btor_node_get_sort_id (app_i->e[1])
+          == btor_node_get_sort_id (app_j->e[1]));
+  btor_iter_args_init (&ait_i, app_i->e[1]);
+  btor_iter_args_init (&ait_j, app_j->e[1]);
+  while (btor_iter_args_has_next (&ait_i))
+  {
+    a_i = btor_iter_args_next (&ait_i);
+    a_j = btor_iter_args_next (&ait_j);
+    eq  = btor_exp_eq (btor, a_i, a_j);
+
+    if (!p)
+      p = eq;
+    else
+    {
+      tmp = p;
+      p   = btor_exp_bv_and (btor, tmp, eq);
+      btor_node_release (btor, tmp);
+      btor_node_release (btor, eq);
+    }
+  }
+  c   = btor_exp_eq (btor, app_i, app_j);
+  imp = btor_exp_implies (btor, p, c);
+  btor->stats.ackermann_constraints++;
+  btor_assert_exp (btor, imp);
+  btor_node_release (btor, p);
+  btor_node_release (btor, c);
+  btor_node_release (btor, imp);
+}
+
+static int32_t
+compare_uint64 (const void *p1, const void *p2)
+{
+  uint64_t a = *((const uint64_t *) p1);
+  uint64_t b = *((const uint64_t *) p2);
+  return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+static int32_t
+compare_ack_keys (const void *p1, const void *p2)
+{
+  const BtorAckKey *k1, *k2;
+
+  k1 = (const BtorAckKey *) p1;
+  k2 = (const BtorAckKey *) p2;
+  if (k1->pos != k2->pos) return k1->pos < k2->pos ? -1 : 1;
+  if (k1->id != k2->id) return k1->id < k2->id ? -1 : 1;
+  if (k1->idx != k2->idx) return k1->idx < k2->idx ? -1 : 1;
+  return 0;
+}
+
+static void
+push_key (BtorAckKeyStack *keys, uint32_t pos, BtorNode *exp, uint32_t idx)
+{
+  BtorAckKey key;
+
+  exp = btor_node_real_addr (exp);
+  if (btor_node_is_bv_const (exp)) return;
+  key.pos = pos;
+  key.id  = (uint32_t) exp->id;
+  key.idx = idx;
+  BTOR_PUSH_STACK (*keys, key);
+}
+
+/* Add Ackermann constraints for all pairs of 'applies'. */
+static uint32_t
+add_all_pairs (Btor *btor, BtorNodePtrStack *applies)
+{
+  uint32_t i, j, res = 0;
+
+  for (i = 0; i < BTOR_COUNT_STACK (*applies); i++)
+    for (j = i + 1; j < BTOR_COUNT_STACK (*applies); j++)
+    {
+      add_ackermann_constraint (
+          btor, BTOR_PEEK_STACK (*applies, i), BTOR_PEEK_STACK (*applies, j));
+      res++;
+    }
+  return res;
+}
+
+/* Add Ackermann constraints for pairs of 'applies' that share an argument
+ * subterm, i.e., an argument at the same position that is either the same
+ * term or has a common (non-constant) child.  Applies are grouped into
+ * buckets keyed by argument position and subterm id, and only pairs within
+ * the same bucket are considered. */
+static uint32_t
+add_shared_pairs (Btor *btor, BtorNodePtrStack *applies)
+{
+  uint32_t i, j, k, l, pos, res = 0;
+  BtorNode *app, *arg, *real_arg;
+  BtorArgsIterator ait;
+  BtorAckKeyStack keys;
+  BtorUInt64Stack pairs;
+  BtorAckKey *ki, *kj;
+  uint64_t pair;
+  BtorMemMgr *mm;
+
+  mm = btor->mm;
+  BTOR_INIT_STACK (mm, keys);
+  BTOR_INIT_STACK (mm, pairs);
+
+  for (i = 0; i < BTOR_COUNT_STACK (*applies); i++)
+  {
+    app = BTOR_PEEK_STACK (*applies, i);
+    btor_iter_args_init (&ait, app->e[1]);
+    for (pos = 0; btor_iter_args_has_next (&ait); pos++)
+    {
+      arg      = btor_iter_args_next (&ait);
+      real_arg = btor_node_real_addr (arg);
+      if (btor_node_is_bv_const (real_arg)) continue;
+      push_key (&keys, pos, real_arg, i);
+      if (real_arg->parameterized || btor_node_is_fun (real_arg)) continue;
+      for (k = 0; k < real_arg->arity; k++)
+        push_key (&keys, pos, real_arg->e[k], i);
+    }
+  }
+  qsort (keys.start,
+         BTOR_COUNT_STACK (keys),
+         sizeof (BtorAckKey),
+         compare_ack_keys);
+
+  /* collect pairs within buckets */
+  for (i = 0; i < BTOR_COUNT_STACK (keys); i = j)
+  {
+    ki = keys.start + i;
+    for (j = i + 1; j < BTOR_COUNT_STACK (keys); j++)
+    {
+      kj = keys.start + j;
+      if (kj->pos != ki->pos || kj->id != ki->id) break;
+    }
+    if (j - i > BTOR_ACK_SHARED_MAX_BUCKET) continue;
+    for (k = i; k < j; k++)
+      for (l = k + 1; l < j; l++)
+      {
+        /* an argument may have the same child twice, e.g., x * x */
+        if (keys.start[k].idx == keys.start[l].idx) continue;
+        pair = ((uint64_t) keys.start[k].idx << 32) | keys.start[l].idx;
+        BTOR_PUSH_STACK (pairs, pair);
+      }
+  }
+  BTOR_RELEASE_STACK (keys);
+
+  qsort (
+      pairs.start, BTOR_COUNT_STACK (pairs), sizeof (uint64_t), compare_uint64);
+  for (i = 0; i < BTOR_COUNT_STACK (pairs); i++)
+  {
+    pair = BTOR_PEEK_STACK (pairs, i);
+    if (i > 0 && pair == BTOR_PEEK_STACK (pairs, i - 1)) continue;
+    add_ackermann_constraint (btor,
+                              BTOR_PEEK_STACK (*applies, pair >> 32),
+                              BTOR_PEEK_STACK (*applies, pair & 0xffffffff));
+    res++;
+  }
+  BTOR_RELEASE_STACK (pairs);
+  return res;
+}
+
 void
 btor_add_ackermann_constraints (Btor *btor)
 {
   assert (btor);
 
-  uint32_t i, j, num_constraints = 0;
+  uint32_t i, num_constraints = 0;
+  bool shared;
   double start, delta;
-  BtorNode *uf, *app_i, *app_j, *p, *c, *imp, *a_i, *a_j, *eq, *tmp;
+  BtorNode *uf, *app;
   BtorNode *cur;
-  BtorArgsIterator ait_i, ait_j;
   BtorNodeIterator nit;
   BtorPtrHashTableIterator it;
   BtorNodePtrStack applies, visit;
   BtorIntHashTable *cache;
   BtorMemMgr *mm;
 
-  start = btor_util_time_stamp ();
-  mm    = btor->mm;
-  cache = btor_hashint_table_new (mm);
+  start  = btor_util_time_stamp ();
+  mm     = btor->mm;
+  cache  = btor_hashint_table_new (mm);
+  shared = btor_opt_get (btor, BTOR_OPT_ACKERMANN_PAIRS)
+           == BTOR_ACKERMANN_PAIRS_SHARED;
   BTOR_INIT_STACK (mm, visit);
 
   btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
@@ -61,49 +245,16 @@ btor_add_ackermann_constraints (Btor *btor)
     btor_iter_apply_parent_init (&nit, uf);
     while (btor_iter_apply_parent_has_next (&nit))
     {
-      app_i = btor_iter_apply_parent_next (&nit);
-      if (app_i->parameterized) continue;
-      if (!btor_hashint_table_contains (cache, app_i->id)) continue;
-      BTOR_PUSH_STACK (applies, app_i);
+      app = btor_iter_apply_parent_next (&nit);
+      if (app->parameterized) continue;
+      if (!btor_hashint_table_contains (cache, app->id)) continue;
+      BTOR_PUSH_STACK (applies, app);
     }
 
-    for (i = 0; i < BTOR_COUNT_STACK (applies); i++)
-    {
-      app_i = BTOR_PEEK_STACK (applies, i);
-      for (j = i + 1; j < BTOR_COUNT_STACK (applies); j++)
-      {
-        app_j = BTOR_PEEK_STACK (applies, j);
-        p     = 0;
-        assert (btor_node_get_sort_id (app_i->e[1])
-                == btor_node_get_sort_id (app_j->e[1]));
-        btor_iter_args_init (&ait_i, app_i->e[1]);
-        btor_iter_args_init (&ait_j, app_j->e[1]);
-        while (btor_iter_args_has_next (&ait_i))
-        {
-          a_i = btor_iter_args_next (&ait_i);
-          a_j = btor_iter_args_next (&ait_j);
-          eq  = btor_exp_eq (btor, a_i, a_j);
-
-          if (!p)
-            p = eq;
-          else
-          {
-            tmp = p;
-            p   = btor_exp_bv_and (btor, tmp, eq);
-            btor_node_release (btor, tmp);
-            btor_node_release (btor, eq);
-          }
-        }
-        c   = btor_exp_eq (btor, app_i, app_j);
-        imp = btor_exp_implies (btor, p, c);
-        btor->stats.ackermann_constraints++;
-        num_constraints++;
-        btor_assert_exp (btor, imp);
-        btor_node_release (btor, p);
-        btor_node_release (btor, c);
-        btor_node_release (btor, imp);
-      }
-    }
+    if (shared)
+      num_constraints += add_shared_pairs (btor, &applies);
+    else
+      num_constraints += add_all_pairs (btor, &applies);
     BTOR_RELEASE_STACK (applies);
   }
   btor_hashint_table_delete (cache);
@@ -303,6 +303,74 @@ create_pattern_cpy (Btor *btor,
   return res;
 }
 
+/* number of increments of 'inc' from 'lower' to 'param':
+ * (param - lower) / inc */
+static inline BtorNode *
+create_range_step (Btor *btor,
+                   BtorNode *lower,
+                   BtorNode *param,
+                   BtorBitVector *inc)
+{
+  BtorNode *res, *sub, *off;
+
+  sub = btor_exp_bv_sub (btor, param, lower);
+  if (btor_bv_is_one (inc)) return sub;
+  off = btor_exp_bv_const (btor, inc);
+  res = btor_exp_bv_udiv (btor, sub, off);
+  btor_node_release (btor, off);
+  btor_node_release (btor, sub);
+  return res;
+}
+
+/* pattern: lower <= j <= upper && range_cond ? f(k) : a[j]
+ *          with k = (j - lower) / inc
+ *
+ *   affine: f(k) = base + step * k
+ *   read:   f(k) = src[base + step * k]
+ */
+static inline BtorNode *
+create_pattern_affine (Btor *btor,
+                       BtorNode *lower,
+                       BtorNode *upper,
+                       BtorNode *array,
+                       BtorNode *src_array,
+                       BtorNode *base,
+                       BtorBitVector *step,
+                       BtorBitVector *offset)
+{
+  assert (btor_node_is_bv_const (lower));
+  assert (btor_node_is_bv_const (upper));
+  assert (btor_node_is_bv_const (base));
+  assert (btor_node_get_sort_id (lower) == btor_node_get_sort_id (base));
+  assert (step);
+  assert (offset);
+
+  BtorNode *res, *param, *ite, *read, *cond, *k, *stp, *mul, *add, *value;
+
+  param = btor_exp_param (btor, btor_node_get_sort_id (lower), 0);
+  read  = btor_exp_read (btor, array, param);
+  cond  = create_range (btor, lower, upper, param, offset);
+  k     = create_range_step (btor, lower, param, offset);
+  stp   = btor_exp_bv_const (btor, step);
+  mul   = btor_exp_bv_mul (btor, stp, k);
+  add   = btor_exp_bv_add (btor, base, mul);
+  value = src_array ? btor_exp_read (btor, src_array, add)
+                    : btor_node_copy (btor, add);
+  ite   = btor_exp_cond (btor, cond, value, read);
+  res   = btor_exp_lambda (btor, param, ite);
+
+  btor_node_release (btor, param);
+  btor_node_release (btor, read);
+  btor_node_release (btor, cond);
+  btor_node_release (btor, k);
+  btor_node_release (btor, stp);
+  btor_node_release (btor, mul);
+  btor_node_release (btor, add);
+  btor_node_release (btor, value);
+  btor_node_release (btor, ite);
+  return res;
+}
+
 static bool
 is_write_exp (BtorNode *exp,
               BtorNode **array,
@@ -454,6 +522,34 @@ extract_cpy_src_dst_info (BtorNode *index,
   if (src_array) *src_array = value->e[0];
 }
 
+/* constant index, constant value of the same sort */
+inline static bool
+is_affine_pattern (BtorNode *index, BtorNode *value)
+{
+  return btor_node_is_bv_const (index) && btor_node_is_bv_const (value)
+         && btor_node_get_sort_id (index) == btor_node_get_sort_id (value);
+}
+
+/* constant index, value is a read at a constant index of the same sort */
+inline static bool
+is_read_pattern (BtorNode *index, BtorNode *value)
+{
+  return btor_node_is_bv_const (index) && !btor_node_is_inverted (value)
+         && btor_node_is_apply (value) && value->e[0]->is_array
+         && btor_node_is_bv_const (value->e[1]->e[0])
+         && btor_node_get_sort_id (index)
+                == btor_node_get_sort_id (value->e[1]->e[0]);
+}
+
+/* constant that is incremented along an affine or read pattern */
+inline static BtorNode *
+get_affine_base (BtorNode *value)
+{
+  if (btor_node_is_bv_const (value)) return value;
+  assert (btor_node_is_apply (value));
+  return value->e[1]->e[0];
+}
+
 inline static bool
 is_abs_set_pattern (BtorNode *index, BtorNode *prev_index)
 {
@@ -1035,6 +1131,79 @@ find_ranges (Btor *btor,
   if (size_pat_inc) *size_pat_inc += size_pattern_inc;
 }
 
+static BtorBitVector *
+const_diff (BtorMemMgr *mm, BtorNode *c0, BtorNode *c1)
+{
+  assert (btor_node_is_bv_const (c0));
+  assert (btor_node_is_bv_const (c1));
+  return btor_bv_sub (mm, BTOR_CONST_GET_BITS (c1), BTOR_CONST_GET_BITS (c0));
+}
+
+/* Find ranges of constant indices with a constant increment, where the
+ * values (affine pattern) or the indices of the values (read pattern) also
+ * grow by a constant step.  Ranges need at least three indices, the remaining
+ * indices are pushed onto 'indices'. */
+static void
+find_affine_ranges (Btor *btor,
+                    BtorNodePtrStack *stack,
+                    BtorPtrHashTable *index_value_map,
+                    BtorNodePtrStack *ranges,
+                    BtorBitVectorPtrStack *increments,
+                    BtorBitVectorPtrStack *steps,
+                    BtorNodePtrStack *indices,
+                    BtorNodePtrStack *indices_ranges)
+{
+  uint32_t i, j, k, cnt;
+  BtorBitVector *inc, *step, *tinc, *tstep;
+  BtorNode *v0, *v1;
+  BtorMemMgr *mm;
+
+  mm  = btor->mm;
+  cnt = BTOR_COUNT_STACK (*stack);
+  qsort (stack->start, cnt, sizeof (BtorNode *), cmp_abs_rel_indices);
+
+  for (i = 0; i < cnt; i = j + 1)
+  {
+    inc = step = 0;
+    for (j = i; j + 1 < cnt; j++)
+    {
+      v0    = btor_hashptr_table_get (index_value_map, stack->start[j])
+               ->data.as_ptr;
+      v1    = btor_hashptr_table_get (index_value_map, stack->start[j + 1])
+               ->data.as_ptr;
+      tinc  = const_diff (mm, stack->start[j], stack->start[j + 1]);
+      tstep = const_diff (mm, get_affine_base (v0), get_affine_base (v1));
+      if (!inc)
+      {
+        inc  = tinc;
+        step = tstep;
+        continue;
+      }
+      k = btor_bv_compare (inc, tinc) || btor_bv_compare (step, tstep);
+      btor_bv_free (mm, tinc);
+      btor_bv_free (mm, tstep);
+      if (k) break;
+    }
+
+    /* range is too small, push separate index */
+    if (j - i < 2)
+    {
+      if (inc) btor_bv_free (mm, inc);
+      if (step) btor_bv_free (mm, step);
+      BTOR_PUSH_STACK (*indices, stack->start[i]);
+      j = i;
+      continue;
+    }
+
+    BTOR_PUSH_STACK (*ranges, stack->start[i]);
+    BTOR_PUSH_STACK (*ranges, stack->start[j]);
+    BTOR_PUSH_STACK (*increments, inc);
+    BTOR_PUSH_STACK (*steps, step);
+    for (k = i; k <= j; k++) BTOR_PUSH_STACK (*indices_ranges, stack->start[k]);
+    BTOR_PUSH_STACK (*indices_ranges, 0);
+  }
+}
+
 static BtorPtrHashTable *
 create_static_rho (Btor *btor,
                    BtorNode *indices[],
@@ -1076,6 +1245,81 @@ create_static_rho (Btor *btor,
   return static_rho;
 }
 
+/* Summarize the affine or read patterns of the indices in 'stack' on top of
+ * 'subst'.  Returns the new array, indices that do not belong to any pattern
+ * are pushed onto 'indices_rem'. */
+static BtorNode *
+extract_affine_patterns (Btor *btor,
+                         BtorNodePtrStack *stack,
+                         BtorPtrHashTable *index_value_map,
+                         BtorNode *subst,
+                         BtorNodePtrStack *indices_rem,
+                         uint32_t *num_pat,
+                         uint32_t *size_pat)
+{
+  uint32_t i, i_index_r;
+  BtorNode *tmp, *lower, *upper, *value, *src_array;
+  BtorBitVector *inc, *step;
+  BtorPtrHashTable *static_rho;
+  BtorNodePtrStack ranges, indices_ranges;
+  BtorBitVectorPtrStack increments, steps;
+  BtorMemMgr *mm;
+
+  mm = btor->mm;
+  BTOR_INIT_STACK (mm, ranges);
+  BTOR_INIT_STACK (mm, indices_ranges);
+  BTOR_INIT_STACK (mm, increments);
+  BTOR_INIT_STACK (mm, steps);
+
+  find_affine_ranges (btor,
+                      stack,
+                      index_value_map,
+                      &ranges,
+                      &increments,
+                      &steps,
+                      indices_rem,
+                      &indices_ranges);
+
+  for (i = 0, i_index_r = 0; i < BTOR_COUNT_STACK (increments); i++)
+  {
+    lower = BTOR_PEEK_STACK (ranges, 2 * i);
+    upper = BTOR_PEEK_STACK (ranges, 2 * i + 1);
+    inc   = BTOR_PEEK_STACK (increments, i);
+    step  = BTOR_PEEK_STACK (steps, i);
+    value = btor_hashptr_table_get (index_value_map, lower)->data.as_ptr;
+    src_array = btor_node_is_bv_const (value) ? 0 : value->e[0];
+    tmp       = create_pattern_affine (btor,
+                                 lower,
+                                 upper,
+                                 subst,
+                                 src_array,
+                                 get_affine_base (value),
+                                 step,
+                                 inc);
+    tmp->is_array = 1;
+    btor_node_release (btor, subst);
+    subst = tmp;
+    btor_bv_free (mm, inc);
+    btor_bv_free (mm, step);
+
+    assert (i_index_r < BTOR_COUNT_STACK (indices_ranges));
+    static_rho = create_static_rho (
+        btor, indices_ranges.start + i_index_r, 0, index_value_map);
+    i_index_r += static_rho->count + 1;
+    *num_pat += 1;
+    *size_pat += static_rho->count;
+    if (btor_node_lambda_get_static_rho (subst))
+      btor_node_lambda_delete_static_rho (btor, subst);
+    btor_node_lambda_set_static_rho (subst, static_rho);
+  }
+
+  BTOR_RELEASE_STACK (ranges);
+  BTOR_RELEASE_STACK (indices_ranges);
+  BTOR_RELEASE_STACK (increments);
+  BTOR_RELEASE_STACK (steps);
+  return subst;
+}
+
 static uint32_t
 extract_lambdas (Btor *btor,
                  BtorPtrHashTable *map_value_index,
@@ -1095,7 +1339,9 @@ extract_lambdas (Btor *btor,
   BtorPtrHashBucket *b;
   BtorNodePtrStack ranges, indices, values, indices_itoi, indices_itoip1;
   BtorNodePtrStack indices_cpy, indices_rem, indices_ranges, *stack;
+  BtorNodePtrStack indices_affine;
   BtorBitVectorPtrStack increments;
+  BtorPtrHashTable *map_src_index;
   BtorMemMgr *mm;
 
   /* statistics */
@@ -1103,6 +1349,7 @@ extract_lambdas (Btor *btor,
   uint32_t num_set = 0, num_set_inc = 0, num_set_itoi = 0, num_set_itoip1 = 0;
   uint32_t num_cpy = 0, size_set = 0, size_set_inc = 0, size_set_itoi = 0;
   uint32_t size_set_itoip1 = 0, size_cpy = 0;
+  uint32_t num_affine = 0, size_affine = 0, num_read = 0, size_read = 0;
 
   mm = btor->mm;
   BTOR_INIT_STACK (mm, ranges);
@@ -1114,6 +1361,7 @@ extract_lambdas (Btor *btor,
   BTOR_INIT_STACK (mm, indices_itoip1);
   BTOR_INIT_STACK (mm, indices_cpy);
   BTOR_INIT_STACK (mm, indices_rem);
+  BTOR_INIT_STACK (mm, indices_affine);
   btor_iter_hashptr_init (&it, map_value_index);
   while (btor_iter_hashptr_has_next (&it))
   {
@@ -1175,6 +1423,11 @@ extract_lambdas (Btor *btor,
         btor_hashptr_table_new (mm,
                                 (BtorHashPtr) btor_node_hash_by_id,
                                 (BtorCmpPtr) btor_node_compare_by_id);
+    /* maps source arrays of read patterns to stacks of indices */
+    map_src_index =
+        btor_hashptr_table_new (mm,
+                                (BtorHashPtr) btor_node_hash_by_id,
+                                (BtorCmpPtr) btor_node_compare_by_id);
     base    = subst;
     i_range = i_index = i_inc = 0;
     i_index_r                 = 0;
@@ -1234,12 +1487,29 @@ extract_lambdas (Btor *btor,
         /* pattern 3: memcopy pattern */
         else if (is_cpy_pattern (lower, value))
           BTOR_PUSH_STACK (indices_cpy, lower);
+        /* pattern 4: index -> affine function of index */
+        else if (is_affine_pattern (lower, value))
+          BTOR_PUSH_STACK (indices_affine, lower);
+        /* pattern 5: index -> read at affine function of index */
+        else if (is_read_pattern (lower, value))
+        {
+          if (!(b = btor_hashptr_table_get (map_src_index, value->e[0])))
+          {
+            b = btor_hashptr_table_add (map_src_index, value->e[0]);
+            BTOR_NEW (mm, stack);
+            BTOR_INIT_STACK (mm, *stack);
+            b->data.as_ptr = stack;
+          }
+          stack = b->data.as_ptr;
+          BTOR_PUSH_STACK (*stack, lower);
+        }
         else /* no pattern found */
           BTOR_PUSH_STACK (indices_rem, lower);
       }
     }
 
-    /* pattern: index -> index */
+    /* pattern: index -> index, remaining indices are checked for affine
+     * patterns */
     BTOR_RESET_STACK (ranges);
     BTOR_RESET_STACK (indices_ranges);
     BTOR_RESET_STACK (increments);
@@ -1247,7 +1517,7 @@ extract_lambdas (Btor *btor,
                  &indices_itoi,
                  &ranges,
                  &increments,
-                 &indices_rem,
+                 &indices_affine,
                  &indices_ranges,
                  &num_set_itoi,
                  0,
@@ -1280,7 +1550,8 @@ extract_lambdas (Btor *btor,
       }
     }
 
-    /* pattern: index -> index + 1 */
+    /* pattern: index -> index + 1, remaining indices are checked for affine
+     * patterns */
     BTOR_RESET_STACK (ranges);
     BTOR_RESET_STACK (indices_ranges);
     BTOR_RESET_STACK (increments);
@@ -1288,7 +1559,7 @@ extract_lambdas (Btor *btor,
                  &indices_itoip1,
                  &ranges,
                  &increments,
-                 &indices_rem,
+                 &indices_affine,
                  &indices_ranges,
                  &num_set_itoip1,
                  0,
@@ -1369,7 +1640,35 @@ extract_lambdas (Btor *btor,
       }
     }
 
-    num_total = num_set + num_set_inc + num_set_itoi + num_set_itoip1 + num_cpy;
+    /* pattern: affine function of index */
+    subst = extract_affine_patterns (btor,
+                                     &indices_affine,
+                                     index_value_map,
+                                     subst,
+                                     &indices_rem,
+                                     &num_affine,
+                                     &size_affine);
+
+    /* pattern: strided copy, one range of indices per source array */
+    btor_iter_hashptr_init (&iit, map_src_index);
+    while (btor_iter_hashptr_has_next (&iit))
+    {
+      stack = iit.bucket->data.as_ptr;
+      (void) btor_iter_hashptr_next (&iit);
+      subst = extract_affine_patterns (btor,
+                                       stack,
+                                       index_value_map,
+                                       subst,
+                                       &indices_rem,
+                                       &num_read,
+                                       &size_read);
+      BTOR_RELEASE_STACK (*stack);
+      BTOR_DELETE (mm, stack);
+    }
+    btor_hashptr_table_delete (map_src_index);
+
+    num_total = num_set + num_set_inc + num_set_itoi + num_set_itoip1 + num_cpy
+                + num_affine + num_read;
 
     /* we can skip creating writes if we did not find any pattern in a write
      * chain, and thus can leave the write chain as-is.
@@ -1415,6 +1714,7 @@ extract_lambdas (Btor *btor,
     BTOR_RESET_STACK (indices_itoip1);
     BTOR_RESET_STACK (indices_cpy);
     BTOR_RESET_STACK (indices_rem);
+    BTOR_RESET_STACK (indices_affine);
   }
   BTOR_RELEASE_STACK (ranges);
   BTOR_RELEASE_STACK (indices);
@@ -1425,6 +1725,12 @@ extract_lambdas (Btor *btor,
   BTOR_RELEASE_STACK (indices_itoip1);
   BTOR_RELEASE_STACK (indices_cpy);
   BTOR_RELEASE_STACK (indices_rem);
+  BTOR_RELEASE_STACK (indices_affine);
+
+  btor->stats.extracted_lambdas += num_total;
+  btor->stats.extracted_writes += size_set + size_set_inc + size_set_itoi
+                                  + size_set_itoip1 + size_cpy + size_affine
+                                  + size_read;
 
   BTOR_MSG (btor->msg,
             1,
@@ -1432,7 +1738,9 @@ extract_lambdas (Btor *btor,
             "set_inc: %u (%u), "
             "set_itoi: %u (%u), "
             "set_itoip1: %u (%u), "
-            "cpy: %u (%u)",
+            "cpy: %u (%u), "
+            "affine: %u (%u), "
+            "read: %u (%u)",
             num_set,
             size_set,
             num_set_inc,
@@ -1442,7 +1750,11 @@ extract_lambdas (Btor *btor,
             num_set_itoip1,
             size_set_itoip1,
             num_cpy,
-            size_cpy);
+            size_cpy,
+            num_affine,
+            size_affine,
+            num_read,
+            size_read);
   return num_total;
 }
 
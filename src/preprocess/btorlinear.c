@@ -0,0 +1,590 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "preprocess/btorlinear.h"
+
+#include "btorbv.h"
+#include "btorcore.h"
+#include "btorexp.h"
+#include "btorlog.h"
+#include "btormsg.h"
+#include "btorsubst.h"
+#include "utils/btorhashint.h"
+#include "utils/btorhashptr.h"
+#include "utils/btorstack.h"
+#include "utils/btorutil.h"
+
+#include <stdlib.h>
+
+/* maximum number of nodes visited while parsing a linear equation */
+#define BTOR_LINEAR_PARSE_LIMIT 1000
+
+/* The linear equation
+ *
+ *   sum_i coeffs[i] * atoms[i] + constant = 0  (mod 2^width)
+ *
+ * where atoms are variables or non-linear terms. */
+struct BtorLinEq
+{
+  BtorNode *exp;            /* original equation */
+  uint32_t width;
+  BtorPtrHashTable *coeffs; /* atom -> coefficient */
+  BtorBitVector *constant;
+  BtorNode *pivot; /* pivot variable, 0 if none */
+  bool changed;    /* modified by elimination */
+};
+
+typedef struct BtorLinEq BtorLinEq;
+
+BTOR_DECLARE_STACK (BtorLinEqPtr, BtorLinEq *);
+
+static BtorLinEq *
+new_lin_eq (Btor *btor, BtorNode *exp, uint32_t width)
+{
+  BtorLinEq *res;
+
+  BTOR_CNEW (btor->mm, res);
+  res->exp      = exp;
+  res->width    = width;
+  res->coeffs   = btor_hashptr_table_new (btor->mm,
+                                        (BtorHashPtr) btor_node_hash_by_id,
+                                        (BtorCmpPtr) btor_node_compare_by_id);
+  res->constant = btor_bv_new (btor->mm, width);
+  return res;
+}
+
+static void
+delete_lin_eq (Btor *btor, BtorLinEq *eq)
+{
+  BtorPtrHashTableIterator it;
+
+  btor_iter_hashptr_init (&it, eq->coeffs);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    btor_bv_free (btor->mm, it.bucket->data.as_ptr);
+    btor_node_release (btor, btor_iter_hashptr_next (&it));
+  }
+  btor_hashptr_table_delete (eq->coeffs);
+  btor_bv_free (btor->mm, eq->constant);
+  BTOR_DELETE (btor->mm, eq);
+}
+
+static void
+add_constant (Btor *btor, BtorLinEq *eq, const BtorBitVector *c)
+{
+  BtorBitVector *sum;
+
+  sum = btor_bv_add (btor->mm, eq->constant, c);
+  btor_bv_free (btor->mm, eq->constant);
+  eq->constant = sum;
+}
+
+static void
+add_coeff (Btor *btor, BtorLinEq *eq, BtorNode *atom, const BtorBitVector *c)
+{
+  BtorPtrHashBucket *b;
+  BtorBitVector *sum;
+
+  if (btor_bv_is_zero (c)) return;
+
+  b = btor_hashptr_table_get (eq->coeffs, atom);
+  if (!b)
+  {
+    b = btor_hashptr_table_add (eq->coeffs, btor_node_copy (btor, atom));
+    b->data.as_ptr = btor_bv_copy (btor->mm, c);
+    return;
+  }
+  sum = btor_bv_add (btor->mm, b->data.as_ptr, c);
+  btor_bv_free (btor->mm, b->data.as_ptr);
+  if (btor_bv_is_zero (sum))
+  {
+    btor_bv_free (btor->mm, sum);
+    btor_hashptr_table_remove (eq->coeffs, atom, 0, 0);
+    btor_node_release (btor, atom);
+  }
+  else
+    b->data.as_ptr = sum;
+}
+
+static BtorBitVector *
+get_const_bits (BtorNode *exp)
+{
+  assert (btor_node_is_bv_const (exp));
+  return btor_node_is_inverted (exp)
+             ? btor_node_bv_const_get_invbits (btor_node_real_addr (exp))
+             : btor_node_bv_const_get_bits (exp);
+}
+
+/* Add c * 'term' to 'eq'.  Fails if more than 'bound' nodes are visited. */
+static bool
+parse_linear (Btor *btor,
+              BtorLinEq *eq,
+              BtorNode *term,
+              const BtorBitVector *c,
+              uint32_t *bound)
+{
+  bool res;
+  uint32_t i;
+  BtorBitVector *tmp;
+  BtorNode *real_term;
+
+  if (*bound == 0) return false;
+  *bound -= 1;
+
+  real_term = btor_node_real_addr (term);
+  if (btor_node_is_bv_const (real_term))
+  {
+    tmp = btor_bv_mul (btor->mm, c, get_const_bits (term));
+    add_constant (btor, eq, tmp);
+    btor_bv_free (btor->mm, tmp);
+    return true;
+  }
+
+  if (btor_node_is_inverted (term))
+  {
+    /* c * ~t = -c - c * t */
+    tmp = btor_bv_neg (btor->mm, c);
+    add_constant (btor, eq, tmp);
+    res = parse_linear (btor, eq, real_term, tmp, bound);
+    btor_bv_free (btor->mm, tmp);
+    return res;
+  }
+
+  if (btor_node_is_bv_add (term))
+    return parse_linear (btor, eq, term->e[0], c, bound)
+           && parse_linear (btor, eq, term->e[1], c, bound);
+
+  if (btor_node_is_bv_mul (term)
+      && (btor_node_is_bv_const (term->e[0])
+          || btor_node_is_bv_const (term->e[1])))
+  {
+    i   = btor_node_is_bv_const (term->e[0]) ? 0 : 1;
+    tmp = btor_bv_mul (btor->mm, c, get_const_bits (term->e[i]));
+    res = parse_linear (btor, eq, term->e[1 - i], tmp, bound);
+    btor_bv_free (btor->mm, tmp);
+    return res;
+  }
+
+  add_coeff (btor, eq, term, c);
+  return true;
+}
+
+/* Parse top-level equality 'exp' into a linear equation.  Returns 0 if
+ * 'exp' is not linear in at least one variable. */
+static BtorLinEq *
+parse_lin_eq (Btor *btor, BtorNode *exp)
+{
+  bool res, has_var;
+  uint32_t width, bound;
+  BtorBitVector *one, *minus_one;
+  BtorLinEq *eq;
+  BtorPtrHashTableIterator it;
+
+  width = btor_node_bv_get_width (btor, exp->e[0]);
+  if (width < 2) return 0;
+
+  eq        = new_lin_eq (btor, exp, width);
+  bound     = BTOR_LINEAR_PARSE_LIMIT;
+  one       = btor_bv_one (btor->mm, width);
+  minus_one = btor_bv_neg (btor->mm, one);
+  res       = parse_linear (btor, eq, exp->e[0], one, &bound)
+        && parse_linear (btor, eq, exp->e[1], minus_one, &bound);
+  btor_bv_free (btor->mm, one);
+  btor_bv_free (btor->mm, minus_one);
+
+  has_var = false;
+  btor_iter_hashptr_init (&it, eq->coeffs);
+  while (!has_var && btor_iter_hashptr_has_next (&it))
+    has_var = btor_node_is_bv_var (btor_iter_hashptr_next (&it));
+
+  if (!res || !has_var)
+  {
+    delete_lin_eq (btor, eq);
+    return 0;
+  }
+  return eq;
+}
+
+static int32_t
+compare_lin_eqs (const void *p1, const void *p2)
+{
+  BtorLinEq *eq1, *eq2;
+
+  eq1 = *((BtorLinEq **) p1);
+  eq2 = *((BtorLinEq **) p2);
+  if (eq1->width != eq2->width) return eq1->width < eq2->width ? -1 : 1;
+  return eq1->exp->id - eq2->exp->id;
+}
+
+/* Mark all variables occurring in non-variable atoms of 'eqs', these
+ * cannot be eliminated. */
+static void
+mark_blocked_vars (Btor *btor,
+                   BtorLinEq **eqs,
+                   uint32_t neqs,
+                   BtorIntHashTable *blocked)
+{
+  uint32_t i, j;
+  BtorNode *cur;
+  BtorNodePtrStack visit;
+  BtorPtrHashTableIterator it;
+  BtorIntHashTable *cache;
+
+  cache = btor_hashint_table_new (btor->mm);
+  BTOR_INIT_STACK (btor->mm, visit);
+  for (i = 0; i < neqs; i++)
+  {
+    btor_iter_hashptr_init (&it, eqs[i]->coeffs);
+    while (btor_iter_hashptr_has_next (&it))
+    {
+      cur = btor_iter_hashptr_next (&it);
+      if (btor_node_is_bv_var (cur)) continue;
+      BTOR_PUSH_STACK (visit, cur);
+    }
+  }
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = btor_node_real_addr (BTOR_POP_STACK (visit));
+    if (btor_hashint_table_contains (cache, cur->id)) continue;
+    btor_hashint_table_add (cache, cur->id);
+    if (btor_node_is_bv_var (cur))
+    {
+      if (!btor_hashint_table_contains (blocked, cur->id))
+        btor_hashint_table_add (blocked, cur->id);
+      continue;
+    }
+    for (j = 0; j < cur->arity; j++) BTOR_PUSH_STACK (visit, cur->e[j]);
+  }
+  BTOR_RELEASE_STACK (visit);
+  btor_hashint_table_delete (cache);
+}
+
+/* Eliminate pivot variable 'x' of 'piv' from all other equations in which
+ * its coefficient has at least as many trailing zeros as in 'piv'. */
+static void
+eliminate (Btor *btor, BtorLinEq **eqs, uint32_t neqs, BtorLinEq *piv)
+{
+  uint32_t i, v;
+  BtorNode *x, *atom;
+  BtorBitVector *a, *b, *u, *uinv, *q, *f, *t;
+  BtorPtrHashBucket *bucket;
+  BtorPtrHashTableIterator it;
+  BtorMemMgr *mm;
+
+  mm = btor->mm;
+  x  = piv->pivot;
+  a  = btor_hashptr_table_get (piv->coeffs, x)->data.as_ptr;
+  v  = btor_bv_get_num_trailing_zeros (a);
+  u  = btor_bv_srl_uint64 (mm, a, v);
+  uinv = btor_bv_mod_inverse (mm, u);
+
+  for (i = 0; i < neqs; i++)
+  {
+    if (eqs[i] == piv) continue;
+    bucket = btor_hashptr_table_get (eqs[i]->coeffs, x);
+    if (!bucket) continue;
+    b = bucket->data.as_ptr;
+    if (btor_bv_get_num_trailing_zeros (b) < v) continue;
+
+    /* eqs[i] -= ((b >> v) * u^-1) * piv */
+    q = btor_bv_srl_uint64 (mm, b, v);
+    t = btor_bv_mul (mm, q, uinv);
+    f = btor_bv_neg (mm, t);
+    btor_bv_free (mm, q);
+    btor_bv_free (mm, t);
+    btor_iter_hashptr_init (&it, piv->coeffs);
+    while (btor_iter_hashptr_has_next (&it))
+    {
+      t    = btor_bv_mul (mm, f, it.bucket->data.as_ptr);
+      atom = btor_iter_hashptr_next (&it);
+      add_coeff (btor, eqs[i], atom, t);
+      btor_bv_free (mm, t);
+    }
+    t = btor_bv_mul (mm, f, piv->constant);
+    add_constant (btor, eqs[i], t);
+    btor_bv_free (mm, t);
+    btor_bv_free (mm, f);
+    eqs[i]->changed = true;
+    assert (!btor_hashptr_table_get (eqs[i]->coeffs, x));
+  }
+  btor_bv_free (mm, u);
+  btor_bv_free (mm, uinv);
+}
+
+/* Bring 'eqs' (of the same width) into echelon form.  Returns false if the
+ * system has no solution. */
+static bool
+solve_system (Btor *btor, BtorLinEq **eqs, uint32_t neqs)
+{
+  uint32_t i, v, vmin;
+  BtorNode *atom, *best_atom;
+  BtorLinEq *best;
+  BtorPtrHashTableIterator it;
+  BtorIntHashTable *blocked;
+
+  blocked = btor_hashint_table_new (btor->mm);
+  mark_blocked_vars (btor, eqs, neqs, blocked);
+
+  for (;;)
+  {
+    best      = 0;
+    best_atom = 0;
+    vmin      = eqs[0]->width;
+    for (i = 0; i < neqs && vmin > 0; i++)
+    {
+      if (eqs[i]->pivot) continue;
+      btor_iter_hashptr_init (&it, eqs[i]->coeffs);
+      while (btor_iter_hashptr_has_next (&it))
+      {
+        v    = btor_bv_get_num_trailing_zeros (it.bucket->data.as_ptr);
+        atom = btor_iter_hashptr_next (&it);
+        if (!btor_node_is_bv_var (atom)
+            || btor_hashint_table_contains (blocked, atom->id) || v >= vmin)
+          continue;
+        best      = eqs[i];
+        best_atom = atom;
+        vmin      = v;
+        if (v == 0) break;
+      }
+    }
+    if (!best) break;
+    best->pivot = best_atom;
+    eliminate (btor, eqs, neqs, best);
+  }
+  btor_hashint_table_delete (blocked);
+
+  /* sum_i c_i * t_i + k = 0 has no solution if k has less trailing zeros
+   * than all c_i */
+  for (i = 0; i < neqs; i++)
+  {
+    vmin = eqs[i]->width;
+    btor_iter_hashptr_init (&it, eqs[i]->coeffs);
+    while (btor_iter_hashptr_has_next (&it))
+    {
+      v = btor_bv_get_num_trailing_zeros (it.bucket->data.as_ptr);
+      if (v < vmin) vmin = v;
+      (void) btor_iter_hashptr_next (&it);
+    }
+    if (btor_bv_get_num_trailing_zeros (eqs[i]->constant) < vmin) return false;
+  }
+  return true;
+}
+
+static bool
+has_even_pivot (BtorLinEq *eq)
+{
+  BtorBitVector *a;
+
+  if (!eq->pivot) return false;
+  a = btor_hashptr_table_get (eq->coeffs, eq->pivot)->data.as_ptr;
+  return !btor_bv_get_bit (a, 0);
+}
+
+/* Create sum_i c_i * t_i + k of 'eq' without the summand of 'skip'. */
+static BtorNode *
+mk_sum (Btor *btor, BtorLinEq *eq, BtorNode *skip)
+{
+  BtorNode *res, *atom, *c, *prod, *tmp;
+  BtorPtrHashTableIterator it;
+
+  res = btor_exp_bv_const (btor, eq->constant);
+  btor_iter_hashptr_init (&it, eq->coeffs);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    c    = btor_exp_bv_const (btor, it.bucket->data.as_ptr);
+    atom = btor_iter_hashptr_next (&it);
+    if (atom == skip)
+    {
+      btor_node_release (btor, c);
+      continue;
+    }
+    prod = btor_exp_bv_mul (btor, c, btor_simplify_exp (btor, atom));
+    tmp  = btor_exp_bv_add (btor, res, prod);
+    btor_node_release (btor, c);
+    btor_node_release (btor, prod);
+    btor_node_release (btor, res);
+    res = tmp;
+  }
+  return res;
+}
+
+/* Create the constraints of reduced equation 'eq' and push them onto
+ * 'facts'. */
+static void
+mk_facts (Btor *btor, BtorLinEq *eq, BtorNodePtrStack *facts)
+{
+  uint32_t v, w;
+  BtorNode *x, *rest, *c, *prod, *lo, *hi, *zero, *fresh, *tmp;
+  BtorBitVector *a, *u, *uinv, *neg_uinv;
+  BtorSortId sort;
+  BtorMemMgr *mm;
+
+  mm = btor->mm;
+  w  = eq->width;
+
+  if (!eq->pivot)
+  {
+    rest = mk_sum (btor, eq, 0);
+    zero = btor_exp_bv_zero (btor, btor_node_get_sort_id (rest));
+    BTOR_PUSH_STACK (*facts, btor_exp_eq (btor, rest, zero));
+    btor_node_release (btor, zero);
+    btor_node_release (btor, rest);
+    return;
+  }
+
+  /* 2^v * u * x + rest = 0 with u odd
+   * <-> rest[v-1:0] = 0 and x[w-v-1:0] = (-u^-1 * rest)[w-1:v] */
+  x        = eq->pivot;
+  a        = btor_hashptr_table_get (eq->coeffs, x)->data.as_ptr;
+  v        = btor_bv_get_num_trailing_zeros (a);
+  u        = btor_bv_srl_uint64 (mm, a, v);
+  uinv     = btor_bv_mod_inverse (mm, u);
+  neg_uinv = btor_bv_neg (mm, uinv);
+  rest     = mk_sum (btor, eq, x);
+  c        = btor_exp_bv_const (btor, neg_uinv);
+  prod     = btor_exp_bv_mul (btor, c, rest);
+  btor_bv_free (mm, u);
+  btor_bv_free (mm, uinv);
+  btor_bv_free (mm, neg_uinv);
+  btor_node_release (btor, c);
+
+  if (v == 0)
+    BTOR_PUSH_STACK (*facts, btor_exp_eq (btor, x, prod));
+  else
+  {
+    lo   = btor_exp_bv_slice (btor, rest, v - 1, 0);
+    zero = btor_exp_bv_zero (btor, btor_node_get_sort_id (lo));
+    BTOR_PUSH_STACK (*facts, btor_exp_eq (btor, lo, zero));
+    btor_node_release (btor, zero);
+    btor_node_release (btor, lo);
+
+    hi    = btor_exp_bv_slice (btor, prod, w - 1, v);
+    sort  = btor_sort_bv (btor, v);
+    fresh = btor_exp_var (btor, sort, 0);
+    btor_sort_release (btor, sort);
+    tmp = btor_exp_bv_concat (btor, fresh, hi);
+    BTOR_PUSH_STACK (*facts, btor_exp_eq (btor, x, tmp));
+    btor_node_release (btor, tmp);
+    btor_node_release (btor, fresh);
+    btor_node_release (btor, hi);
+  }
+  btor_node_release (btor, prod);
+  btor_node_release (btor, rest);
+}
+
+void
+btor_solve_linear_systems (Btor *btor)
+{
+  assert (btor);
+
+  bool inconsistent;
+  uint32_t i, j, k, n, num_systems, num_elims;
+  double start, delta;
+  BtorNode *cur, *fact;
+  BtorLinEq *eq, **eqs;
+  BtorLinEqPtrStack lin_eqs, reduced;
+  BtorNodePtrStack facts;
+  BtorPtrHashTableIterator it;
+  BtorMemMgr *mm;
+
+  start        = btor_util_time_stamp ();
+  mm           = btor->mm;
+  num_systems  = 0;
+  num_elims    = 0;
+  inconsistent = false;
+
+  BTORLOG (1, "start solving linear systems");
+
+  BTOR_INIT_STACK (mm, lin_eqs);
+  BTOR_INIT_STACK (mm, reduced);
+  BTOR_INIT_STACK (mm, facts);
+
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    cur = btor_iter_hashptr_next (&it);
+    if (btor_node_is_inverted (cur) || !btor_node_is_bv_eq (cur)) continue;
+    if ((eq = parse_lin_eq (btor, cur))) BTOR_PUSH_STACK (lin_eqs, eq);
+  }
+  qsort (lin_eqs.start,
+         BTOR_COUNT_STACK (lin_eqs),
+         sizeof (BtorLinEq *),
+         compare_lin_eqs);
+
+  /* solve systems of equations of the same width */
+  eqs = lin_eqs.start;
+  for (i = 0; i < BTOR_COUNT_STACK (lin_eqs) && !inconsistent; i = j)
+  {
+    for (j = i + 1;
+         j < BTOR_COUNT_STACK (lin_eqs) && eqs[j]->width == eqs[i]->width;
+         j++)
+      ;
+    if (!solve_system (btor, eqs + i, j - i))
+    {
+      inconsistent = true;
+      break;
+    }
+    n = BTOR_COUNT_STACK (reduced);
+    for (k = i; k < j; k++)
+    {
+      /* unchanged equations with odd pivot coefficient are left to variable
+       * substitution */
+      if (!eqs[k]->changed && !has_even_pivot (eqs[k])) continue;
+      BTOR_PUSH_STACK (reduced, eqs[k]);
+      if (eqs[k]->pivot) num_elims++;
+    }
+    if (BTOR_COUNT_STACK (reduced) > n) num_systems++;
+  }
+
+  if (inconsistent)
+  {
+    BTORLOG (1, "linear system has no solution");
+    fact = btor_exp_false (btor);
+    btor_assert_exp (btor, fact);
+    btor_node_release (btor, fact);
+  }
+  else if (!BTOR_EMPTY_STACK (reduced))
+  {
+    /* Replace the original equations with the reduced system.  The reduced
+     * system is created after the substitution, otherwise reduced equations
+     * that are structurally equal to original equations would be replaced
+     * as well. */
+    btor_init_substitutions (btor);
+    for (i = 0; i < BTOR_COUNT_STACK (reduced); i++)
+      btor_insert_substitution (
+          btor, BTOR_PEEK_STACK (reduced, i)->exp, btor->true_exp, false);
+    btor_substitute_and_rebuild (btor, btor->substitutions);
+    btor_delete_substitutions (btor);
+
+    for (i = 0; i < BTOR_COUNT_STACK (reduced); i++)
+      mk_facts (btor, BTOR_PEEK_STACK (reduced, i), &facts);
+    for (i = 0; i < BTOR_COUNT_STACK (facts); i++)
+    {
+      fact = BTOR_PEEK_STACK (facts, i);
+      BTORLOG (2, "linear fact: %s", btor_util_node2string (fact));
+      btor_assert_exp (btor, fact);
+      btor_node_release (btor, fact);
+    }
+  }
+
+  for (i = 0; i < BTOR_COUNT_STACK (lin_eqs); i++)
+    delete_lin_eq (btor, BTOR_PEEK_STACK (lin_eqs, i));
+  BTOR_RELEASE_STACK (lin_eqs);
+  BTOR_RELEASE_STACK (reduced);
+  BTOR_RELEASE_STACK (facts);
+
+  btor->stats.linear_systems += num_systems;
+  btor->stats.linear_system_elims += num_elims;
+  delta = btor_util_time_stamp () - start;
+  btor->time.linear += delta;
+  BTORLOG (1, "end solving linear systems");
+  BTOR_MSG (btor->msg,
+            1,
+            "eliminated %u variables in %u linear systems in %.3f seconds",
+            num_elims,
+            num_systems,
+            delta);
+}
@@ -0,0 +1,25 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORLINEAR_H_INCLUDED
+#define BTORLINEAR_H_INCLUDED
+
+#include "btortypes.h"
+
+/* Solve systems of top-level linear equations over bit-vectors of the same
+ * width jointly modulo 2^width.
+ *
+ * The equations are brought into echelon (Hermite) form by pivoting on the
+ * variable coefficient with the least number of trailing zeros.  A pivot
+ * variable with odd coefficient is substituted by the remaining terms of its
+ * equation, a pivot variable with coefficient 2^v * u (u odd) is substituted
+ * by a fresh variable for its upper v bits and the solution of its lower
+ * bits.  Equations that have no solution modulo 2^width make the formula
+ * inconsistent.  The original equations are replaced by the equivalent
+ * reduced system. */
+void btor_solve_linear_systems (Btor* btor);
+
+#endif
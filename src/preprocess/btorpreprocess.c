@@ -11,6 +11,7 @@
 
 #include "preprocess/btorpreprocess.h"
 
+#include "btorbvdomain.h"
 #include "btorcore.h"
 #include "btordbg.h"
 #include "btorexp.h"
@@ -22,8 +23,11 @@
 #include "preprocess/btorelimslices.h"
 #include "preprocess/btorembed.h"
 #include "preprocess/btorextract.h"
+#include "preprocess/btorlinear.h"
 #include "preprocess/btormerge.h"
 #include "preprocess/btornormadd.h"
+#include "preprocess/btorreducewidths.h"
+#include "preprocess/btorsatfacts.h"
 #include "preprocess/btorunconstrained.h"
 #include "preprocess/btorvarsubst.h"
 #ifndef BTOR_DO_NOT_PROCESS_SKELETON
@@ -33,6 +37,178 @@
 #include "utils/btornodeiter.h"
 #include "utils/btorutil.h"
 
+#include <string.h>
+
+/*------------------------------------------------------------------------*/
+
+/* Runs taking less time never cause a pass to be deferred. */
+#define BTOR_SIMP_PASS_MIN_TIME 0.01
+/* Minimum number of nodes per second a run has to remove to be productive. */
+#define BTOR_SIMP_PASS_MIN_YIELD 1000.0
+/* Maximum number of runs an unproductive pass is deferred. */
+#define BTOR_SIMP_PASS_MAX_BACKOFF 64
+
+static const char *const g_simp_pass_names[BTOR_SIMP_PASS_NUM] = {
+    "slice elimination",
+    "bit-width reduction",
+    "skeleton preprocessing",
+    "linear system solving",
+    "unconstrained optimization",
+    "lambda extraction",
+    "lambda merging",
+    "adder normalization",
+};
+
+struct BtorSimpSchedule
+{
+  bool adaptive;
+  double limit;                    /* time limit per pass in seconds */
+  double time[BTOR_SIMP_PASS_NUM]; /* time spent per pass in this call */
+  /* state at the start of the current run */
+  double start;
+  uint32_t nodes;
+  uint32_t substs;
+};
+
+typedef struct BtorSimpSchedule BtorSimpSchedule;
+
+static void
+init_schedule (Btor *btor, BtorSimpSchedule *sched)
+{
+  memset (sched, 0, sizeof (*sched));
+  sched->adaptive = btor_opt_get (btor, BTOR_OPT_SIMP_ADAPTIVE) != 0;
+  sched->limit = btor_opt_get (btor, BTOR_OPT_SIMP_PASS_TIME_LIMIT) / 1000.0;
+}
+
+static uint32_t
+count_substs (Btor *btor)
+{
+  return btor->varsubst_constraints->count
+         + btor->embedded_constraints->count;
+}
+
+/* Returns true if 'pass' is to be run in this round.  A pass is skipped if
+ * it used up its time limit for this call, or if it is deferred due to
+ * previous unproductive runs. */
+static bool
+begin_pass (Btor *btor, BtorSimpSchedule *sched, BtorSimpPass pass)
+{
+  BtorSimpPassStats *s;
+
+  s = &btor->simp_passes[pass];
+  if (sched->limit > 0 && sched->time[pass] >= sched->limit)
+  {
+    s->skipped++;
+    BTOR_MSG (btor->msg,
+              2,
+              "skipping %s, time limit of %.2f seconds reached",
+              g_simp_pass_names[pass],
+              sched->limit);
+    return false;
+  }
+  if (sched->adaptive && s->delay > 0)
+  {
+    s->delay--;
+    s->skipped++;
+    BTOR_MSG (btor->msg,
+              1,
+              "deferring %s (%u more runs)",
+              g_simp_pass_names[pass],
+              s->delay);
+    return false;
+  }
+  sched->nodes  = btor->nodes_unique_table.num_elements;
+  sched->substs = count_substs (btor);
+  sched->start  = btor_util_time_stamp ();
+  return true;
+}
+
+/* Record the yield of the run of 'pass' started with begin_pass.  A run is
+ * productive if it removed nodes at a rate of at least
+ * BTOR_SIMP_PASS_MIN_YIELD nodes per second or if it produced new
+ * substitution constraints (the nodes of which are removed in the next
+ * round).  Unproductive passes are deferred with exponential backoff. */
+static void
+end_pass (Btor *btor, BtorSimpSchedule *sched, BtorSimpPass pass)
+{
+  bool productive;
+  int_least64_t removed;
+  double delta, yield;
+  BtorSimpPassStats *s;
+
+  s       = &btor->simp_passes[pass];
+  delta   = btor_util_time_stamp () - sched->start;
+  removed = (int_least64_t) sched->nodes
+            - (int_least64_t) btor->nodes_unique_table.num_elements;
+  yield   = removed / BTOR_MAX_UTIL (delta, BTOR_SIMP_PASS_MIN_TIME);
+  sched->time[pass] += delta;
+  s->runs += 1;
+  s->time += delta;
+  s->removed += removed;
+
+  if (!sched->adaptive || delta < BTOR_SIMP_PASS_MIN_TIME) return;
+
+  productive = btor->inconsistent || count_substs (btor) > sched->substs
+               || (removed > 0 && yield >= BTOR_SIMP_PASS_MIN_YIELD);
+  if (productive)
+  {
+    s->backoff = 0;
+    return;
+  }
+  s->backoff = s->backoff ? BTOR_MIN_UTIL (2 * s->backoff,
+                                           BTOR_SIMP_PASS_MAX_BACKOFF)
+                          : 1;
+  s->delay   = s->backoff;
+  BTOR_MSG (btor->msg,
+            1,
+            "%s removed %lld nodes in %.2f seconds (%.0f nodes/s), "
+            "deferring for %u runs",
+            g_simp_pass_names[pass],
+            (long long) removed,
+            delta,
+            yield,
+            s->delay);
+}
+
+void
+btor_print_simp_pass_stats (Btor *btor)
+{
+  assert (btor);
+
+  uint32_t i;
+  BtorSimpPassStats *s;
+
+  if (!btor_opt_get (btor, BTOR_OPT_SIMP_ADAPTIVE)
+      && !btor_opt_get (btor, BTOR_OPT_SIMP_PASS_TIME_LIMIT))
+    return;
+
+  BTOR_MSG (btor->msg, 1, "");
+  BTOR_MSG (btor->msg, 1, "simplification pass schedule:");
+  BTOR_MSG (btor->msg,
+            1,
+            "  %6s %7s %10s %9s  %s",
+            "runs",
+            "skipped",
+            "removed",
+            "time",
+            "pass");
+  for (i = 0; i < BTOR_SIMP_PASS_NUM; i++)
+  {
+    s = &btor->simp_passes[i];
+    if (!s->runs && !s->skipped) continue;
+    BTOR_MSG (btor->msg,
+              1,
+              "  %6u %7u %10lld %8.2fs  %s",
+              s->runs,
+              s->skipped,
+              (long long) s->removed,
+              s->time,
+              g_simp_pass_names[i]);
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
 int32_t
 btor_simplify (Btor *btor)
 {
@@ -41,17 +217,23 @@ btor_simplify (Btor *btor)
   BtorSolverResult result;
   uint32_t rounds;
   double start, delta;
+  BtorSimpSchedule sched;
 #ifndef BTOR_DO_NOT_PROCESS_SKELETON
   uint32_t skelrounds = 0;
 #endif
 
   rounds = 0;
   start  = btor_util_time_stamp ();
+  init_schedule (btor, &sched);
 
   if (btor->valid_assignments) btor_reset_incremental_usage (btor);
 
   if (btor->inconsistent) goto DONE;
 
+  /* re-add definitions of unconstrained terms that are not unconstrained
+   * anymore due to constraints added since the last call */
+  if (btor->uc_defs->count) btor_restore_unconstrained (btor);
+
   /* empty varsubst_constraints table if variable substitution was disabled
    * after adding variable substitution constraints (they are still in
    * unsynthesized_constraints).
@@ -68,6 +250,15 @@ btor_simplify (Btor *btor)
     //       var_substitutions and var_rhs?
   }
 
+  /* import facts learned by the SAT solver in previous incremental calls */
+  if (btor_opt_get (btor, BTOR_OPT_SAT_FACTS)
+      && btor_opt_get (btor, BTOR_OPT_INCREMENTAL)
+      && btor->btor_sat_btor_called > 0)
+  {
+    btor_add_sat_facts (btor);
+    if (btor->inconsistent) goto DONE;
+  }
+
   do
   {
     rounds++;
@@ -107,9 +298,10 @@ btor_simplify (Btor *btor)
 
     if (btor_opt_get (btor, BTOR_OPT_ELIMINATE_SLICES)
         && btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
-        && !btor_opt_get (btor, BTOR_OPT_INCREMENTAL))
+        && begin_pass (btor, &sched, BTOR_SIMP_PASS_ELIMINATE_SLICES))
     {
       btor_eliminate_slices_on_bv_vars (btor);
+      end_pass (btor, &sched, BTOR_SIMP_PASS_ELIMINATE_SLICES);
       if (btor->inconsistent)
       {
         BTORLOG (1, "formula inconsistent after slice elimination");
@@ -121,14 +313,33 @@ btor_simplify (Btor *btor)
         continue;
     }
 
+    if (btor_opt_get (btor, BTOR_OPT_REDUCE_WIDTHS)
+        && btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
+        && begin_pass (btor, &sched, BTOR_SIMP_PASS_REDUCE_WIDTHS))
+    {
+      btor_reduce_widths (btor);
+      end_pass (btor, &sched, BTOR_SIMP_PASS_REDUCE_WIDTHS);
+      if (btor->inconsistent)
+      {
+        BTORLOG (1, "formula inconsistent after bit-width reduction");
+        break;
+      }
+
+      if (btor->varsubst_constraints->count
+          || btor->embedded_constraints->count)
+        continue;
+    }
+
 #ifndef BTOR_DO_NOT_PROCESS_SKELETON
     if (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
         && btor_opt_get (btor, BTOR_OPT_SKELETON_PREPROC))
     {
       skelrounds++;
-      if (skelrounds <= 1)  // TODO only one?
+      if (skelrounds <= 1  // TODO only one?
+          && begin_pass (btor, &sched, BTOR_SIMP_PASS_SKELETON))
       {
         btor_process_skeleton (btor);
+        end_pass (btor, &sched, BTOR_SIMP_PASS_SKELETON);
         if (btor->inconsistent)
         {
           BTORLOG (1, "formula inconsistent after skeleton preprocessing");
@@ -145,12 +356,32 @@ btor_simplify (Btor *btor)
     if (btor->varsubst_constraints->count || btor->embedded_constraints->count)
       continue;
 
+    if (btor_opt_get (btor, BTOR_OPT_SOLVE_LINEAR)
+        && btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 1
+        && begin_pass (btor, &sched, BTOR_SIMP_PASS_SOLVE_LINEAR))
+    {
+      btor_solve_linear_systems (btor);
+      end_pass (btor, &sched, BTOR_SIMP_PASS_SOLVE_LINEAR);
+      if (btor->inconsistent)
+      {
+        BTORLOG (1, "formula inconsistent after solving linear systems");
+        break;
+      }
+
+      if (btor->varsubst_constraints->count
+          || btor->embedded_constraints->count)
+        continue;
+    }
+
     if (btor_opt_get (btor, BTOR_OPT_UCOPT)
         && btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
-        && !btor_opt_get (btor, BTOR_OPT_INCREMENTAL)
-        && !btor_opt_get (btor, BTOR_OPT_MODEL_GEN))
+        && (!btor_opt_get (btor, BTOR_OPT_NONDESTR_SUBST)
+            || (!btor_opt_get (btor, BTOR_OPT_INCREMENTAL)
+                && !btor_opt_get (btor, BTOR_OPT_MODEL_GEN)))
+        && begin_pass (btor, &sched, BTOR_SIMP_PASS_UCOPT))
     {
       btor_optimize_unconstrained (btor);
+      end_pass (btor, &sched, BTOR_SIMP_PASS_UCOPT);
       if (btor->inconsistent)
       {
         BTORLOG (1, "formula inconsistent after skeleton preprocessing");
@@ -162,12 +393,20 @@ btor_simplify (Btor *btor)
       continue;
 
     if (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
-        && btor_opt_get (btor, BTOR_OPT_EXTRACT_LAMBDAS))
+        && btor_opt_get (btor, BTOR_OPT_EXTRACT_LAMBDAS)
+        && begin_pass (btor, &sched, BTOR_SIMP_PASS_EXTRACT_LAMBDAS))
+    {
       btor_extract_lambdas (btor);
+      end_pass (btor, &sched, BTOR_SIMP_PASS_EXTRACT_LAMBDAS);
+    }
 
     if (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
-        && btor_opt_get (btor, BTOR_OPT_MERGE_LAMBDAS))
+        && btor_opt_get (btor, BTOR_OPT_MERGE_LAMBDAS)
+        && begin_pass (btor, &sched, BTOR_SIMP_PASS_MERGE_LAMBDAS))
+    {
       btor_merge_lambdas (btor);
+      end_pass (btor, &sched, BTOR_SIMP_PASS_MERGE_LAMBDAS);
+    }
 
     if (btor->varsubst_constraints->count || btor->embedded_constraints->count)
       continue;
@@ -193,12 +432,19 @@ btor_simplify (Btor *btor)
       btor_add_ackermann_constraints (btor);
 
     if (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
-        && btor_opt_get (btor, BTOR_OPT_SIMP_NORMAMLIZE_ADDERS))
+        && btor_opt_get (btor, BTOR_OPT_SIMP_NORMAMLIZE_ADDERS)
+        && begin_pass (btor, &sched, BTOR_SIMP_PASS_NORMALIZE_ADDS))
+    {
       btor_normalize_adds (btor);
+      end_pass (btor, &sched, BTOR_SIMP_PASS_NORMALIZE_ADDS);
+    }
 
   } while (btor->varsubst_constraints->count
            || btor->embedded_constraints->count);
 
+  if (!btor->inconsistent && btor_opt_get (btor, BTOR_OPT_BV_DOMAIN))
+    btor_bvdomain_propagate (btor);
+
 DONE:
   delta = btor_util_time_stamp () - start;
   btor->time.simplify += delta;
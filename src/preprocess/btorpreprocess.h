@@ -15,4 +15,8 @@
 
 int32_t btor_simplify (Btor* btor);
 
+/* Print runs, skipped runs, removed nodes and time of the simplification
+ * passes scheduled by btor_simplify. */
+void btor_print_simp_pass_stats (Btor* btor);
+
 #endif
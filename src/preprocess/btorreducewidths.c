@@ -0,0 +1,462 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "preprocess/btorreducewidths.h"
+
+#include "btorbvdomain.h"
+#include "btorcore.h"
+#include "btordbg.h"
+#include "btorexp.h"
+#include "btorlog.h"
+#include "btormsg.h"
+#include "btorsubst.h"
+#include "utils/btorhashint.h"
+#include "utils/btornodeiter.h"
+#include "utils/btorutil.h"
+
+/*------------------------------------------------------------------------*/
+
+static bool
+is_bv (Btor *btor, BtorNode *exp)
+{
+  return btor_sort_is_bv (btor, btor_node_get_sort_id (exp));
+}
+
+/* Number of least significant bits of 'exp' that determine its unsigned
+ * value, i.e., all bits above are known to be 0. */
+static uint32_t
+get_unsigned_width (Btor *btor, BtorNode *exp)
+{
+  uint32_t i, width;
+  BtorBvDomain *d;
+
+  d     = btor_bvdomain_get (btor, exp);
+  width = btor_bvdomain_get_width (d);
+  for (i = width; i > 1 && btor_bvdomain_is_fixed_bit_false (d, i - 1); i--)
+    ;
+  btor_bvdomain_free (btor->mm, d);
+  return i;
+}
+
+/* Returns true if 'exp' is the sign extension of 'arg' as created by
+ * btor_exp_bv_sext. */
+static bool
+is_sext (Btor *btor, BtorNode *exp, BtorNode **arg)
+{
+  uint32_t width;
+  BtorNode *real_exp, *ext, *real_ext, *msb, *e_if, *e_else;
+
+  real_exp = btor_node_real_addr (exp);
+  if (btor_node_is_inverted (exp) || !btor_node_is_bv_concat (real_exp))
+    return false;
+
+  ext      = real_exp->e[0];
+  real_ext = btor_node_real_addr (ext);
+  width    = btor_node_bv_get_width (btor, real_exp->e[1]);
+
+  if (btor_node_is_bv_cond (real_ext))
+  {
+    msb    = real_ext->e[0];
+    e_if   = btor_node_cond_invert (ext, real_ext->e[1]);
+    e_else = btor_node_cond_invert (ext, real_ext->e[2]);
+    if (!btor_node_is_bv_const_ones (btor, e_if)
+        || !btor_node_is_bv_const_zero (btor, e_else))
+      return false;
+  }
+  else if (btor_node_bv_get_width (btor, ext) == 1)
+    msb = ext;
+  else
+    return false;
+
+  if (btor_node_is_inverted (msb) || !btor_node_is_bv_slice (msb)
+      || msb->e[0] != real_exp->e[1]
+      || btor_node_bv_slice_get_upper (msb) != width - 1
+      || btor_node_bv_slice_get_lower (msb) != width - 1)
+    return false;
+
+  *arg = real_exp->e[1];
+  return true;
+}
+
+/* Number of least significant bits of 'exp' that determine its signed
+ * value, i.e., all bits above are copies of the most significant one. */
+static uint32_t
+get_signed_width (Btor *btor, BtorNode *exp)
+{
+  bool msb;
+  uint32_t i, width, res;
+  BtorNode *arg;
+  BtorBvDomain *d;
+
+  d     = btor_bvdomain_get (btor, exp);
+  width = btor_bvdomain_get_width (d);
+  res   = width;
+  if (btor_bvdomain_is_fixed_bit (d, width - 1))
+  {
+    msb = btor_bvdomain_is_fixed_bit_true (d, width - 1);
+    for (i = width - 1; i > 0; i--)
+    {
+      if (!btor_bvdomain_is_fixed_bit (d, i - 1)
+          || btor_bvdomain_is_fixed_bit_true (d, i - 1) != msb)
+        break;
+    }
+    /* bits [width - 1, i] are equal, keep one of them as sign bit */
+    res = i + 1;
+  }
+  btor_bvdomain_free (btor->mm, d);
+
+  if (is_sext (btor, exp, &arg))
+    res = BTOR_MIN_UTIL (res, get_signed_width (btor, arg));
+  return res;
+}
+
+/* Determine the minimal width on which the operation 'exp' can be performed
+ * without changing its value, and whether its result has to be sign
+ * extended (rather than zero extended) to the original width. */
+static uint32_t
+get_exact_width (Btor *btor, BtorNode *exp, bool *sign)
+{
+  assert (btor_node_is_regular (exp));
+
+  uint32_t uw[2], sw[2], ku, ks;
+
+  uw[0] = get_unsigned_width (btor, exp->e[0]);
+  uw[1] = get_unsigned_width (btor, exp->e[1]);
+  sw[0] = get_signed_width (btor, exp->e[0]);
+  sw[1] = get_signed_width (btor, exp->e[1]);
+
+  switch (exp->kind)
+  {
+    case BTOR_BV_ADD_NODE:
+      ku = BTOR_MAX_UTIL (uw[0], uw[1]) + 1;
+      ks = BTOR_MAX_UTIL (sw[0], sw[1]) + 1;
+      break;
+    case BTOR_BV_MUL_NODE:
+      ku = uw[0] + uw[1];
+      ks = sw[0] + sw[1];
+      break;
+    case BTOR_BV_AND_NODE:
+      ku = BTOR_MIN_UTIL (uw[0], uw[1]);
+      ks = BTOR_MAX_UTIL (sw[0], sw[1]);
+      break;
+    case BTOR_BV_UREM_NODE:
+      ku = BTOR_MAX_UTIL (uw[0], uw[1]);
+      ks = UINT32_MAX;
+      break;
+    default:
+      /* unsigned comparisons are preserved by zero and sign extension */
+      assert (btor_node_is_bv_eq (exp) || btor_node_is_bv_ult (exp));
+      ku = BTOR_MAX_UTIL (uw[0], uw[1]);
+      ks = BTOR_MAX_UTIL (sw[0], sw[1]);
+  }
+  *sign = ks < ku;
+  return BTOR_MIN_UTIL (ku, ks);
+}
+
+/* Create operation 'exp' on the 'width' least significant bits of its
+ * bit-vector operands. */
+static BtorNode *
+mk_reduced (Btor *btor, BtorNode *exp, uint32_t width)
+{
+  assert (btor_node_is_regular (exp));
+  assert (width > 0);
+
+  uint32_t i;
+  BtorNode *e[3], *res;
+
+  for (i = 0; i < exp->arity; i++)
+  {
+    if (btor_node_is_bv_cond (exp) && i == 0)
+      e[i] = btor_node_copy (btor, exp->e[i]);
+    else
+      e[i] = btor_exp_bv_slice (btor, exp->e[i], width - 1, 0);
+  }
+
+  switch (exp->kind)
+  {
+    case BTOR_BV_ADD_NODE: res = btor_exp_bv_add (btor, e[0], e[1]); break;
+    case BTOR_BV_MUL_NODE: res = btor_exp_bv_mul (btor, e[0], e[1]); break;
+    case BTOR_BV_AND_NODE: res = btor_exp_bv_and (btor, e[0], e[1]); break;
+    case BTOR_BV_UREM_NODE: res = btor_exp_bv_urem (btor, e[0], e[1]); break;
+    case BTOR_BV_EQ_NODE: res = btor_exp_eq (btor, e[0], e[1]); break;
+    case BTOR_BV_ULT_NODE: res = btor_exp_bv_ult (btor, e[0], e[1]); break;
+    default:
+      assert (btor_node_is_bv_cond (exp));
+      res = btor_exp_cond (btor, e[0], e[1], e[2]);
+  }
+
+  for (i = 0; i < exp->arity; i++) btor_node_release (btor, e[i]);
+  return res;
+}
+
+static void
+add_demand (BtorIntHashTable *demands, BtorNode *exp, uint32_t width)
+{
+  BtorHashTableData *d;
+
+  exp = btor_node_real_addr (exp);
+  if (!(d = btor_hashint_map_get (demands, exp->id)))
+    d = btor_hashint_map_add (demands, exp->id);
+  if ((uint32_t) d->as_int < width) d->as_int = width;
+}
+
+/* Record the number of least significant bits of the operands of 'exp'
+ * that are observed if 'width' least significant bits of 'exp' are. */
+static void
+add_demands (Btor *btor,
+             BtorIntHashTable *demands,
+             BtorNode *exp,
+             uint32_t width)
+{
+  assert (btor_node_is_regular (exp));
+
+  uint32_t i, lower, width_e1;
+
+  if (exp->parameterized)
+  {
+    for (i = 0; i < exp->arity; i++)
+      if (is_bv (btor, exp->e[i]))
+        add_demand (
+            demands, exp->e[i], btor_node_bv_get_width (btor, exp->e[i]));
+    return;
+  }
+
+  switch (exp->kind)
+  {
+    case BTOR_BV_SLICE_NODE:
+      lower = btor_node_bv_slice_get_lower (exp);
+      add_demand (demands, exp->e[0], lower + width);
+      break;
+
+    case BTOR_BV_CONCAT_NODE:
+      width_e1 = btor_node_bv_get_width (btor, exp->e[1]);
+      add_demand (demands, exp->e[1], BTOR_MIN_UTIL (width, width_e1));
+      if (width > width_e1)
+        add_demand (demands, exp->e[0], width - width_e1);
+      break;
+
+    case BTOR_BV_AND_NODE:
+    case BTOR_BV_ADD_NODE:
+    case BTOR_BV_MUL_NODE:
+      add_demand (demands, exp->e[0], width);
+      add_demand (demands, exp->e[1], width);
+      break;
+
+    case BTOR_BV_SLL_NODE:
+      add_demand (demands, exp->e[0], width);
+      add_demand (
+          demands, exp->e[1], btor_node_bv_get_width (btor, exp->e[1]));
+      break;
+
+    case BTOR_COND_NODE:
+      if (is_bv (btor, exp))
+      {
+        add_demand (demands, exp->e[0], 1);
+        add_demand (demands, exp->e[1], width);
+        add_demand (demands, exp->e[2], width);
+        break;
+      }
+      /* fall through */
+
+    default:
+      for (i = 0; i < exp->arity; i++)
+        if (is_bv (btor, exp->e[i]))
+          add_demand (
+              demands, exp->e[i], btor_node_bv_get_width (btor, exp->e[i]));
+  }
+}
+
+void
+btor_reduce_widths (Btor *btor)
+{
+  assert (btor);
+  assert (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2);
+
+  bool sign, trunc_vars, trunc_ops;
+  uint32_t i, width, demand, k, num_vars, num_ops;
+  double start, delta;
+  BtorNode *cur, *subst, *tmp;
+  BtorNodePtrStack visit, nodes;
+  BtorPtrHashTableIterator it;
+  BtorIntHashTable *mark, *demands;
+  BtorHashTableData *d;
+  BtorSortId sort;
+  BtorMemMgr *mm;
+
+  if (btor->unsynthesized_constraints->count == 0
+      && btor->synthesized_constraints->count == 0)
+    return;
+
+  start = btor_util_time_stamp ();
+  mm    = btor->mm;
+
+  BTORLOG (1, "start bit-width reduction");
+
+  /* Upper bits that are not observed by the constraints may only be dropped
+   * if no further constraints are added.  Models of variables are
+   * reconstructed via the substitution, but assignments of other terms
+   * would change. */
+  trunc_vars = !btor_opt_get (btor, BTOR_OPT_INCREMENTAL);
+  trunc_ops  = trunc_vars && !btor_opt_get (btor, BTOR_OPT_MODEL_GEN);
+
+  BTOR_INIT_STACK (mm, visit);
+  BTOR_INIT_STACK (mm, nodes);
+  mark    = btor_hashint_table_new (mm);
+  demands = btor_hashint_map_new (mm);
+  btor_init_substitutions (btor);
+
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->synthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->embedded_constraints);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    cur = btor_iter_hashptr_next (&it);
+    BTOR_PUSH_STACK (visit, cur);
+    add_demand (demands, cur, 1);
+  }
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = btor_node_real_addr (BTOR_POP_STACK (visit));
+    if (btor_hashint_table_contains (mark, cur->id)) continue;
+    btor_hashint_table_add (mark, cur->id);
+    BTOR_PUSH_STACK (nodes, cur);
+    for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (visit, cur->e[i]);
+  }
+
+  /* process parents before their children */
+  qsort (nodes.start,
+         BTOR_COUNT_STACK (nodes),
+         sizeof (BtorNode *),
+         btor_node_compare_by_id_qsort_desc);
+
+  num_vars = num_ops = 0;
+  for (i = 0; i < BTOR_COUNT_STACK (nodes); i++)
+  {
+    cur = BTOR_PEEK_STACK (nodes, i);
+    assert (!btor_node_is_simplified (cur));
+
+    if (!is_bv (btor, cur) || cur->parameterized)
+    {
+      add_demands (btor, demands, cur, 0);
+      continue;
+    }
+
+    width  = btor_node_bv_get_width (btor, cur);
+    d      = btor_hashint_map_get (demands, cur->id);
+    demand = d && d->as_int > 0 ? (uint32_t) d->as_int : 1;
+    assert (demand <= width);
+    subst = 0;
+
+    switch (cur->kind)
+    {
+      case BTOR_VAR_NODE:
+        if (!trunc_vars || demand == width) break;
+        sort = btor_sort_bv (btor, demand);
+        tmp  = btor_exp_var (btor, sort, 0);
+        btor_sort_release (btor, sort);
+        subst = btor_exp_bv_uext (btor, tmp, width - demand);
+        btor_node_release (btor, tmp);
+        BTORLOG (2,
+                 "reduce %s to %u bits",
+                 btor_util_node2string (cur),
+                 demand);
+        num_vars += 1;
+        break;
+
+      case BTOR_BV_ADD_NODE:
+      case BTOR_BV_MUL_NODE:
+      case BTOR_BV_AND_NODE:
+        k = get_exact_width (btor, cur, &sign);
+        if (trunc_ops && demand < BTOR_MIN_UTIL (k, width))
+        {
+          k    = demand;
+          sign = false;
+        }
+        if (k >= width)
+        {
+          add_demands (btor, demands, cur, demand);
+          break;
+        }
+        tmp   = mk_reduced (btor, cur, k);
+        subst = sign ? btor_exp_bv_sext (btor, tmp, width - k)
+                     : btor_exp_bv_uext (btor, tmp, width - k);
+        btor_node_release (btor, tmp);
+        add_demands (btor, demands, cur, k);
+        num_ops += 1;
+        break;
+
+      case BTOR_BV_UREM_NODE:
+      case BTOR_BV_EQ_NODE:
+      case BTOR_BV_ULT_NODE:
+        /* width of the operands */
+        width = btor_node_bv_get_width (btor, cur->e[0]);
+        k     = get_exact_width (btor, cur, &sign);
+        if (k >= width)
+        {
+          add_demands (btor, demands, cur, demand);
+          break;
+        }
+        tmp = mk_reduced (btor, cur, k);
+        if (btor_node_is_bv_urem (cur))
+        {
+          /* the remainder is bounded by both operands */
+          subst = btor_exp_bv_uext (btor, tmp, width - k);
+          btor_node_release (btor, tmp);
+        }
+        else
+          subst = tmp;
+        add_demand (demands, cur->e[0], k);
+        add_demand (demands, cur->e[1], k);
+        num_ops += 1;
+        break;
+
+      case BTOR_COND_NODE:
+        if (!trunc_ops || demand == width)
+        {
+          add_demands (btor, demands, cur, demand);
+          break;
+        }
+        tmp   = mk_reduced (btor, cur, demand);
+        subst = btor_exp_bv_uext (btor, tmp, width - demand);
+        btor_node_release (btor, tmp);
+        add_demands (btor, demands, cur, demand);
+        num_ops += 1;
+        break;
+
+      default: add_demands (btor, demands, cur, demand);
+    }
+
+    if (subst)
+    {
+      if (btor_node_real_addr (subst) != cur)
+        btor_insert_substitution (btor, cur, subst, false);
+      btor_node_release (btor, subst);
+    }
+  }
+
+  btor_substitute_and_rebuild (btor, btor->substitutions);
+  btor_delete_substitutions (btor);
+
+  btor_hashint_table_delete (mark);
+  btor_hashint_map_delete (demands);
+  BTOR_RELEASE_STACK (visit);
+  BTOR_RELEASE_STACK (nodes);
+
+  btor->stats.reduced_width_vars += num_vars;
+  btor->stats.reduced_width_ops += num_ops;
+  delta = btor_util_time_stamp () - start;
+  btor->time.reduce_widths += delta;
+  BTORLOG (1, "end bit-width reduction");
+  BTOR_MSG (btor->msg,
+            1,
+            "reduced width of %u variables and %u operations in %.3f seconds",
+            num_vars,
+            num_ops,
+            delta);
+  assert (btor_dbg_check_all_hash_tables_proxy_free (btor));
+  assert (btor_dbg_check_all_hash_tables_simp_free (btor));
+  assert (btor_dbg_check_unique_table_children_proxy_free (btor));
+}
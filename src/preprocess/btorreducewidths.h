@@ -0,0 +1,23 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORREDUCEWIDTHS_H_INCLUDED
+#define BTORREDUCEWIDTHS_H_INCLUDED
+
+#include "btortypes.h"
+
+/* Reduce the bit-width of bit-vector variables and operations.
+ *
+ * Operations on zero- and sign-extended operands (or operands with known
+ * leading bits) are performed on the minimal width that yields the same
+ * result.  If incremental solving is disabled, variables whose upper bits
+ * are never observed are further replaced by zero-extended fresh variables
+ * of smaller width (models of the original variables are reconstructed via
+ * the substitution), and if model generation is disabled, the same is done
+ * for arithmetic operations. */
+void btor_reduce_widths (Btor *btor);
+
+#endif
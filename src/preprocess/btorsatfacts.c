@@ -0,0 +1,274 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "preprocess/btorsatfacts.h"
+
+#include "btoraig.h"
+#include "btoraigvec.h"
+#include "btorcore.h"
+#include "btorexp.h"
+#include "btorlog.h"
+#include "btormsg.h"
+#include "btorsat.h"
+#include "utils/btorstack.h"
+#include "utils/btorutil.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* encoding of constant bits in AIG vector signatures */
+#define BTOR_SAT_FACTS_TRUE INT32_MAX
+
+struct BtorSATFactsNode
+{
+  BtorNode *exp;
+  uint32_t hash;
+  int32_t *sig; /* simplified AIG ids of the bits of 'exp' */
+};
+
+typedef struct BtorSATFactsNode BtorSATFactsNode;
+
+BTOR_DECLARE_STACK (BtorSATFactsNode, BtorSATFactsNode);
+
+static int32_t
+get_bit (BtorAIGMgr *amgr, BtorAIG *aig)
+{
+  if (!btor_aig_is_const (aig)) aig = btor_aig_simp_by_sat (amgr, aig);
+  if (btor_aig_is_true (aig)) return BTOR_SAT_FACTS_TRUE;
+  if (btor_aig_is_false (aig)) return -BTOR_SAT_FACTS_TRUE;
+  return btor_aig_get_id (aig);
+}
+
+static uint32_t
+hash_sig (int32_t *sig, uint32_t width)
+{
+  uint32_t i, res;
+
+  for (i = 0, res = 0; i < width; i++)
+  {
+    res += (uint32_t) sig[i];
+    res *= 7334147u;
+  }
+  return res;
+}
+
+static int32_t
+compare_sat_facts_nodes (const void *p1, const void *p2)
+{
+  const BtorSATFactsNode *n1, *n2;
+  uint32_t w1, w2;
+
+  n1 = (const BtorSATFactsNode *) p1;
+  n2 = (const BtorSATFactsNode *) p2;
+  w1 = n1->exp->av->width;
+  w2 = n2->exp->av->width;
+  if (w1 != w2) return w1 < w2 ? -1 : 1;
+  if (n1->hash != n2->hash) return n1->hash < n2->hash ? -1 : 1;
+  return n1->exp->id < n2->exp->id ? -1 : 1;
+}
+
+/* Create the term that represents variable 'var' with the bits fixed in
+ * signature 'sig' replaced by constants. */
+static BtorNode *
+mk_fixed_var (Btor *btor, BtorNode *var, int32_t *sig)
+{
+  uint32_t i, j, k, width;
+  bool fixed;
+  BtorNode *res, *part, *tmp;
+  BtorBitVector *bits;
+  BtorSortId sort;
+
+  width = btor_node_bv_get_width (btor, var);
+  res   = 0;
+  for (i = 0; i < width; i = j)
+  {
+    /* aigs[0] is the MSB */
+    fixed = abs (sig[i]) == BTOR_SAT_FACTS_TRUE;
+    for (j = i + 1;
+         j < width && (abs (sig[j]) == BTOR_SAT_FACTS_TRUE) == fixed;
+         j++)
+      ;
+    if (fixed)
+    {
+      bits = btor_bv_new (btor->mm, j - i);
+      for (k = i; k < j; k++)
+        btor_bv_set_bit (bits, j - 1 - k, sig[k] > 0 ? 1 : 0);
+      part = btor_exp_bv_const (btor, bits);
+      btor_bv_free (btor->mm, bits);
+    }
+    else
+    {
+      sort = btor_sort_bv (btor, j - i);
+      part = btor_exp_var (btor, sort, 0);
+      btor_sort_release (btor, sort);
+    }
+
+    if (res)
+    {
+      tmp = btor_exp_bv_concat (btor, res, part);
+      btor_node_release (btor, res);
+      btor_node_release (btor, part);
+      res = tmp;
+    }
+    else
+      res = part;
+  }
+  return res;
+}
+
+void
+btor_add_sat_facts (Btor *btor)
+{
+  assert (btor);
+
+  size_t i, j, k, cnt, nunits;
+  uint32_t width, nfixed, num_units, num_equiv;
+  double start, delta;
+  BtorNode *cur, *rep, *fact, *tmp;
+  BtorNodePtrStack facts;
+  BtorSATFactsNode n;
+  BtorSATFactsNodeStack nodes;
+  BtorIntHashTable *done;
+  BtorAIGMgr *amgr;
+  BtorMemMgr *mm;
+
+  if (!btor_sat_is_initialized (btor_get_sat_mgr (btor))) return;
+
+  start = btor_util_time_stamp ();
+  mm    = btor->mm;
+  amgr  = btor_get_aig_mgr (btor);
+
+  BTORLOG (1, "start importing SAT facts");
+
+  BTOR_INIT_STACK (mm, facts);
+  BTOR_INIT_STACK (mm, nodes);
+
+  /* fixed bits */
+  cnt = BTOR_COUNT_STACK (btor->nodes_id_table);
+  for (i = 1; i < cnt; i++)
+  {
+    cur = BTOR_PEEK_STACK (btor->nodes_id_table, i);
+    if (!cur || !btor_node_is_synth (cur) || btor_node_is_simplified (cur)
+        || btor_node_is_proxy (cur) || btor_node_is_bv_const (cur)
+        || cur->parameterized || btor_node_is_fun (cur))
+      continue;
+
+    width = cur->av->width;
+    BTOR_NEWN (mm, n.sig, width);
+    for (j = 0, nfixed = 0; j < width; j++)
+    {
+      n.sig[j] = get_bit (amgr, cur->av->aigs[j]);
+      if (abs (n.sig[j]) == BTOR_SAT_FACTS_TRUE) nfixed++;
+    }
+
+    fact = 0;
+    if (btor_node_is_bv_var (cur) && nfixed > 0)
+    {
+      tmp  = mk_fixed_var (btor, cur, n.sig);
+      fact = btor_exp_eq (btor, cur, tmp);
+      btor_node_release (btor, tmp);
+    }
+    else if (width == 1 && nfixed == 1 && !cur->constraint)
+    {
+      fact = btor_node_copy (btor, cur);
+      if (n.sig[0] < 0) fact = btor_node_invert (fact);
+    }
+
+    if (fact)
+    {
+      BTOR_PUSH_STACK (facts, fact);
+      BTOR_DELETEN (mm, n.sig, width);
+    }
+    else if (nfixed == width)
+      BTOR_DELETEN (mm, n.sig, width);
+    else
+    {
+      n.exp  = cur;
+      n.hash = hash_sig (n.sig, width);
+      BTOR_PUSH_STACK (nodes, n);
+    }
+  }
+  nunits    = BTOR_COUNT_STACK (facts);
+  num_units = nunits;
+
+  /* equivalent terms, we only consider equalities with variables since only
+   * these can be eliminated by variable substitution */
+  qsort (nodes.start,
+         BTOR_COUNT_STACK (nodes),
+         sizeof (BtorSATFactsNode),
+         compare_sat_facts_nodes);
+  done = btor_hashint_table_new (mm);
+  for (i = 0; i < BTOR_COUNT_STACK (nodes); i++)
+  {
+    cur = BTOR_PEEK_STACK (nodes, i).exp;
+    if (btor_hashint_table_contains (done, cur->id)) continue;
+
+    /* find representative, prefer terms over variables */
+    rep = btor_node_is_bv_var (cur) ? 0 : cur;
+    for (j = i + 1; !rep && j < BTOR_COUNT_STACK (nodes); j++)
+    {
+      if (nodes.start[i].hash != nodes.start[j].hash
+          || nodes.start[i].exp->av->width != nodes.start[j].exp->av->width)
+        break;
+      if (!btor_node_is_bv_var (nodes.start[j].exp)
+          && !memcmp (nodes.start[i].sig,
+                      nodes.start[j].sig,
+                      sizeof (int32_t) * cur->av->width))
+        rep = nodes.start[j].exp;
+    }
+    if (!rep) rep = cur;
+
+    for (j = i; j < BTOR_COUNT_STACK (nodes); j++)
+    {
+      if (nodes.start[i].hash != nodes.start[j].hash
+          || nodes.start[i].exp->av->width != nodes.start[j].exp->av->width)
+        break;
+      if (memcmp (nodes.start[i].sig,
+                  nodes.start[j].sig,
+                  sizeof (int32_t) * cur->av->width))
+        continue;
+      btor_hashint_table_add (done, nodes.start[j].exp->id);
+      if (nodes.start[j].exp == rep
+          || !btor_node_is_bv_var (nodes.start[j].exp))
+        continue;
+      BTOR_PUSH_STACK (facts, btor_exp_eq (btor, nodes.start[j].exp, rep));
+    }
+  }
+  btor_hashint_table_delete (done);
+  num_equiv = BTOR_COUNT_STACK (facts) - num_units;
+
+  for (k = 0; k < BTOR_COUNT_STACK (nodes); k++)
+    BTOR_DELETEN (mm, nodes.start[k].sig, nodes.start[k].exp->av->width);
+  BTOR_RELEASE_STACK (nodes);
+
+  for (k = 0; k < BTOR_COUNT_STACK (facts); k++)
+  {
+    fact = BTOR_PEEK_STACK (facts, k);
+    if (!btor_node_real_addr (fact)->constraint)
+    {
+      BTORLOG (2, "SAT fact: %s", btor_util_node2string (fact));
+      btor_assert_exp (btor, fact);
+    }
+    else if (k < nunits)
+      num_units -= 1;
+    else
+      num_equiv -= 1;
+    btor_node_release (btor, fact);
+  }
+  BTOR_RELEASE_STACK (facts);
+
+  btor->stats.sat_facts_units += num_units;
+  btor->stats.sat_facts_equiv += num_equiv;
+  delta = btor_util_time_stamp () - start;
+  btor->time.sat_facts += delta;
+  BTORLOG (1, "end importing SAT facts");
+  BTOR_MSG (btor->msg,
+            1,
+            "imported %u fixed and %u equivalence SAT facts in %.3f seconds",
+            num_units,
+            num_equiv,
+            delta);
+}
@@ -0,0 +1,18 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORSATFACTS_H_INCLUDED
+#define BTORSATFACTS_H_INCLUDED
+
+#include "btortypes.h"
+
+/* Map literals fixed by the SAT solver at the root level and equivalent
+ * literals back to the synthesized expressions and assert them as word-level
+ * facts (constant bits of variables, fixed Boolean terms and variables that
+ * are equal to other terms) for subsequent incremental calls. */
+void btor_add_sat_facts (Btor *btor);
+
+#endif
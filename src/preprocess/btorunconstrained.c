@@ -11,10 +11,12 @@
 
 #include "preprocess/btorunconstrained.h"
 
+#include "btorbv.h"
 #include "btorcore.h"
 #include "btordbg.h"
 #include "btorexp.h"
 #include "btorlog.h"
+#include "btormodel.h"
 #include "btormsg.h"
 #include "btorsubst.h"
 #include "utils/btorhashint.h"
@@ -38,8 +40,74 @@ is_uc_write (BtorNode *cond)
   return btor_node_lambda_get_static_rho (lambda) != 0;
 }
 
+/* Check whether the values of the unconstrained children of 'exp' can be
+ * reconstructed from a value of 'exp'. */
+static bool
+is_reconstructible (BtorNode *exp)
+{
+  assert (btor_node_is_regular (exp));
+
+  if (exp->parameterized) return false;
+
+  switch (exp->kind)
+  {
+    case BTOR_BV_SLICE_NODE:
+    case BTOR_BV_ADD_NODE:
+    case BTOR_BV_EQ_NODE:
+    case BTOR_BV_ULT_NODE:
+    case BTOR_BV_CONCAT_NODE:
+    case BTOR_BV_AND_NODE:
+    case BTOR_BV_MUL_NODE:
+    case BTOR_BV_SLL_NODE:
+    case BTOR_BV_SRL_NODE:
+    case BTOR_BV_UDIV_NODE:
+    case BTOR_BV_UREM_NODE: return true;
+    case BTOR_COND_NODE: return !btor_node_is_fun (exp);
+    default: return false;
+  }
+}
+
+static void
+add_uc_def (Btor *btor, BtorIntHashTable *uc, BtorNode *exp, BtorNode *subst)
+{
+  assert (is_reconstructible (exp));
+  assert (!btor_hashptr_table_get (btor->uc_defs, subst));
+
+  uint32_t i;
+  BtorUCDef *def;
+
+  BTOR_CNEW (btor->mm, def);
+  def->kind  = exp->kind;
+  def->arity = exp->arity;
+  if (btor_node_is_bv_slice (exp))
+  {
+    def->upper = btor_node_bv_slice_get_upper (exp);
+    def->lower = btor_node_bv_slice_get_lower (exp);
+  }
+  for (i = 0; i < exp->arity; i++)
+  {
+    def->e[i]  = btor_node_copy (btor, exp->e[i]);
+    def->uc[i] = btor_hashint_table_contains (
+        uc, btor_node_real_addr (exp->e[i])->id);
+  }
+  btor_hashptr_table_add (btor->uc_defs, btor_node_copy (btor, subst))
+      ->data.as_ptr = def;
+}
+
+void
+btor_delete_uc_def (Btor *btor, BtorUCDef *def)
+{
+  assert (btor);
+  assert (def);
+
+  uint32_t i;
+
+  for (i = 0; i < def->arity; i++) btor_node_release (btor, def->e[i]);
+  BTOR_DELETE (btor->mm, def);
+}
+
 static void
-mark_uc (Btor *btor, BtorIntHashTable *uc, BtorNode *exp)
+mark_uc (Btor *btor, BtorIntHashTable *uc, BtorNode *exp, bool keep_def)
 {
   assert (btor_node_is_regular (exp));
   /* no inputs allowed here */
@@ -76,6 +144,7 @@ mark_uc (Btor *btor, BtorIntHashTable *uc, BtorNode *exp)
   else
     subst = btor_exp_var (btor, btor_node_get_sort_id (exp), 0);
 
+  if (keep_def) add_uc_def (btor, uc, exp, subst);
   btor_insert_substitution (btor, exp, subst, false);
   btor_node_release (btor, subst);
 }
@@ -85,12 +154,10 @@ btor_optimize_unconstrained (Btor *btor)
 {
   assert (btor);
   assert (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2);
-  assert (!btor_opt_get (btor, BTOR_OPT_INCREMENTAL));
-  assert (!btor_opt_get (btor, BTOR_OPT_MODEL_GEN));
 
   double start, delta;
   uint32_t i, num_ucs;
-  bool uc[3], ucp[3];
+  bool uc[3], ucp[3], keep_defs;
   BtorNode *cur, *cur_parent;
   BtorNodePtrStack stack, roots;
   BtorPtrHashTableIterator it;
@@ -109,6 +176,13 @@ btor_optimize_unconstrained (Btor *btor)
   mm    = btor->mm;
   BTOR_INIT_STACK (mm, stack);
   BTOR_INIT_STACK (mm, roots);
+
+  /* With model generation or incremental solving enabled, only terms whose
+   * unconstrained inputs can be reconstructed from their value are
+   * substituted, and their definitions are kept (see btor->uc_defs). */
+  keep_defs = btor_opt_get (btor, BTOR_OPT_MODEL_GEN)
+              || btor_opt_get (btor, BTOR_OPT_INCREMENTAL);
+  assert (!keep_defs || !btor_opt_get (btor, BTOR_OPT_NONDESTR_SUBST));
   uc[0] = uc[1] = uc[2] = ucp[0] = ucp[1] = ucp[2] = false;
 
   mark = btor_hashint_map_new (mm);
@@ -204,6 +278,8 @@ btor_optimize_unconstrained (Btor *btor)
           assert (!ucp[i] || cur->parameterized || btor_node_is_lambda (cur));
         }
 
+        if (keep_defs && !is_reconstructible (cur)) continue;
+
         switch (cur->kind)
         {
           case BTOR_BV_SLICE_NODE:
@@ -212,17 +288,17 @@ btor_optimize_unconstrained (Btor *btor)
             {
               if (cur->parameterized)
               {
-                if (btor_node_is_apply (cur)) mark_uc (btor, ucsp, cur);
+                if (btor_node_is_apply (cur)) mark_uc (btor, ucsp, cur, false);
               }
               else
-                mark_uc (btor, ucs, cur);
+                mark_uc (btor, ucs, cur, keep_defs);
             }
             break;
           case BTOR_BV_ADD_NODE:
           case BTOR_BV_EQ_NODE:
           case BTOR_FUN_EQ_NODE:
             if (!cur->parameterized && (uc[0] || uc[1]))
-              mark_uc (btor, ucs, cur);
+              mark_uc (btor, ucs, cur, keep_defs);
             break;
           case BTOR_BV_ULT_NODE:
           case BTOR_BV_CONCAT_NODE:
@@ -232,19 +308,20 @@ btor_optimize_unconstrained (Btor *btor)
           case BTOR_BV_SRL_NODE:
           case BTOR_BV_UDIV_NODE:
           case BTOR_BV_UREM_NODE:
-            if (!cur->parameterized && uc[0] && uc[1]) mark_uc (btor, ucs, cur);
+            if (!cur->parameterized && uc[0] && uc[1])
+              mark_uc (btor, ucs, cur, keep_defs);
             break;
           case BTOR_COND_NODE:
             if ((uc[1] && uc[2]) || (uc[0] && (uc[1] || uc[2])))
-              mark_uc (btor, ucs, cur);
+              mark_uc (btor, ucs, cur, keep_defs);
             else if (uc[1] && ucp[2])
             {
               /* case: x = t ? uc : ucp */
-              if (is_uc_write (cur)) mark_uc (btor, ucsp, cur);
+              if (is_uc_write (cur)) mark_uc (btor, ucsp, cur, false);
             }
             break;
           case BTOR_UPDATE_NODE:
-            if (uc[0] && uc[2]) mark_uc (btor, ucs, cur);
+            if (uc[0] && uc[2]) mark_uc (btor, ucs, cur, keep_defs);
             break;
           // TODO (ma): functions with parents > 1 can still be
           //            handled as unconstrained, but the applications
@@ -256,7 +333,7 @@ btor_optimize_unconstrained (Btor *btor)
                 /* only consider head lambda of curried lambdas */
                 && (!cur->first_parent
                     || !btor_node_is_lambda (cur->first_parent)))
-              mark_uc (btor, ucs, cur);
+              mark_uc (btor, ucs, cur, keep_defs);
             break;
           default: break;
         }
@@ -287,3 +364,259 @@ btor_optimize_unconstrained (Btor *btor)
   assert (btor_dbg_check_all_hash_tables_simp_free (btor));
   assert (btor_dbg_check_unique_table_children_proxy_free (btor));
 }
+
+/*------------------------------------------------------------------------*/
+
+static bool
+is_uc_input_constrained (Btor *btor, BtorNode *exp)
+{
+  exp = btor_node_real_addr (btor_node_get_simplified (btor, exp));
+  return exp->parents > 0 || exp->constraint
+         || btor_hashptr_table_get (btor->orig_assumptions, exp)
+         || btor_hashptr_table_get (btor->orig_assumptions,
+                                    btor_node_invert (exp));
+}
+
+void
+btor_restore_unconstrained (Btor *btor)
+{
+  assert (btor);
+
+  uint32_t i;
+  bool restore;
+  BtorNode *subst, *def_exp, *eq;
+  BtorPtrHashBucket *b, *next;
+  BtorUCDef *def;
+
+  /* definitions are visited in order of substitution, i.e., children first,
+   * restoring a definition constrains its variable, which in turn may require
+   * to restore the definition of its parent */
+  for (b = btor->uc_defs->first; b; b = next)
+  {
+    next  = b->next;
+    subst = b->key;
+    def   = b->data.as_ptr;
+
+    for (i = 0, restore = false; i < def->arity && !restore; i++)
+      restore = def->uc[i] && is_uc_input_constrained (btor, def->e[i]);
+    if (!restore) continue;
+
+    BTORLOG (1,
+             "restore unconstrained term substituted by %s",
+             btor_util_node2string (subst));
+    if (def->kind == BTOR_BV_SLICE_NODE)
+      def_exp = btor_exp_bv_slice (btor, def->e[0], def->upper, def->lower);
+    else
+      def_exp = btor_exp_create (btor, def->kind, def->e, def->arity);
+    eq = btor_exp_eq (btor, subst, def_exp);
+    btor_assert_exp (btor, eq);
+    btor_node_release (btor, eq);
+    btor_node_release (btor, def_exp);
+
+    btor_hashptr_table_remove (btor->uc_defs, subst, 0, 0);
+    btor_delete_uc_def (btor, def);
+    btor_node_release (btor, subst);
+    btor->stats.restored_uc_props++;
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+static void
+set_model_value (Btor *btor,
+                 BtorIntHashTable *bv_model,
+                 BtorNode *exp,
+                 const BtorBitVector *bv)
+{
+  assert (btor_node_is_regular (exp));
+
+  if (btor_hashint_map_contains (bv_model, exp->id))
+    btor_model_remove_from_bv (btor, bv_model, exp);
+  btor_model_add_to_bv (btor, bv_model, exp, bv);
+}
+
+/* Assign 'bv' to unconstrained child 'exp'.  The values of children that are
+ * substituted by another unconstrained term are recorded in 'values' and
+ * reconstructed recursively. */
+static void
+assign_uc_input (Btor *btor,
+                 BtorIntHashTable *bv_model,
+                 BtorIntHashTable *values,
+                 BtorNode *exp,
+                 BtorBitVector *bv)
+{
+  BtorBitVector *tmp;
+
+  exp = btor_node_get_simplified (btor, exp);
+  if (btor_node_is_inverted (exp))
+  {
+    tmp = btor_bv_not (btor->mm, bv);
+    btor_bv_free (btor->mm, bv);
+    bv  = tmp;
+    exp = btor_node_real_addr (exp);
+  }
+
+  if (btor_hashptr_table_get (btor->uc_defs, exp))
+  {
+    assert (!btor_hashint_map_contains (values, exp->id));
+    btor_hashint_map_add (values, exp->id)->as_ptr = bv;
+    return;
+  }
+
+  assert (btor_node_is_bv_var (exp));
+  set_model_value (btor, bv_model, exp, bv);
+  btor_bv_free (btor->mm, bv);
+}
+
+/* Compute values for the unconstrained children of 'def' such that 'def'
+ * evaluates to 'bv' under the current model. */
+static void
+reconstruct_uc_inputs (Btor *btor,
+                       BtorIntHashTable *bv_model,
+                       BtorIntHashTable *fun_model,
+                       BtorUCDef *def,
+                       const BtorBitVector *bv,
+                       BtorBitVector *res[3])
+{
+  uint32_t i, w[3];
+  const BtorBitVector *val[3];
+  BtorBitVector *tmp;
+  BtorMemMgr *mm;
+
+  mm = btor->mm;
+  for (i = 0; i < def->arity; i++)
+  {
+    w[i]   = btor_node_bv_get_width (btor, def->e[i]);
+    val[i] = def->uc[i] ? 0
+                        : btor_model_get_bv_aux (
+                            btor, bv_model, fun_model, def->e[i]);
+    res[i] = 0;
+  }
+
+  switch (def->kind)
+  {
+    case BTOR_BV_SLICE_NODE:
+      tmp    = btor_bv_uext (mm, bv, w[0] - def->upper + def->lower - 1);
+      res[0] = btor_bv_sll_uint64 (mm, tmp, def->lower);
+      btor_bv_free (mm, tmp);
+      break;
+
+    case BTOR_BV_ADD_NODE:
+      if (def->uc[0])
+      {
+        if (def->uc[1]) val[1] = res[1] = btor_bv_new (mm, w[1]);
+        res[0] = btor_bv_sub (mm, bv, val[1]);
+      }
+      else
+        res[1] = btor_bv_sub (mm, bv, val[0]);
+      break;
+
+    case BTOR_BV_EQ_NODE:
+      if (def->uc[0])
+      {
+        if (def->uc[1]) val[1] = res[1] = btor_bv_new (mm, w[1]);
+        res[0] = btor_bv_is_true (bv) ? btor_bv_copy (mm, val[1])
+                                      : btor_bv_not (mm, val[1]);
+      }
+      else
+        res[1] = btor_bv_is_true (bv) ? btor_bv_copy (mm, val[0])
+                                      : btor_bv_not (mm, val[0]);
+      break;
+
+    case BTOR_BV_ULT_NODE:
+      res[0] = btor_bv_new (mm, w[0]);
+      res[1] = btor_bv_is_true (bv) ? btor_bv_one (mm, w[1])
+                                    : btor_bv_new (mm, w[1]);
+      break;
+
+    case BTOR_BV_CONCAT_NODE:
+      res[0] = btor_bv_slice (mm, bv, w[0] + w[1] - 1, w[1]);
+      res[1] = btor_bv_slice (mm, bv, w[1] - 1, 0);
+      break;
+
+    case BTOR_BV_AND_NODE:
+      res[0] = btor_bv_copy (mm, bv);
+      res[1] = btor_bv_ones (mm, w[1]);
+      break;
+
+    case BTOR_BV_MUL_NODE:
+    case BTOR_BV_UDIV_NODE:
+      res[0] = btor_bv_copy (mm, bv);
+      res[1] = btor_bv_one (mm, w[1]);
+      break;
+
+    case BTOR_BV_SLL_NODE:
+    case BTOR_BV_SRL_NODE:
+    case BTOR_BV_UREM_NODE:
+      res[0] = btor_bv_copy (mm, bv);
+      res[1] = btor_bv_new (mm, w[1]);
+      break;
+
+    default:
+      assert (def->kind == BTOR_COND_NODE);
+      if (def->uc[0])
+      {
+        res[0] = def->uc[1] ? btor_bv_one (mm, 1) : btor_bv_new (mm, 1);
+        if (def->uc[1]) res[1] = btor_bv_copy (mm, bv);
+        if (def->uc[2])
+          res[2] = def->uc[1] ? btor_bv_new (mm, w[2]) : btor_bv_copy (mm, bv);
+      }
+      else
+      {
+        assert (def->uc[1] && def->uc[2]);
+        res[1] = btor_bv_copy (mm, bv);
+        res[2] = btor_bv_copy (mm, bv);
+      }
+  }
+}
+
+void
+btor_reconstruct_unconstrained (Btor *btor,
+                                BtorIntHashTable *bv_model,
+                                BtorIntHashTable *fun_model)
+{
+  assert (btor);
+  assert (bv_model);
+  assert (fun_model);
+
+  uint32_t i;
+  BtorNode *subst;
+  BtorPtrHashBucket *b;
+  BtorUCDef *def;
+  BtorBitVector *bv, *res[3];
+  BtorIntHashTable *values;
+  BtorHashTableData d;
+
+  values = btor_hashint_map_new (btor->mm);
+
+  /* definitions are visited in reverse order of substitution, i.e., the
+   * value of a term is known before the values of its children are
+   * reconstructed */
+  for (b = btor->uc_defs->last; b; b = b->prev)
+  {
+    subst = b->key;
+    def   = b->data.as_ptr;
+
+    if (btor_hashint_map_contains (values, subst->id))
+    {
+      /* term occurs as unconstrained child of another substituted term */
+      btor_hashint_map_remove (values, subst->id, &d);
+      bv = d.as_ptr;
+      set_model_value (btor, bv_model, subst, bv);
+    }
+    else
+      bv = btor_bv_copy (
+          btor->mm, btor_model_get_bv_aux (btor, bv_model, fun_model, subst));
+
+    reconstruct_uc_inputs (btor, bv_model, fun_model, def, bv, res);
+    for (i = 0; i < def->arity; i++)
+    {
+      if (!res[i]) continue;
+      assert (def->uc[i]);
+      assign_uc_input (btor, bv_model, values, def->e[i], res[i]);
+    }
+    btor_bv_free (btor->mm, bv);
+  }
+  assert (values->count == 0);
+  btor_hashint_map_delete (values);
+}
@@ -9,8 +9,39 @@
 #ifndef BTORUNCONSTRAINED_H_INCLUDED
 #define BTORUNCONSTRAINED_H_INCLUDED
 
+#include "btornode.h"
 #include "btortypes.h"
+#include "utils/btorhashint.h"
+
+/* Definition of an unconstrained term that was substituted by a fresh
+ * variable while model generation or incremental solving is enabled (see
+ * Btor::uc_defs).  The definition is used to reconstruct the values of the
+ * unconstrained inputs of the term, and to restore the term in case that one
+ * of them gets constrained in a later incremental call. */
+struct BtorUCDef
+{
+  BtorNodeKind kind;
+  uint32_t arity;
+  uint32_t upper; /* slice bounds */
+  uint32_t lower;
+  BtorNode *e[3];
+  bool uc[3]; /* unconstrained children */
+};
+
+typedef struct BtorUCDef BtorUCDef;
 
 void btor_optimize_unconstrained (Btor* btor);
 
+/* Re-assert the definitions of all unconstrained terms with an input that got
+ * constrained since they were substituted. */
+void btor_restore_unconstrained (Btor* btor);
+
+/* Assign values to the unconstrained inputs of substituted terms that are
+ * consistent with the values of their substitutions in 'bv_model'. */
+void btor_reconstruct_unconstrained (Btor* btor,
+                                     BtorIntHashTable* bv_model,
+                                     BtorIntHashTable* fun_model);
+
+void btor_delete_uc_def (Btor* btor, BtorUCDef* def);
+
 #endif
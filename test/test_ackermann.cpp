@@ -0,0 +1,119 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+extern "C" {
+#include "btorcore.h"
+}
+
+class TestAckermann : public TestBoolector
+{
+ protected:
+  void SetUp () override
+  {
+    TestBoolector::SetUp ();
+    boolector_set_opt (d_btor, BTOR_OPT_ACKERMANN, 1);
+    d_bv_sort  = boolector_bitvec_sort (d_btor, 8);
+    d_fun_sort = boolector_fun_sort (d_btor, &d_bv_sort, 1, d_bv_sort);
+  }
+
+  void TearDown () override
+  {
+    boolector_release_sort (d_btor, d_fun_sort);
+    boolector_release_sort (d_btor, d_bv_sort);
+    TestBoolector::TearDown ();
+  }
+
+  /* Create f (x + c). */
+  BoolectorNode *apply_add (BoolectorNode *f, BoolectorNode *x, uint32_t c)
+  {
+    BoolectorNode *cn, *add, *res;
+
+    cn  = boolector_unsigned_int (d_btor, c, d_bv_sort);
+    add = boolector_add (d_btor, x, cn);
+    res = boolector_apply (d_btor, &add, 1, f);
+    boolector_release (d_btor, add);
+    boolector_release (d_btor, cn);
+    return res;
+  }
+
+  /* Assert f (x + 1) != f (y + 1) with x = y and check that the result is
+   * unsat. */
+  void test_congruence (uint32_t pairs)
+  {
+    BoolectorNode *f, *x, *y, *fx, *fy, *ne, *eq;
+
+    boolector_set_opt (d_btor, BTOR_OPT_ACKERMANN_PAIRS, pairs);
+    f  = boolector_uf (d_btor, d_fun_sort, "f");
+    x  = boolector_var (d_btor, d_bv_sort, "x");
+    y  = boolector_var (d_btor, d_bv_sort, "y");
+    fx = apply_add (f, x, 1);
+    fy = apply_add (f, y, 1);
+    ne = boolector_ne (d_btor, fx, fy);
+    eq = boolector_eq (d_btor, x, y);
+    boolector_assert (d_btor, ne);
+    boolector_assert (d_btor, eq);
+    ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+    boolector_release (d_btor, eq);
+    boolector_release (d_btor, ne);
+    boolector_release (d_btor, fy);
+    boolector_release (d_btor, fx);
+    boolector_release (d_btor, y);
+    boolector_release (d_btor, x);
+    boolector_release (d_btor, f);
+  }
+
+  BoolectorSort d_bv_sort;
+  BoolectorSort d_fun_sort;
+};
+
+TEST_F (TestAckermann, all) { test_congruence (BTOR_ACKERMANN_PAIRS_ALL); }
+
+TEST_F (TestAckermann, shared)
+{
+  test_congruence (BTOR_ACKERMANN_PAIRS_SHARED);
+}
+
+TEST_F (TestAckermann, shared_pairs)
+{
+  uint32_t i;
+  BoolectorNode *f, *x, *y, *z, *apps[4], *sum, *tmp, *c;
+
+  /* only f (x + 1) and f (x + 2) share an argument subterm */
+  boolector_set_opt (d_btor, BTOR_OPT_ACKERMANN_PAIRS,
+                     BTOR_ACKERMANN_PAIRS_SHARED);
+  boolector_set_opt (d_btor, BTOR_OPT_REWRITE_LEVEL, 1);
+  f       = boolector_uf (d_btor, d_fun_sort, "f");
+  x       = boolector_var (d_btor, d_bv_sort, "x");
+  y       = boolector_var (d_btor, d_bv_sort, "y");
+  z       = boolector_var (d_btor, d_bv_sort, "z");
+  apps[0] = apply_add (f, x, 1);
+  apps[1] = apply_add (f, x, 2);
+  apps[2] = boolector_apply (d_btor, &y, 1, f);
+  apps[3] = boolector_apply (d_btor, &z, 1, f);
+  sum     = boolector_copy (d_btor, apps[0]);
+  for (i = 1; i < 4; i++)
+  {
+    tmp = boolector_add (d_btor, sum, apps[i]);
+    boolector_release (d_btor, sum);
+    sum = tmp;
+  }
+  c   = boolector_unsigned_int (d_btor, 42, d_bv_sort);
+  tmp = boolector_eq (d_btor, sum, c);
+  boolector_assert (d_btor, tmp);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_EQ (d_btor->stats.ackermann_constraints, 1u);
+
+  boolector_release (d_btor, tmp);
+  boolector_release (d_btor, c);
+  boolector_release (d_btor, sum);
+  for (i = 0; i < 4; i++) boolector_release (d_btor, apps[i]);
+  boolector_release (d_btor, z);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, f);
+}
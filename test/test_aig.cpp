@@ -11,6 +11,7 @@
 
 extern "C" {
 #include "btoraig.h"
+#include "btoraigopt.h"
 #include "dumper/btordumpaig.h"
 }
 
@@ -145,3 +146,55 @@ TEST_F (TestAig, aig_to_sat)
   btor_aig_release (amgr, and3);
   btor_aig_mgr_delete (amgr);
 }
+
+TEST_F (TestAig, aigopt_balance)
+{
+  BtorAIGMgr *amgr = btor_aig_mgr_new (d_btor);
+  BtorAIG *var1    = btor_aig_var (amgr);
+  BtorAIG *var2    = btor_aig_var (amgr);
+  BtorAIG *var3    = btor_aig_var (amgr);
+  BtorAIG *var4    = btor_aig_var (amgr);
+  BtorAIG *and1    = btor_aig_and (amgr, var1, var2);
+  BtorAIG *and2    = btor_aig_and (amgr, and1, var3);
+  BtorAIG *and3    = btor_aig_and (amgr, and2, var4);
+  btor_aig_release (amgr, and1);
+  btor_aig_release (amgr, and2);
+  btor_aigopt_optimize (amgr, &and3, 1, 0);
+  ASSERT_TRUE (btor_aig_is_and (and3));
+  ASSERT_TRUE (btor_aig_is_and (btor_aig_get_left_child (amgr, and3)));
+  ASSERT_TRUE (btor_aig_is_and (btor_aig_get_right_child (amgr, and3)));
+  ASSERT_EQ (amgr->num_aigopt_balanced, 1u);
+  btor_aig_release (amgr, var1);
+  btor_aig_release (amgr, var2);
+  btor_aig_release (amgr, var3);
+  btor_aig_release (amgr, var4);
+  btor_aig_release (amgr, and3);
+  btor_aig_mgr_delete (amgr);
+}
+
+TEST_F (TestAig, aigopt_rewrite)
+{
+  BtorAIGMgr *amgr = btor_aig_mgr_new (d_btor);
+  BtorAIG *var1    = btor_aig_var (amgr);
+  BtorAIG *var2    = btor_aig_var (amgr);
+  BtorAIG *var3    = btor_aig_var (amgr);
+  /* (var1 & var2) | (var1 & var3) = var1 & (var2 | var3) */
+  BtorAIG *and1 = btor_aig_and (amgr, var1, var2);
+  BtorAIG *and2 = btor_aig_and (amgr, var1, var3);
+  BtorAIG *or1  = btor_aig_or (amgr, and1, and2);
+  BtorAIG *or2  = btor_aig_or (amgr, var2, var3);
+  BtorAIG *exp  = btor_aig_and (amgr, var1, or2);
+  btor_aig_release (amgr, and1);
+  btor_aig_release (amgr, and2);
+  ASSERT_EQ (amgr->cur_num_aigs, 5u);
+  btor_aigopt_optimize (amgr, &or1, 1, 0);
+  ASSERT_TRUE (or1 == exp);
+  ASSERT_EQ (amgr->cur_num_aigs, 2u);
+  btor_aig_release (amgr, var1);
+  btor_aig_release (amgr, var2);
+  btor_aig_release (amgr, var3);
+  btor_aig_release (amgr, or1);
+  btor_aig_release (amgr, or2);
+  btor_aig_release (amgr, exp);
+  btor_aig_mgr_delete (amgr);
+}
@@ -136,6 +136,175 @@ class TestArith : public TestBoolector
     }
   }
 
+  void u_arithmetic_abstract_test (int32_t (*func) (int32_t, int32_t),
+                                   BoolectorNode* (*btorfun) (Btor*,
+                                                              BoolectorNode*,
+                                                              BoolectorNode*),
+                                   int32_t low,
+                                   int32_t high)
+  {
+    assert (func != NULL);
+    assert (low > 0);
+    assert (low <= high);
+
+    int32_t i        = 0;
+    int32_t j        = 0;
+    int32_t result   = 0;
+    int32_t max      = 0;
+    int32_t num_bits = 0;
+
+    for (num_bits = low; num_bits <= high; num_bits++)
+    {
+      max = btor_util_pow_2 (num_bits);
+
+      if (d_btor) boolector_delete (d_btor);
+      d_btor = boolector_new ();
+      boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+      boolector_set_opt (d_btor, BTOR_OPT_FUN_ABSTRACT, 1);
+      boolector_set_opt (d_btor, BTOR_OPT_FUN_ABSTRACT_WIDTH, 2);
+
+      BoolectorSort sort = boolector_bitvec_sort (d_btor, num_bits);
+      BoolectorNode *var1, *var2, *bfun;
+
+      var1 = boolector_var (d_btor, sort, "var1");
+      var2 = boolector_var (d_btor, sort, "var2");
+      bfun = btorfun (d_btor, var1, var2);
+
+      for (i = 0; i < max; i++)
+      {
+        for (j = 0; j < max; j++)
+        {
+          result = func (i, j);
+
+          if (result < max)
+          {
+            BoolectorNode *const1, *const2, *const3, *eq1, *eq2, *eq3, *ne3;
+
+            const1 = boolector_unsigned_int (d_btor, i, sort);
+            const2 = boolector_unsigned_int (d_btor, j, sort);
+            const3 = boolector_unsigned_int (d_btor, result, sort);
+            eq1    = boolector_eq (d_btor, var1, const1);
+            eq2    = boolector_eq (d_btor, var2, const2);
+            eq3    = boolector_eq (d_btor, bfun, const3);
+            ne3    = boolector_not (d_btor, eq3);
+
+            boolector_assume (d_btor, eq1);
+            boolector_assume (d_btor, eq2);
+            boolector_assume (d_btor, eq3);
+            ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+
+            boolector_assume (d_btor, eq1);
+            boolector_assume (d_btor, eq2);
+            boolector_assume (d_btor, ne3);
+            ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+
+            boolector_release (d_btor, const1);
+            boolector_release (d_btor, const2);
+            boolector_release (d_btor, const3);
+            boolector_release (d_btor, eq1);
+            boolector_release (d_btor, eq2);
+            boolector_release (d_btor, eq3);
+            boolector_release (d_btor, ne3);
+          }
+        }
+      }
+      boolector_release_sort (d_btor, sort);
+      boolector_release (d_btor, var1);
+      boolector_release (d_btor, var2);
+      boolector_release (d_btor, bfun);
+      boolector_delete (d_btor);
+      d_btor = nullptr;
+    }
+  }
+
+  int32_t get_assignment (BoolectorNode* node, bool is_signed)
+  {
+    const char* bits;
+    int32_t res, width;
+
+    bits  = boolector_bv_assignment (d_btor, node);
+    width = boolector_get_width (d_btor, node);
+    res   = (int32_t) strtol (bits, nullptr, 2);
+    if (is_signed && bits[0] == '1') res -= btor_util_pow_2 (width);
+    boolector_free_bv_assignment (d_btor, bits);
+    return res;
+  }
+
+  void reduce_widths_test (int32_t (*func) (int32_t, int32_t),
+                           BoolectorNode* (*btorfun) (Btor*,
+                                                      BoolectorNode*,
+                                                      BoolectorNode*),
+                           bool is_signed,
+                           int32_t low,
+                           int32_t high)
+  {
+    assert (func != NULL);
+    assert (low > 0);
+    assert (low <= high);
+
+    int32_t i        = 0;
+    int32_t j        = 0;
+    int32_t result   = 0;
+    int32_t min      = 0;
+    int32_t max      = 0;
+    int32_t num_bits = 0;
+    int32_t ext      = 0;
+
+    for (num_bits = low; num_bits <= high; num_bits++)
+    {
+      /* wide enough to hold all results */
+      ext = num_bits + 1;
+      min = is_signed ? -btor_util_pow_2 (num_bits - 1) : 0;
+      max = btor_util_pow_2 (is_signed ? num_bits - 1 : num_bits);
+      for (i = min; i < max; i++)
+      {
+        for (j = min; j < max; j++)
+        {
+          result = func (i, j);
+
+          if (d_btor) boolector_delete (d_btor);
+          d_btor = boolector_new ();
+          boolector_set_opt (d_btor, BTOR_OPT_REDUCE_WIDTHS, 1);
+          boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+
+          BoolectorSort sort, sort_ext;
+          BoolectorNode *var1, *var2, *ext1, *ext2, *const3, *bfun, *eq;
+
+          sort     = boolector_bitvec_sort (d_btor, num_bits);
+          sort_ext = boolector_bitvec_sort (d_btor, num_bits + ext);
+          var1     = boolector_var (d_btor, sort, "var1");
+          var2     = boolector_var (d_btor, sort, "var2");
+          ext1     = is_signed ? boolector_sext (d_btor, var1, ext)
+                               : boolector_uext (d_btor, var1, ext);
+          ext2     = is_signed ? boolector_sext (d_btor, var2, ext)
+                               : boolector_uext (d_btor, var2, ext);
+          bfun     = btorfun (d_btor, ext1, ext2);
+          const3   = boolector_int (d_btor, result, sort_ext);
+          eq       = boolector_eq (d_btor, bfun, const3);
+          boolector_assert (d_btor, eq);
+
+          ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+          ASSERT_EQ (func (get_assignment (var1, is_signed),
+                           get_assignment (var2, is_signed)),
+                     result);
+          ASSERT_EQ (get_assignment (bfun, true), result);
+
+          boolector_release_sort (d_btor, sort);
+          boolector_release_sort (d_btor, sort_ext);
+          boolector_release (d_btor, var1);
+          boolector_release (d_btor, var2);
+          boolector_release (d_btor, ext1);
+          boolector_release (d_btor, ext2);
+          boolector_release (d_btor, const3);
+          boolector_release (d_btor, bfun);
+          boolector_release (d_btor, eq);
+          boolector_delete (d_btor);
+          d_btor = nullptr;
+        }
+      }
+    }
+  }
+
   static int32_t add (int32_t x, int32_t y) { return x + y; }
 
   static int32_t sub (int32_t x, int32_t y) { return x - y; }
@@ -299,3 +468,93 @@ TEST_F (TestArith, srem_s)
                      BTOR_TEST_ARITHMETIC_HIGH,
                      0);
 }
+
+TEST_F (TestArith, mul_u_abstract)
+{
+  u_arithmetic_abstract_test (
+      mul, boolector_mul, BTOR_TEST_ARITHMETIC_LOW, BTOR_TEST_ARITHMETIC_HIGH);
+}
+
+TEST_F (TestArith, udiv_u_abstract)
+{
+  u_arithmetic_abstract_test (divide,
+                              boolector_udiv,
+                              BTOR_TEST_ARITHMETIC_LOW,
+                              BTOR_TEST_ARITHMETIC_HIGH);
+}
+
+TEST_F (TestArith, urem_u_abstract)
+{
+  u_arithmetic_abstract_test (
+      rem, boolector_urem, BTOR_TEST_ARITHMETIC_LOW, BTOR_TEST_ARITHMETIC_HIGH);
+}
+
+TEST_F (TestArith, add_reduce_widths)
+{
+  reduce_widths_test (add,
+                      boolector_add,
+                      false,
+                      BTOR_TEST_ARITHMETIC_LOW,
+                      BTOR_TEST_ARITHMETIC_HIGH);
+  reduce_widths_test (add,
+                      boolector_add,
+                      true,
+                      BTOR_TEST_ARITHMETIC_LOW,
+                      BTOR_TEST_ARITHMETIC_HIGH);
+}
+
+TEST_F (TestArith, mul_reduce_widths)
+{
+  reduce_widths_test (mul,
+                      boolector_mul,
+                      false,
+                      BTOR_TEST_ARITHMETIC_LOW,
+                      BTOR_TEST_ARITHMETIC_HIGH);
+  reduce_widths_test (mul,
+                      boolector_mul,
+                      true,
+                      BTOR_TEST_ARITHMETIC_LOW,
+                      BTOR_TEST_ARITHMETIC_HIGH);
+}
+
+TEST_F (TestArith, mul_reduce_widths_slice)
+{
+  int32_t i, x, y;
+  BoolectorSort sort, sort_slice;
+  BoolectorNode *var1, *var2, *bfun, *slice, *c, *eq;
+
+  /* only the 4 least significant bits of the operands are observed */
+  for (i = 0; i < 16; i++)
+  {
+    d_btor = boolector_new ();
+    boolector_set_opt (d_btor, BTOR_OPT_REDUCE_WIDTHS, 1);
+    boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+
+    sort       = boolector_bitvec_sort (d_btor, 8);
+    sort_slice = boolector_bitvec_sort (d_btor, 4);
+    var1       = boolector_var (d_btor, sort, "var1");
+    var2       = boolector_var (d_btor, sort, "var2");
+    bfun       = boolector_mul (d_btor, var1, var2);
+    slice      = boolector_slice (d_btor, bfun, 3, 0);
+    c          = boolector_unsigned_int (d_btor, i, sort_slice);
+    eq         = boolector_eq (d_btor, slice, c);
+    boolector_assert (d_btor, eq);
+
+    ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+    x = get_assignment (var1, false);
+    y = get_assignment (var2, false);
+    ASSERT_EQ ((x * y) % 16, i);
+    ASSERT_EQ (get_assignment (bfun, false), (x * y) % 256);
+
+    boolector_release_sort (d_btor, sort);
+    boolector_release_sort (d_btor, sort_slice);
+    boolector_release (d_btor, var1);
+    boolector_release (d_btor, var2);
+    boolector_release (d_btor, bfun);
+    boolector_release (d_btor, slice);
+    boolector_release (d_btor, c);
+    boolector_release (d_btor, eq);
+    boolector_delete (d_btor);
+    d_btor = nullptr;
+  }
+}
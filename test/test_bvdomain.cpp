@@ -0,0 +1,237 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+extern "C" {
+#include "btorbv.h"
+#include "btorbvdomain.h"
+#include "btorcore.h"
+#include "btorexp.h"
+#include "preprocess/btorpreprocess.h"
+}
+
+class TestBvDomain : public TestBtor
+{
+ protected:
+  static constexpr uint32_t TEST_BVDOMAIN_BW = 4;
+
+  void SetUp () override
+  {
+    TestBtor::SetUp ();
+    btor_opt_set (d_btor, BTOR_OPT_BV_DOMAIN, 1);
+    btor_opt_set (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  }
+
+  /* Create (x & m) | k for bit-vector 'x'. */
+  BtorNode *mk_operand (BtorNode *x, uint64_t m, uint64_t k)
+  {
+    BtorBitVector *bvm, *bvk;
+    BtorNode *cm, *ck, *tmp, *res;
+
+    bvm = btor_bv_uint64_to_bv (d_btor->mm, m, TEST_BVDOMAIN_BW);
+    bvk = btor_bv_uint64_to_bv (d_btor->mm, k, TEST_BVDOMAIN_BW);
+    cm  = btor_exp_bv_const (d_btor, bvm);
+    ck  = btor_exp_bv_const (d_btor, bvk);
+    tmp = btor_exp_bv_and (d_btor, x, cm);
+    res = btor_exp_bv_or (d_btor, tmp, ck);
+    btor_node_release (d_btor, tmp);
+    btor_node_release (d_btor, cm);
+    btor_node_release (d_btor, ck);
+    btor_bv_free (d_btor->mm, bvm);
+    btor_bv_free (d_btor->mm, bvk);
+    return res;
+  }
+
+  /* Check that all values of 'fun' (mk_operand (x, m0, k0),
+   * mk_operand (y, m1, k1)) are contained in the domain of the term. */
+  void fwd_test (BtorNode *(*fun) (Btor *, BtorNode *, BtorNode *),
+                 BtorBitVector *(*bvfun) (BtorMemMgr *,
+                                          const BtorBitVector *,
+                                          const BtorBitVector *) )
+  {
+    uint64_t m0, k0, m1, k1, i, j, masks[][2] = {
+                                                  {0xf, 0x0},
+                                                  {0x3, 0x4},
+                                                  {0xc, 0x1},
+                                                  {0x6, 0x8},
+                                                  {0x0, 0x5},
+                                              };
+    uint32_t n, nmasks, bw;
+    BtorSortId sort;
+    BtorNode *x, *y, *a, *b, *exp;
+    BtorBvDomain *d;
+    BtorBitVector *bva, *bvb, *bvres;
+    BtorMemMgr *mm;
+
+    mm     = d_btor->mm;
+    bw     = TEST_BVDOMAIN_BW;
+    nmasks = sizeof (masks) / sizeof (*masks);
+    sort   = btor_sort_bv (d_btor, bw);
+    x      = btor_exp_var (d_btor, sort, "x");
+    y      = btor_exp_var (d_btor, sort, "y");
+
+    for (n = 0; n < nmasks * nmasks; n++)
+    {
+      m0  = masks[n / nmasks][0];
+      k0  = masks[n / nmasks][1];
+      m1  = masks[n % nmasks][0];
+      k1  = masks[n % nmasks][1];
+      a   = mk_operand (x, m0, k0);
+      b   = mk_operand (y, m1, k1);
+      exp = fun (d_btor, a, b);
+      d   = btor_bvdomain_get (d_btor, exp);
+      for (i = 0; i < (1u << bw); i++)
+      {
+        bva = btor_bv_uint64_to_bv (mm, (i & m0) | k0, bw);
+        for (j = 0; j < (1u << bw); j++)
+        {
+          bvb   = btor_bv_uint64_to_bv (mm, (j & m1) | k1, bw);
+          bvres = bvfun (mm, bva, bvb);
+          ASSERT_TRUE (btor_bvdomain_contains (mm, d, bvres));
+          btor_bv_free (mm, bvres);
+          btor_bv_free (mm, bvb);
+        }
+        btor_bv_free (mm, bva);
+      }
+      btor_bvdomain_free (mm, d);
+      btor_node_release (d_btor, exp);
+      btor_node_release (d_btor, a);
+      btor_node_release (d_btor, b);
+    }
+
+    btor_node_release (d_btor, x);
+    btor_node_release (d_btor, y);
+    btor_sort_release (d_btor, sort);
+  }
+};
+
+TEST_F (TestBvDomain, init_fixed)
+{
+  BtorBitVector *bv;
+  BtorBvDomain *d, *e;
+
+  d = btor_bvdomain_new_init (d_btor->mm, 8);
+  ASSERT_TRUE (btor_bvdomain_is_init (d));
+  ASSERT_FALSE (btor_bvdomain_is_fixed (d));
+
+  bv = btor_bv_uint64_to_bv (d_btor->mm, 42, 8);
+  e  = btor_bvdomain_new_fixed (d_btor->mm, bv);
+  ASSERT_TRUE (btor_bvdomain_is_fixed (e));
+  ASSERT_TRUE (btor_bvdomain_contains (d_btor->mm, e, bv));
+  ASSERT_TRUE (btor_bvdomain_meet (d_btor->mm, d, e));
+  ASSERT_TRUE (btor_bvdomain_is_fixed (d));
+  ASSERT_EQ (btor_bv_compare (d->min, bv), 0);
+
+  btor_bv_free (d_btor->mm, bv);
+  btor_bvdomain_free (d_btor->mm, d);
+  btor_bvdomain_free (d_btor->mm, e);
+}
+
+TEST_F (TestBvDomain, normalize)
+{
+  BtorBvDomain *d;
+
+  /* [2, 3] fixes all but the least significant bit */
+  d = btor_bvdomain_new_init (d_btor->mm, 4);
+  btor_bv_free (d_btor->mm, d->min);
+  btor_bv_free (d_btor->mm, d->max);
+  d->min = btor_bv_uint64_to_bv (d_btor->mm, 2, 4);
+  d->max = btor_bv_uint64_to_bv (d_btor->mm, 3, 4);
+  ASSERT_TRUE (btor_bvdomain_normalize (d_btor->mm, d));
+  ASSERT_TRUE (btor_bvdomain_is_fixed_bit_false (d, 3));
+  ASSERT_TRUE (btor_bvdomain_is_fixed_bit_false (d, 2));
+  ASSERT_TRUE (btor_bvdomain_is_fixed_bit_true (d, 1));
+  ASSERT_FALSE (btor_bvdomain_is_fixed_bit (d, 0));
+
+  /* bit 1 fixed to 0 contradicts [2, 3] */
+  btor_bv_set_bit (d->lo, 1, 0);
+  btor_bv_set_bit (d->hi, 1, 0);
+  ASSERT_FALSE (btor_bvdomain_normalize (d_btor->mm, d));
+  btor_bvdomain_free (d_btor->mm, d);
+}
+
+TEST_F (TestBvDomain, fwd_and) { fwd_test (btor_exp_bv_and, btor_bv_and); }
+
+TEST_F (TestBvDomain, fwd_add) { fwd_test (btor_exp_bv_add, btor_bv_add); }
+
+TEST_F (TestBvDomain, fwd_mul) { fwd_test (btor_exp_bv_mul, btor_bv_mul); }
+
+TEST_F (TestBvDomain, fwd_udiv) { fwd_test (btor_exp_bv_udiv, btor_bv_udiv); }
+
+TEST_F (TestBvDomain, fwd_urem) { fwd_test (btor_exp_bv_urem, btor_bv_urem); }
+
+TEST_F (TestBvDomain, fwd_sll) { fwd_test (btor_exp_bv_sll, btor_bv_sll); }
+
+TEST_F (TestBvDomain, fwd_srl) { fwd_test (btor_exp_bv_srl, btor_bv_srl); }
+
+TEST_F (TestBvDomain, fwd_ult) { fwd_test (btor_exp_bv_ult, btor_bv_ult); }
+
+TEST_F (TestBvDomain, fwd_eq) { fwd_test (btor_exp_eq, btor_bv_eq); }
+
+TEST_F (TestBvDomain, fwd_concat)
+{
+  fwd_test (btor_exp_bv_concat, btor_bv_concat);
+}
+
+TEST_F (TestBvDomain, rewrite_ult)
+{
+  BtorSortId sort;
+  BtorNode *x, *a, *c, *ult;
+  BtorBitVector *bv;
+
+  /* x & 0x0f < 0x10 */
+  sort = btor_sort_bv (d_btor, 8);
+  x    = btor_exp_var (d_btor, sort, "x");
+  bv   = btor_bv_uint64_to_bv (d_btor->mm, 0x0f, 8);
+  c    = btor_exp_bv_const (d_btor, bv);
+  a    = btor_exp_bv_and (d_btor, x, c);
+  btor_node_release (d_btor, c);
+  btor_bv_free (d_btor->mm, bv);
+  bv  = btor_bv_uint64_to_bv (d_btor->mm, 0x10, 8);
+  c   = btor_exp_bv_const (d_btor, bv);
+  ult = btor_exp_bv_ult (d_btor, a, c);
+  ASSERT_EQ (ult, d_btor->true_exp);
+
+  btor_node_release (d_btor, ult);
+  btor_node_release (d_btor, c);
+  btor_node_release (d_btor, a);
+  btor_node_release (d_btor, x);
+  btor_bv_free (d_btor->mm, bv);
+  btor_sort_release (d_btor, sort);
+}
+
+TEST_F (TestBvDomain, propagate)
+{
+  uint32_t i;
+  BtorSortId sort;
+  BtorNode *x, *c, *ult;
+  BtorBitVector *bv;
+  BtorBvDomain *d;
+
+  /* x < 4 fixes the upper six bits of x to 0 (variable substitution would
+   * replace x by 0::x' with a fresh 2-bit variable x') */
+  btor_opt_set (d_btor, BTOR_OPT_VAR_SUBST, 0);
+  sort = btor_sort_bv (d_btor, 8);
+  x    = btor_exp_var (d_btor, sort, "x");
+  bv   = btor_bv_uint64_to_bv (d_btor->mm, 4, 8);
+  c    = btor_exp_bv_const (d_btor, bv);
+  ult  = btor_exp_bv_ult (d_btor, x, c);
+  btor_assert_exp (d_btor, ult);
+  btor_simplify (d_btor);
+
+  d = btor_bvdomain_get_constrained (d_btor, x);
+  for (i = 2; i < 8; i++) ASSERT_TRUE (btor_bvdomain_is_fixed_bit_false (d, i));
+  ASSERT_FALSE (btor_bvdomain_is_fixed_bit (d, 1));
+  ASSERT_FALSE (btor_bvdomain_is_fixed_bit (d, 0));
+  btor_bvdomain_free (d_btor->mm, d);
+
+  btor_node_release (d_btor, ult);
+  btor_node_release (d_btor, c);
+  btor_node_release (d_btor, x);
+  btor_bv_free (d_btor->mm, bv);
+  btor_sort_release (d_btor, sort);
+}
@@ -0,0 +1,152 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+extern "C" {
+#include "btorcore.h"
+#include "btorslvfun.h"
+}
+
+class TestDecompose : public TestBoolector
+{
+ protected:
+  void SetUp () override
+  {
+    TestBoolector::SetUp ();
+    boolector_set_opt (d_btor, BTOR_OPT_FUN_DECOMPOSE, 1);
+    boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+    d_sort = boolector_bitvec_sort (d_btor, 8);
+    d_a    = boolector_var (d_btor, d_sort, "a");
+    d_x    = boolector_var (d_btor, d_sort, "x");
+    d_y    = boolector_var (d_btor, d_sort, "y");
+  }
+
+  void TearDown () override
+  {
+    boolector_release (d_btor, d_a);
+    boolector_release (d_btor, d_x);
+    boolector_release (d_btor, d_y);
+    boolector_release_sort (d_btor, d_sort);
+    TestBoolector::TearDown ();
+  }
+
+  /* Create l * r = c. */
+  BoolectorNode *mul_eq (BoolectorNode *l, BoolectorNode *r, uint32_t c)
+  {
+    BoolectorNode *mul, *cn, *res;
+
+    mul = boolector_mul (d_btor, l, r);
+    cn  = boolector_unsigned_int (d_btor, c, d_sort);
+    res = boolector_eq (d_btor, mul, cn);
+    boolector_release (d_btor, cn);
+    boolector_release (d_btor, mul);
+    return res;
+  }
+
+  /* Assert l * r = c. */
+  void assert_mul_eq (BoolectorNode *l, BoolectorNode *r, uint32_t c)
+  {
+    BoolectorNode *eq = mul_eq (l, r, c);
+    boolector_assert (d_btor, eq);
+    boolector_release (d_btor, eq);
+  }
+
+  /* Assert x * y = 143 with x, y > 1, which is satisfied by {11, 13}. */
+  void assert_factors ()
+  {
+    BoolectorNode *one, *ugt;
+
+    assert_mul_eq (d_x, d_y, 143);
+    one = boolector_one (d_btor, d_sort);
+    ugt = boolector_ugt (d_btor, d_x, one);
+    boolector_assert (d_btor, ugt);
+    boolector_release (d_btor, ugt);
+    ugt = boolector_ugt (d_btor, d_y, one);
+    boolector_assert (d_btor, ugt);
+    boolector_release (d_btor, ugt);
+    boolector_release (d_btor, one);
+  }
+
+  uint32_t get_value (BoolectorNode *n)
+  {
+    const char *bits;
+    uint32_t res;
+
+    bits = boolector_bv_assignment (d_btor, n);
+    res  = (uint32_t) strtoul (bits, 0, 2);
+    boolector_free_bv_assignment (d_btor, bits);
+    return res;
+  }
+
+  BoolectorSort d_sort;
+  BoolectorNode *d_a;
+  BoolectorNode *d_x;
+  BoolectorNode *d_y;
+};
+
+TEST_F (TestDecompose, sat)
+{
+  uint32_t a, x, y;
+
+  assert_mul_eq (d_a, d_a, 9);
+  assert_factors ();
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_EQ (BTOR_FUN_SOLVER (d_btor)->stats.components, 2u);
+  ASSERT_EQ (BTOR_FUN_SOLVER (d_btor)->stats.component_checks, 1u);
+  a = get_value (d_a);
+  x = get_value (d_x);
+  y = get_value (d_y);
+  ASSERT_EQ ((a * a) % 256, 9u);
+  ASSERT_EQ ((x * y) % 256, 143u);
+  ASSERT_GT (x, 1u);
+  ASSERT_GT (y, 1u);
+}
+
+TEST_F (TestDecompose, unsat)
+{
+  /* the square of an odd number is 1 modulo 8 */
+  assert_mul_eq (d_a, d_a, 5);
+  assert_factors ();
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+  ASSERT_EQ (BTOR_FUN_SOLVER (d_btor)->stats.components, 2u);
+  ASSERT_EQ (BTOR_FUN_SOLVER (d_btor)->stats.component_checks, 1u);
+  /* the larger component was never bit-blasted */
+  ASSERT_EQ (d_btor->synthesized_constraints->count, 1u);
+}
+
+TEST_F (TestDecompose, unsat_assumptions)
+{
+  BoolectorNode *ass;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  assert_mul_eq (d_a, d_a, 5);
+  assert_factors ();
+  ass = boolector_ugt (d_btor, d_x, d_y);
+  boolector_assume (d_btor, ass);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+  ASSERT_FALSE (boolector_failed (d_btor, ass));
+  boolector_release (d_btor, ass);
+}
+
+TEST_F (TestDecompose, incremental)
+{
+  BoolectorNode *ass;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  assert_factors ();
+  ass = mul_eq (d_a, d_a, 5);
+  boolector_assume (d_btor, ass);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+  ASSERT_TRUE (boolector_failed (d_btor, ass));
+  boolector_release (d_btor, ass);
+  assert_mul_eq (d_a, d_a, 9);
+  assert_mul_eq (d_a, d_x, 33);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_EQ ((get_value (d_a) * get_value (d_a)) % 256, 9u);
+  ASSERT_EQ ((get_value (d_a) * get_value (d_x)) % 256, 33u);
+  ASSERT_EQ ((get_value (d_x) * get_value (d_y)) % 256, 143u);
+}
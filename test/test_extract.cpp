@@ -0,0 +1,181 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+extern "C" {
+#include "btorcore.h"
+}
+
+class TestExtract : public TestBoolector
+{
+ protected:
+  void SetUp () override
+  {
+    TestBoolector::SetUp ();
+    boolector_set_opt (d_btor, BTOR_OPT_EXTRACT_LAMBDAS, 1);
+    d_sort  = boolector_bitvec_sort (d_btor, 8);
+    d_asort = boolector_array_sort (d_btor, d_sort, d_sort);
+    d_x     = boolector_var (d_btor, d_sort, "x");
+  }
+
+  void TearDown () override
+  {
+    boolector_release (d_btor, d_x);
+    boolector_release_sort (d_btor, d_asort);
+    boolector_release_sort (d_btor, d_sort);
+    TestBoolector::TearDown ();
+  }
+
+  /* Return write (array, i, value) and release 'array' and 'value'. */
+  BoolectorNode *write (BoolectorNode *array, uint32_t i, BoolectorNode *value)
+  {
+    BoolectorNode *idx, *res;
+
+    idx = boolector_unsigned_int (d_btor, i, d_sort);
+    res = boolector_write (d_btor, array, idx, value);
+    boolector_release (d_btor, idx);
+    boolector_release (d_btor, value);
+    boolector_release (d_btor, array);
+    return res;
+  }
+
+  /* Return read (array, i). */
+  BoolectorNode *read (BoolectorNode *array, uint32_t i)
+  {
+    BoolectorNode *idx, *res;
+
+    idx = boolector_unsigned_int (d_btor, i, d_sort);
+    res = boolector_read (d_btor, array, idx);
+    boolector_release (d_btor, idx);
+    return res;
+  }
+
+  /* Assert x < hi and x & 1 = parity. */
+  void assert_x_below (uint32_t hi, uint32_t parity)
+  {
+    BoolectorNode *c, *lt, *one, *and_, *eq;
+
+    c  = boolector_unsigned_int (d_btor, hi, d_sort);
+    lt = boolector_ult (d_btor, d_x, c);
+    boolector_assert (d_btor, lt);
+    boolector_release (d_btor, lt);
+    boolector_release (d_btor, c);
+    one  = boolector_one (d_btor, d_sort);
+    and_ = boolector_and (d_btor, d_x, one);
+    c    = boolector_unsigned_int (d_btor, parity, d_sort);
+    eq   = boolector_eq (d_btor, and_, c);
+    boolector_assert (d_btor, eq);
+    boolector_release (d_btor, eq);
+    boolector_release (d_btor, c);
+    boolector_release (d_btor, and_);
+    boolector_release (d_btor, one);
+  }
+
+  /* Return a * x + b. */
+  BoolectorNode *affine_x (uint32_t a, uint32_t b)
+  {
+    BoolectorNode *ca, *cb, *mul, *res;
+
+    ca  = boolector_unsigned_int (d_btor, a, d_sort);
+    cb  = boolector_unsigned_int (d_btor, b, d_sort);
+    mul = boolector_mul (d_btor, ca, d_x);
+    res = boolector_add (d_btor, mul, cb);
+    boolector_release (d_btor, mul);
+    boolector_release (d_btor, cb);
+    boolector_release (d_btor, ca);
+    return res;
+  }
+
+  /* Assert array[x] != value. */
+  void assert_read_x_ne (BoolectorNode *array, BoolectorNode *value)
+  {
+    BoolectorNode *rd, *ne;
+
+    rd = boolector_read (d_btor, array, d_x);
+    ne = boolector_ne (d_btor, rd, value);
+    boolector_assert (d_btor, ne);
+    boolector_release (d_btor, ne);
+    boolector_release (d_btor, rd);
+  }
+
+  BoolectorSort d_sort;
+  BoolectorSort d_asort;
+  BoolectorNode *d_x;
+};
+
+TEST_F (TestExtract, affine_strided)
+{
+  uint32_t i;
+  BoolectorNode *a, *v;
+
+  /* a[2k] = 3 * 2k + 1 for k = 0..7 */
+  a = boolector_array (d_btor, d_asort, "a");
+  for (i = 0; i < 16; i += 2)
+    a = write (a, i, boolector_unsigned_int (d_btor, 3 * i + 1, d_sort));
+  assert_x_below (16, 0);
+  v = affine_x (3, 1);
+  assert_read_x_ne (a, v);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+  ASSERT_EQ (d_btor->stats.extracted_lambdas, 1u);
+  ASSERT_EQ (d_btor->stats.extracted_writes, 8u);
+  boolector_release (d_btor, v);
+  boolector_release (d_btor, a);
+}
+
+TEST_F (TestExtract, affine_sat)
+{
+  uint32_t i;
+  BoolectorNode *a, *v;
+
+  boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+  a = boolector_array (d_btor, d_asort, "a");
+  for (i = 0; i < 16; i += 2)
+    a = write (a, i, boolector_unsigned_int (d_btor, 3 * i + 1, d_sort));
+  /* odd indices are not written */
+  assert_x_below (16, 1);
+  v = affine_x (3, 1);
+  assert_read_x_ne (a, v);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_EQ (d_btor->stats.extracted_writes, 8u);
+  boolector_release (d_btor, v);
+  boolector_release (d_btor, a);
+}
+
+TEST_F (TestExtract, interleaved_copy)
+{
+  uint32_t i;
+  BoolectorNode *a, *b, *c, *two, *four, *half, *idx, *rd;
+
+  /* c[2k] = a[k], c[2k + 1] = b[k + 4] for k = 0..3 */
+  a = boolector_array (d_btor, d_asort, "a");
+  b = boolector_array (d_btor, d_asort, "b");
+  c = boolector_array (d_btor, d_asort, "c");
+  for (i = 0; i < 4; i++)
+  {
+    c = write (c, 2 * i, read (a, i));
+    c = write (c, 2 * i + 1, read (b, i + 4));
+  }
+  /* c[x] = b[x / 2 + 4] for odd x < 8 */
+  assert_x_below (8, 1);
+  two  = boolector_unsigned_int (d_btor, 2, d_sort);
+  four = boolector_unsigned_int (d_btor, 4, d_sort);
+  half = boolector_udiv (d_btor, d_x, two);
+  idx  = boolector_add (d_btor, half, four);
+  rd   = boolector_read (d_btor, b, idx);
+  assert_read_x_ne (c, rd);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+  ASSERT_EQ (d_btor->stats.extracted_lambdas, 2u);
+  ASSERT_EQ (d_btor->stats.extracted_writes, 8u);
+  boolector_release (d_btor, rd);
+  boolector_release (d_btor, idx);
+  boolector_release (d_btor, half);
+  boolector_release (d_btor, four);
+  boolector_release (d_btor, two);
+  boolector_release (d_btor, a);
+  boolector_release (d_btor, b);
+  boolector_release (d_btor, c);
+}
@@ -12,7 +12,9 @@
 #include "test.h"
 
 extern "C" {
+#include "btorcore.h"
 #include "btoropt.h"
+#include "btorslvfun.h"
 }
 
 class TestInc : public TestBoolector
@@ -258,3 +260,248 @@ TEST_F (TestInc, lemmas_on_demand1)
   boolector_release_sort (d_btor, s);
   boolector_release_sort (d_btor, as);
 }
+
+TEST_F (TestInc, sat_facts1)
+{
+  int32_t sat_result;
+  const char *bits;
+  BoolectorNode *x, *y, *c, *ult, *and_, *eq;
+  BoolectorSort s;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_SAT_FACTS, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+  s    = boolector_bitvec_sort (d_btor, 8);
+  x    = boolector_var (d_btor, s, "x");
+  y    = boolector_var (d_btor, s, "y");
+  c    = boolector_unsigned_int (d_btor, 0xf0, s);
+  and_ = boolector_and (d_btor, x, y);
+  eq   = boolector_eq (d_btor, and_, c);
+  ult  = boolector_ult (d_btor, x, c);
+  boolector_assert (d_btor, eq);
+  /* facts must not be derived from assumptions */
+  boolector_assume (d_btor, ult);
+  sat_result = boolector_sat (d_btor);
+  ASSERT_EQ (sat_result, BOOLECTOR_UNSAT);
+  ASSERT_TRUE (boolector_failed (d_btor, ult));
+  sat_result = boolector_sat (d_btor);
+  ASSERT_EQ (sat_result, BOOLECTOR_SAT);
+  sat_result = boolector_sat (d_btor);
+  ASSERT_EQ (sat_result, BOOLECTOR_SAT);
+  bits = boolector_bv_assignment (d_btor, and_);
+  ASSERT_STREQ (bits, "11110000");
+  boolector_free_bv_assignment (d_btor, bits);
+  boolector_assume (d_btor, ult);
+  sat_result = boolector_sat (d_btor);
+  ASSERT_EQ (sat_result, BOOLECTOR_UNSAT);
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, c);
+  boolector_release (d_btor, and_);
+  boolector_release (d_btor, eq);
+  boolector_release (d_btor, ult);
+  boolector_release_sort (d_btor, s);
+}
+
+TEST_F (TestInc, var_subst_cone)
+{
+  int32_t sat_result;
+  uint32_t i;
+  uint_least64_t visited;
+  BoolectorNode *x[32], *y, *z, *one, *c, *add, *ult, *eq;
+  BoolectorSort s;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  s   = boolector_bitvec_sort (d_btor, 8);
+  one = boolector_one (d_btor, s);
+  for (i = 0; i < 32; i++) x[i] = boolector_var (d_btor, s, 0);
+  for (i = 0; i < 31; i++)
+  {
+    ult = boolector_ult (d_btor, x[i], x[i + 1]);
+    boolector_assert (d_btor, ult);
+    boolector_release (d_btor, ult);
+  }
+  y   = boolector_var (d_btor, s, "y");
+  z   = boolector_var (d_btor, s, "z");
+  c   = boolector_unsigned_int (d_btor, 10, s);
+  ult = boolector_ult (d_btor, y, c);
+  boolector_assume (d_btor, ult);
+  sat_result = boolector_sat (d_btor);
+  ASSERT_EQ (sat_result, BOOLECTOR_SAT);
+
+  /* substituting y only rebuilds the cone of y */
+  visited = d_btor->stats.subst_visited;
+  add     = boolector_add (d_btor, z, one);
+  eq      = boolector_eq (d_btor, y, add);
+  boolector_assert (d_btor, eq);
+  boolector_assume (d_btor, ult);
+  sat_result = boolector_sat (d_btor);
+  ASSERT_EQ (sat_result, BOOLECTOR_SAT);
+  ASSERT_GT (d_btor->stats.subst_rebuilt, 0u);
+  ASSERT_LT (d_btor->stats.subst_visited - visited, 10u);
+
+  for (i = 0; i < 32; i++) boolector_release (d_btor, x[i]);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, z);
+  boolector_release (d_btor, one);
+  boolector_release (d_btor, c);
+  boolector_release (d_btor, add);
+  boolector_release (d_btor, ult);
+  boolector_release (d_btor, eq);
+  boolector_release_sort (d_btor, s);
+}
+
+TEST_F (TestInc, dual_prop)
+{
+  int32_t sat_result;
+  uint32_t i;
+  BoolectorNode *f, *x[3], *fx[3], *c, *eq;
+  BoolectorSort s, fs;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_FUN_DUAL_PROP, 1);
+  s  = boolector_bitvec_sort (d_btor, 8);
+  fs = boolector_fun_sort (d_btor, &s, 1, s);
+  f  = boolector_uf (d_btor, fs, "f");
+  for (i = 0; i < 3; i++)
+  {
+    x[i]  = boolector_var (d_btor, s, 0);
+    fx[i] = boolector_apply (d_btor, &x[i], 1, f);
+  }
+
+  /* the clone of the first call is extended by the constraints asserted
+   * in subsequent calls */
+  for (i = 0; i < 3; i++)
+  {
+    c  = boolector_unsigned_int (d_btor, i, s);
+    eq = boolector_eq (d_btor, fx[i], c);
+    boolector_assert (d_btor, eq);
+    boolector_release (d_btor, eq);
+    boolector_release (d_btor, c);
+    if (i > 0)
+    {
+      eq = boolector_eq (d_btor, x[i], x[i - 1]);
+      boolector_assume (d_btor, eq);
+      sat_result = boolector_sat (d_btor);
+      ASSERT_EQ (sat_result, BOOLECTOR_UNSAT);
+      ASSERT_TRUE (boolector_failed (d_btor, eq));
+      boolector_release (d_btor, eq);
+    }
+    sat_result = boolector_sat (d_btor);
+    ASSERT_EQ (sat_result, BOOLECTOR_SAT);
+  }
+  ASSERT_EQ (BTOR_FUN_SOLVER (d_btor)->stats.dp_clone_reuses, 4u);
+
+  for (i = 0; i < 3; i++)
+  {
+    boolector_release (d_btor, x[i]);
+    boolector_release (d_btor, fx[i]);
+  }
+  boolector_release (d_btor, f);
+  boolector_release_sort (d_btor, s);
+  boolector_release_sort (d_btor, fs);
+}
+
+TEST_F (TestInc, inc_check)
+{
+  int32_t sat_result;
+  uint32_t i, j;
+  const char *bits[4];
+  BoolectorNode *f, *x[4], *fx[4], *c, *eq;
+  BoolectorSort s, fs;
+
+  boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+  s  = boolector_bitvec_sort (d_btor, 8);
+  fs = boolector_fun_sort (d_btor, &s, 1, s);
+  f  = boolector_uf (d_btor, fs, "f");
+  for (i = 0; i < 4; i++)
+  {
+    x[i]  = boolector_var (d_btor, s, 0);
+    fx[i] = boolector_apply (d_btor, &x[i], 1, f);
+    c     = boolector_unsigned_int (d_btor, i, s);
+    eq    = boolector_eq (d_btor, fx[i], c);
+    boolector_assert (d_btor, eq);
+    boolector_release (d_btor, eq);
+    boolector_release (d_btor, c);
+  }
+  /* all x[i] get the same initial assignment, each refinement separates
+   * some of them and keeps the assignments of the others */
+  sat_result = boolector_sat (d_btor);
+  ASSERT_EQ (sat_result, BOOLECTOR_SAT);
+  ASSERT_GT (BTOR_FUN_SOLVER (d_btor)->stats.refinement_iterations, 0u);
+  ASSERT_GT (BTOR_FUN_SOLVER (d_btor)->stats.inc_check_kept, 0u);
+  for (i = 0; i < 4; i++) bits[i] = boolector_bv_assignment (d_btor, x[i]);
+  for (i = 0; i < 4; i++)
+    for (j = i + 1; j < 4; j++) ASSERT_STRNE (bits[i], bits[j]);
+  for (i = 0; i < 4; i++) boolector_free_bv_assignment (d_btor, bits[i]);
+
+  for (i = 0; i < 4; i++)
+  {
+    boolector_release (d_btor, x[i]);
+    boolector_release (d_btor, fx[i]);
+  }
+  boolector_release (d_btor, f);
+  boolector_release_sort (d_btor, s);
+  boolector_release_sort (d_btor, fs);
+}
+
+TEST_F (TestInc, beta_cache)
+{
+  int32_t sat_result;
+  uint32_t i;
+  BoolectorNode *a, *b, *f, *x, *y, *fx, *fy, *zero, *c, *eq, *ne, *rb, *ra;
+  BoolectorSort s, as, fs;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_BETA_REDUCE, BTOR_BETA_REDUCE_NONE);
+  boolector_set_opt (d_btor, BTOR_OPT_FUN_STORE_LAMBDAS, 1);
+  s    = boolector_bitvec_sort (d_btor, 8);
+  as   = boolector_array_sort (d_btor, s, s);
+  fs   = boolector_fun_sort (d_btor, &s, 1, s);
+  a    = boolector_array (d_btor, as, "a");
+  f    = boolector_uf (d_btor, fs, "f");
+  x    = boolector_var (d_btor, s, "x");
+  y    = boolector_var (d_btor, s, "y");
+  zero = boolector_zero (d_btor, s);
+  b    = boolector_write (d_btor, a, x, zero);
+  rb   = boolector_read (d_btor, b, y);
+  ra   = boolector_read (d_btor, a, y);
+  fx   = boolector_apply (d_btor, &x, 1, f);
+  fy   = boolector_apply (d_btor, &y, 1, f);
+  /* f keeps b from being eliminated by eager beta reduction */
+  ne   = boolector_ne (d_btor, fx, fy);
+  boolector_assert (d_btor, ne);
+
+  /* the reduction of b[y] is reused as long as x != y holds */
+  for (i = 1; i <= 4; i++)
+  {
+    c  = boolector_unsigned_int (d_btor, i, s);
+    eq = boolector_eq (d_btor, rb, c);
+    boolector_assume (d_btor, eq);
+    sat_result = boolector_sat (d_btor);
+    ASSERT_EQ (sat_result, BOOLECTOR_SAT);
+    boolector_release (d_btor, eq);
+    boolector_release (d_btor, c);
+  }
+  eq = boolector_ne (d_btor, rb, ra);
+  boolector_assume (d_btor, eq);
+  sat_result = boolector_sat (d_btor);
+  ASSERT_EQ (sat_result, BOOLECTOR_UNSAT);
+  ASSERT_GT (BTOR_FUN_SOLVER (d_btor)->stats.beta_cache_hits, 0u);
+
+  boolector_release (d_btor, a);
+  boolector_release (d_btor, b);
+  boolector_release (d_btor, f);
+  boolector_release (d_btor, fx);
+  boolector_release (d_btor, fy);
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, zero);
+  boolector_release (d_btor, rb);
+  boolector_release (d_btor, ra);
+  boolector_release (d_btor, ne);
+  boolector_release (d_btor, eq);
+  boolector_release_sort (d_btor, s);
+  boolector_release_sort (d_btor, as);
+  boolector_release_sort (d_btor, fs);
+}
@@ -0,0 +1,112 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+class TestLinear : public TestBoolector
+{
+ protected:
+  static constexpr uint32_t TEST_LINEAR_BW = 8;
+
+  void SetUp () override
+  {
+    TestBoolector::SetUp ();
+    boolector_set_opt (d_btor, BTOR_OPT_SOLVE_LINEAR, 1);
+    boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+    d_sort = boolector_bitvec_sort (d_btor, TEST_LINEAR_BW);
+    d_x    = boolector_var (d_btor, d_sort, "x");
+    d_y    = boolector_var (d_btor, d_sort, "y");
+  }
+
+  void TearDown () override
+  {
+    boolector_release (d_btor, d_x);
+    boolector_release (d_btor, d_y);
+    boolector_release_sort (d_btor, d_sort);
+    TestBoolector::TearDown ();
+  }
+
+  /* Assert a * x + b * y = c. */
+  void assert_lin_eq (uint32_t a, uint32_t b, uint32_t c)
+  {
+    BoolectorNode *ca, *cb, *cc, *ax, *by, *sum, *eq;
+
+    ca  = boolector_unsigned_int (d_btor, a, d_sort);
+    cb  = boolector_unsigned_int (d_btor, b, d_sort);
+    cc  = boolector_unsigned_int (d_btor, c, d_sort);
+    ax  = boolector_mul (d_btor, ca, d_x);
+    by  = boolector_mul (d_btor, cb, d_y);
+    sum = boolector_add (d_btor, ax, by);
+    eq  = boolector_eq (d_btor, sum, cc);
+    boolector_assert (d_btor, eq);
+    boolector_release (d_btor, eq);
+    boolector_release (d_btor, sum);
+    boolector_release (d_btor, by);
+    boolector_release (d_btor, ax);
+    boolector_release (d_btor, cc);
+    boolector_release (d_btor, cb);
+    boolector_release (d_btor, ca);
+  }
+
+  uint32_t get_value (BoolectorNode *n)
+  {
+    const char *bits;
+    uint32_t res;
+
+    bits = boolector_bv_assignment (d_btor, n);
+    res  = (uint32_t) strtoul (bits, 0, 2);
+    boolector_free_bv_assignment (d_btor, bits);
+    return res;
+  }
+
+  BoolectorSort d_sort;
+  BoolectorNode *d_x;
+  BoolectorNode *d_y;
+};
+
+TEST_F (TestLinear, even_coefficients)
+{
+  uint32_t x, y;
+
+  /* 2x + 2y = 4 and 2x + 4y = 6 have no odd coefficient, jointly they imply
+   * 2y = 2 */
+  assert_lin_eq (2, 2, 4);
+  assert_lin_eq (2, 4, 6);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_GT (d_btor->stats.linear_system_elims, 0u);
+  x = get_value (d_x);
+  y = get_value (d_y);
+  ASSERT_EQ ((2 * x + 2 * y) % 256, 4u);
+  ASSERT_EQ ((2 * x + 4 * y) % 256, 6u);
+}
+
+TEST_F (TestLinear, odd_and_even_coefficients)
+{
+  uint32_t x, y;
+
+  assert_lin_eq (3, 4, 10);
+  assert_lin_eq (6, 12, 20);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  x = get_value (d_x);
+  y = get_value (d_y);
+  ASSERT_EQ ((3 * x + 4 * y) % 256, 10u);
+  ASSERT_EQ ((6 * x + 12 * y) % 256, 20u);
+}
+
+TEST_F (TestLinear, parity)
+{
+  /* 2x + 4y is even */
+  assert_lin_eq (2, 4, 3);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+}
+
+TEST_F (TestLinear, inconsistent_system)
+{
+  /* subtracting both equations yields 2y = 1 */
+  assert_lin_eq (2, 6, 4);
+  assert_lin_eq (2, 4, 3);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+}
@@ -0,0 +1,124 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+extern "C" {
+#include "btorcore.h"
+}
+
+class TestUcopt : public TestBoolector
+{
+ protected:
+  void SetUp () override
+  {
+    TestBoolector::SetUp ();
+    boolector_set_opt (d_btor, BTOR_OPT_UCOPT, 1);
+    boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+    d_sort = boolector_bitvec_sort (d_btor, 8);
+    d_x    = boolector_var (d_btor, d_sort, "x");
+    d_y    = boolector_var (d_btor, d_sort, "y");
+    d_z    = boolector_var (d_btor, d_sort, "z");
+  }
+
+  void TearDown () override
+  {
+    boolector_release (d_btor, d_x);
+    boolector_release (d_btor, d_y);
+    boolector_release (d_btor, d_z);
+    boolector_release_sort (d_btor, d_sort);
+    TestBoolector::TearDown ();
+  }
+
+  /* Assert x + y * z > 200, where x, y and z are unconstrained. */
+  void assert_ugt_add_mul ()
+  {
+    BoolectorNode *mul, *add, *c, *ugt;
+
+    mul = boolector_mul (d_btor, d_y, d_z);
+    add = boolector_add (d_btor, d_x, mul);
+    c   = boolector_unsigned_int (d_btor, 200, d_sort);
+    ugt = boolector_ugt (d_btor, add, c);
+    boolector_assert (d_btor, ugt);
+    boolector_release (d_btor, ugt);
+    boolector_release (d_btor, c);
+    boolector_release (d_btor, add);
+    boolector_release (d_btor, mul);
+  }
+
+  /* Assert n = c. */
+  void assert_eq_const (BoolectorNode *n, uint32_t c)
+  {
+    BoolectorNode *cn, *eq;
+
+    cn = boolector_unsigned_int (d_btor, c, d_sort);
+    eq = boolector_eq (d_btor, n, cn);
+    boolector_assert (d_btor, eq);
+    boolector_release (d_btor, eq);
+    boolector_release (d_btor, cn);
+  }
+
+  uint32_t get_value (BoolectorNode *n)
+  {
+    const char *bits;
+    uint32_t res;
+
+    bits = boolector_bv_assignment (d_btor, n);
+    res  = (uint32_t) strtoul (bits, 0, 2);
+    boolector_free_bv_assignment (d_btor, bits);
+    return res;
+  }
+
+  uint32_t get_add_mul ()
+  {
+    return (get_value (d_x) + get_value (d_y) * get_value (d_z)) % 256;
+  }
+
+  BoolectorSort d_sort;
+  BoolectorNode *d_x;
+  BoolectorNode *d_y;
+  BoolectorNode *d_z;
+};
+
+TEST_F (TestUcopt, model_gen)
+{
+  assert_ugt_add_mul ();
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_EQ (d_btor->stats.bv_uc_props, 2u);
+  ASSERT_GT (get_add_mul (), 200u);
+}
+
+TEST_F (TestUcopt, restore)
+{
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  assert_ugt_add_mul ();
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_GT (get_add_mul (), 200u);
+  /* y is not unconstrained anymore, which constrains y * z and thus
+   * x + y * z */
+  assert_eq_const (d_y, 3);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_EQ (d_btor->stats.restored_uc_props, 2u);
+  ASSERT_EQ (get_value (d_y), 3u);
+  ASSERT_GT (get_add_mul (), 200u);
+  assert_eq_const (d_x, 0);
+  assert_eq_const (d_z, 20);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+}
+
+TEST_F (TestUcopt, push_pop)
+{
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  assert_ugt_add_mul ();
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  boolector_push (d_btor, 1);
+  assert_eq_const (d_x, 0);
+  assert_eq_const (d_y, 0);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+  boolector_pop (d_btor, 1);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_GT (get_add_mul (), 200u);
+}